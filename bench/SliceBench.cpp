@@ -0,0 +1,89 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sharksfin/Slice.h"
+
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+namespace sharksfin {
+
+// keys which share the first (length - 1) bytes, so that the comparison must scan almost all bytes
+static std::pair<std::string, std::string> common_prefix_keys(std::size_t length) {
+    std::string a(length, 'k');
+    std::string b(length, 'k');
+    if (length > 0) {
+        b.back() = 'l';
+    }
+    return { std::move(a), std::move(b) };
+}
+
+static void Slice_compare(benchmark::State& state) {
+    auto [a, b] = common_prefix_keys(static_cast<std::size_t>(state.range(0)));
+    Slice sa { a };
+    Slice sb { b };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sa);
+        benchmark::DoNotOptimize(sb);
+        benchmark::DoNotOptimize(sa.compare(sb));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(Slice_compare)->RangeMultiplier(4)->Range(1, 1024);
+
+static void Slice_less(benchmark::State& state) {
+    auto [a, b] = common_prefix_keys(static_cast<std::size_t>(state.range(0)));
+    Slice sa { a };
+    Slice sb { b };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sa);
+        benchmark::DoNotOptimize(sb);
+        benchmark::DoNotOptimize(sa < sb);
+    }
+}
+BENCHMARK(Slice_less)->RangeMultiplier(4)->Range(1, 1024);
+
+static void Slice_starts_with(benchmark::State& state) {
+    auto length = static_cast<std::size_t>(state.range(0));
+    std::string key(length * 2, 'k');
+    std::string prefix(length, 'k');
+    Slice sk { key };
+    Slice sp { prefix };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sk);
+        benchmark::DoNotOptimize(sp);
+        benchmark::DoNotOptimize(sk.starts_with(sp));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(Slice_starts_with)->RangeMultiplier(4)->Range(1, 1024);
+
+static void Slice_starts_with_mismatch(benchmark::State& state) {
+    auto length = static_cast<std::size_t>(state.range(0));
+    std::string key(length * 2, 'k');
+    std::string prefix(length, 'j');
+    Slice sk { key };
+    Slice sp { prefix };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sk);
+        benchmark::DoNotOptimize(sp);
+        benchmark::DoNotOptimize(sk.starts_with(sp));
+    }
+}
+BENCHMARK(Slice_starts_with_mismatch)->RangeMultiplier(4)->Range(1, 1024);
+
+}  // namespace sharksfin
@@ -0,0 +1,76 @@
+# Copyright 2018-2026 Project Tsurugi.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+function(register_benchmarks)
+    include(CMakeParseArguments)
+    cmake_parse_arguments(
+        BENCHMARKS # prefix
+        ""
+        "TARGET"
+        "SOURCES;DEPENDS"
+        ${ARGN}
+    )
+    if(NOT BENCHMARKS_TARGET)
+        message(FATAL_ERROR "TARGET must be set")
+    endif()
+    if(NOT BENCHMARKS_SOURCES)
+        message(FATAL_ERROR "SOURCES must be set")
+    endif()
+    if(NOT TARGET run-benchmarks)
+        add_custom_target(run-benchmarks)
+    endif()
+
+    # collect non "*Bench" source files: it must be linked from "*Bench" files.
+    set(BENCHMARKS_COMMON_SOURCES)
+    foreach(src IN LISTS BENCHMARKS_SOURCES)
+        get_filename_component(fname "${src}" NAME_WE)
+        if(NOT fname MATCHES "Bench$")
+            list(APPEND BENCHMARKS_COMMON_SOURCES ${src})
+        endif()
+    endforeach()
+
+    # register benchmarks for each "*Bench" file as <target-name>-<file-name>
+    foreach(src IN LISTS BENCHMARKS_SOURCES)
+        get_filename_component(fname "${src}" NAME_WE)
+        if(fname MATCHES "Bench$")
+            set(bench_name "${BENCHMARKS_TARGET}-${fname}")
+
+            add_executable(${bench_name} ${src} ${BENCHMARKS_COMMON_SOURCES})
+
+            target_include_directories(${bench_name} PRIVATE ${CMAKE_CURRENT_SOURCE_DIR})
+
+            if(TARGET ${BENCHMARKS_TARGET})
+                target_link_libraries(${bench_name} PRIVATE ${BENCHMARKS_TARGET})
+            endif()
+            foreach(dep IN LISTS BENCHMARKS_DEPENDS)
+                target_link_libraries(${bench_name} PRIVATE ${dep})
+            endforeach()
+            target_link_libraries(${bench_name} PRIVATE benchmark::benchmark_main)
+            target_link_libraries(${bench_name} PRIVATE Threads::Threads)
+
+            set_compile_options(${bench_name})
+
+            # "run-benchmarks" writes the results of each benchmark as <target-name>-<file-name>_benchmark_result.json
+            add_custom_target(run-${bench_name}
+                COMMAND ${bench_name}
+                    --benchmark_out=${CMAKE_CURRENT_BINARY_DIR}/${bench_name}_benchmark_result.json
+                    --benchmark_out_format=json
+                DEPENDS ${bench_name}
+                USES_TERMINAL
+            )
+            add_dependencies(run-benchmarks run-${bench_name})
+        endif()
+    endforeach()
+
+endfunction(register_benchmarks)
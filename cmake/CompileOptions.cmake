@@ -40,6 +40,9 @@ endif()
 if(ENABLE_COVERAGE)
     set(CMAKE_CXX_FLAGS_DEBUG "${CMAKE_CXX_FLAGS_DEBUG} --coverage")
 endif()
+if(ENABLE_API_TRACE)
+    add_compile_definitions(SHARKSFIN_API_TRACE)
+endif()
 
 function(set_compile_options target_name)
     if (BUILD_STRICT)
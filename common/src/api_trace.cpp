@@ -0,0 +1,61 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "api_trace.h"
+
+#include <vector>
+
+namespace sharksfin::common {
+
+/**
+ * @brief the number of API trace events kept for each thread.
+ */
+static constexpr std::size_t api_trace_capacity = 16384;
+
+trace_channel& api_trace_channel() {
+    static trace_channel channel{"api", api_trace_capacity};
+    return channel;
+}
+
+static std::string_view mark(std::uint32_t kind) noexcept {
+    switch (static_cast<api_trace_kind>(kind)) {
+        case api_trace_kind::entry: return "-->";
+        case api_trace_kind::exit: return "<--";
+        case api_trace_kind::status: return "---";
+    }
+    return "???";
+}
+
+void print_api_trace(std::ostream& os) {
+    std::vector<trace_event> events{};
+    api_trace_channel().collect(events);
+    if (events.empty()) {
+        return;
+    }
+    auto ratio = trace_clock::nanos_per_tick();
+    auto origin = events.front().timestamp_;
+    os << "api trace (" << events.size() << " events):" << std::endl;
+    for (auto&& e : events) {
+        os << static_cast<std::uint64_t>(static_cast<double>(e.timestamp_ - origin) * ratio) << "ns"
+           << " thread:" << std::hex << e.thread_ << std::dec
+           << " " << mark(e.kind_) << " " << e.label_;
+        for (std::size_t i = 0; i < e.arg_count_; ++i) {
+            os << " " << e.args_[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        os << std::endl;
+    }
+}
+
+}  // namespace sharksfin::common
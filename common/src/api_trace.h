@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+#include "trace_channel.h"
+
+namespace sharksfin::common {
+
+/**
+ * @brief the kind of API trace events.
+ */
+enum class api_trace_kind : std::uint32_t {
+
+    /**
+     * @brief entering a function.
+     */
+    entry = 1,
+
+    /**
+     * @brief exiting a function.
+     */
+    exit = 2,
+
+    /**
+     * @brief a function returned non-OK status.
+     */
+    status = 3,
+};
+
+/**
+ * @brief returns the channel which keeps API trace events.
+ * @return the API trace channel
+ */
+trace_channel& api_trace_channel();
+
+/**
+ * @brief prints the recorded API trace events.
+ * @param os the target stream
+ */
+void print_api_trace(std::ostream& os);
+
+/**
+ * @brief builds an API trace event from the stream-like arguments, and records it on destruction.
+ * @details this accepts the same expressions as the logging macros, but only keeps integral, enum, and pointer
+ * values as the event arguments. String labels and other objects are ignored without formatting.
+ */
+class api_trace_writer {
+public:
+    /**
+     * @brief creates a new instance.
+     * @param kind the event kind
+     * @param function the function name, which must have static storage duration
+     */
+    api_trace_writer(api_trace_kind kind, char const* function) noexcept {
+        event_.timestamp_ = trace_clock::now();
+        event_.label_ = function;
+        event_.kind_ = static_cast<std::uint32_t>(kind);
+    }
+
+    api_trace_writer(api_trace_writer const& other) = delete;
+    api_trace_writer& operator=(api_trace_writer const& other) = delete;
+    api_trace_writer(api_trace_writer&& other) noexcept = delete;
+    api_trace_writer& operator=(api_trace_writer&& other) noexcept = delete;
+
+    /**
+     * @brief records the built event.
+     */
+    ~api_trace_writer() {
+        api_trace_channel().write(event_);
+    }
+
+    /**
+     * @brief appends the value as an argument if it is a scalar value.
+     * @tparam T the value type
+     * @param value the value
+     * @return this
+     */
+    template<class T>
+    api_trace_writer& operator<<(T const& value) noexcept {
+        using type = std::decay_t<T>;
+        if constexpr (std::is_same_v<type, char const*> || std::is_same_v<type, char*>) {
+            // labels
+        } else if constexpr (std::is_enum_v<type>) {
+            event_.add(static_cast<std::uint64_t>(value));
+        } else if constexpr (std::is_integral_v<type>) {
+            event_.add(static_cast<std::uint64_t>(value));
+        } else if constexpr (std::is_pointer_v<type> && ! std::is_function_v<std::remove_pointer_t<type>>) {
+            event_.add(reinterpret_cast<std::uintptr_t>(value));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+        return *this;
+    }
+
+private:
+    trace_event event_{};
+};
+
+}  // namespace sharksfin::common
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "sharksfin/IteratorBatch.h"
+#include "sharksfin/IteratorColumns.h"
+#include "sharksfin/Slice.h"
+
+namespace sharksfin::common {
+
+/**
+ * @brief appends rows into the caller provided IteratorBatch.
+ */
+class row_batch_writer {
+public:
+    /**
+     * @brief creates a new instance and clears the output.
+     * @param out the output batch
+     * @param max_bytes the capacity of the data buffer
+     */
+    row_batch_writer(IteratorBatch& out, std::size_t max_bytes) noexcept :
+        out_(out),
+        max_bytes_(max_bytes)
+    {
+        out_.row_count = 0;
+        out_.data_size = 0;
+    }
+
+    /**
+     * @brief appends a row.
+     * @param key the row key
+     * @param value the row value
+     * @return true if the row was appended
+     * @return false if the row does not fit into the rest of the buffer
+     */
+    bool append(Slice key, Slice value) noexcept {
+        if (key.size() + value.size() > max_bytes_ - out_.data_size) {
+            return false;
+        }
+        auto& entry = out_.entries[out_.row_count];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        entry.key_offset = out_.data_size;
+        entry.key_length = key.size();
+        copy(key);
+        entry.value_offset = out_.data_size;
+        entry.value_length = value.size();
+        copy(value);
+        ++out_.row_count;
+        return true;
+    }
+
+    /**
+     * @brief returns the number of appended rows.
+     * @return the number of rows
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return out_.row_count;
+    }
+
+private:
+    IteratorBatch& out_;
+    std::size_t max_bytes_;
+
+    void copy(Slice s) noexcept {
+        if (! s.empty()) {
+            std::memcpy(out_.data + out_.data_size, s.data(), s.size());  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        out_.data_size += s.size();
+    }
+};
+
+/**
+ * @brief appends rows into the caller provided IteratorColumns.
+ */
+class column_batch_writer {
+public:
+    /**
+     * @brief creates a new instance and clears the output.
+     * @param out the output columns
+     */
+    explicit column_batch_writer(IteratorColumns& out) noexcept :
+        out_(out)
+    {
+        out_.row_count = 0;
+        out_.key_offsets[0] = 0;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out_.value_offsets[0] = 0;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief appends a row.
+     * @param key the row key
+     * @param value the row value
+     * @return true if the row was appended
+     * @return false if the row does not fit into the rest of the buffers
+     */
+    bool append(Slice key, Slice value) noexcept {
+        auto n = out_.row_count;
+        auto key_end = static_cast<std::size_t>(out_.key_offsets[n]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto value_end = static_cast<std::size_t>(out_.value_offsets[n]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (key.size() > out_.key_data_capacity - key_end || value.size() > out_.value_data_capacity - value_end) {
+            return false;
+        }
+        if (! key.empty()) {
+            std::memcpy(out_.key_data + key_end, key.data(), key.size());  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        if (! value.empty()) {
+            std::memcpy(out_.value_data + value_end, value.data(), value.size());  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        out_.key_offsets[n + 1] = static_cast<std::int64_t>(key_end + key.size());  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out_.value_offsets[n + 1] = static_cast<std::int64_t>(value_end + value.size());  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        ++out_.row_count;
+        return true;
+    }
+
+    /**
+     * @brief returns the number of appended rows.
+     * @return the number of rows
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return out_.row_count;
+    }
+
+private:
+    IteratorColumns& out_;
+};
+
+}  // namespace sharksfin::common
@@ -0,0 +1,370 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "flight_recorder.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <semaphore.h>
+#include <unistd.h>
+
+#include "sharksfin/TransactionOptions.h"
+#include "binary_printer.h"
+
+namespace sharksfin::common {
+
+std::string_view to_string_view(flight_event_kind value) noexcept {
+    switch (value) {
+        case flight_event_kind::transaction_begin: return "begin";
+        case flight_event_kind::transaction_commit: return "commit";
+        case flight_event_kind::transaction_abort: return "abort";
+        case flight_event_kind::scan_open: return "scan_open";
+        case flight_event_kind::scan_close: return "scan_close";
+        case flight_event_kind::error: return "error";
+    }
+    return "unknown";
+}
+
+namespace {
+
+constexpr std::array<char, 8> dump_magic { 'S', 'F', 'F', 'L', 'I', 'G', 'H', 'T' };
+constexpr std::uint32_t dump_version = 1;
+
+// the binary dump consists of this header and the following events, in the host byte order
+struct dump_header {
+    std::array<char, 8> magic_{};
+    std::uint32_t version_{};
+    std::uint32_t event_size_{};
+    double nanos_per_tick_{};
+    std::uint64_t ticks_{};
+    std::int64_t epoch_nanos_{};
+    std::uint64_t count_{};
+};
+
+// the key length of the error events without keys
+constexpr std::uint32_t no_key = 0xffffffffU;
+
+std::uint64_t prefix_of(std::string_view bytes) noexcept {
+    std::uint64_t ret{};
+    std::memcpy(&ret, bytes.data(), std::min(bytes.size(), sizeof(ret)));
+    return ret;
+}
+
+std::uint64_t pack_error(ErrorCode code, std::int64_t native_status, std::uint32_t key_length) noexcept {
+    return static_cast<std::uint16_t>(code)
+        | static_cast<std::uint64_t>(static_cast<std::uint16_t>(native_status)) << 16U
+        | static_cast<std::uint64_t>(key_length) << 32U;
+}
+
+bool is_valid(ErrorCode code) noexcept {
+    auto v = static_cast<std::int64_t>(code);
+    return v <= 0 && v >= static_cast<std::int64_t>(ErrorCode::CC_READONLY_ERROR) && v % 10 == 0;
+}
+
+bool is_valid(TransactionOptions::TransactionType type) noexcept {
+    return type == TransactionOptions::TransactionType::SHORT
+        || type == TransactionOptions::TransactionType::LONG
+        || type == TransactionOptions::TransactionType::READ_ONLY;
+}
+
+template<class T>
+struct enum_printer {
+    std::uint64_t value_;
+
+    friend std::ostream& operator<<(std::ostream& out, enum_printer const& p) {
+        auto v = static_cast<T>(static_cast<std::int64_t>(p.value_));
+        if constexpr (std::is_same_v<T, StatusCode>) {
+            return out << v;
+        } else {
+            if (is_valid(v)) {
+                return out << v;
+            }
+            return out << static_cast<std::int64_t>(p.value_);
+        }
+    }
+};
+
+void print_prefix(std::ostream& os, std::uint64_t prefix, std::size_t size) {
+    std::array<char, sizeof(prefix)> bytes{};
+    std::memcpy(bytes.data(), &prefix, sizeof(prefix));
+    os << binary_printer(bytes.data(), std::min(size, bytes.size()));
+}
+
+void print_event(std::ostream& os, trace_event const& e, dump_header const& header) {
+    auto age = static_cast<std::int64_t>(static_cast<double>(header.ticks_ - e.timestamp_) * header.nanos_per_tick_);
+    auto at = header.epoch_nanos_ - age;
+    constexpr std::int64_t nanos_per_second = 1'000'000'000;
+    auto fill = os.fill();
+    os << at / nanos_per_second << "." << std::setw(9) << std::setfill('0') << at % nanos_per_second
+       << std::setfill(fill)
+       << " thread:" << std::hex << e.thread_ << std::dec
+       << " " << to_string_view(static_cast<flight_event_kind>(e.kind_));
+    auto const& a = e.args_;
+    auto pointer = [](std::uint64_t v) {
+        return reinterpret_cast<void const*>(static_cast<std::uintptr_t>(v));  // NOLINT(performance-no-int-to-ptr,cppcoreguidelines-pro-type-reinterpret-cast)
+    };
+    switch (static_cast<flight_event_kind>(e.kind_)) {
+        case flight_event_kind::transaction_begin:
+            os << " tx:" << pointer(a[0])
+               << " type:" << enum_printer<TransactionOptions::TransactionType>{a[1]}
+               << " status:" << enum_printer<StatusCode>{a[2]};
+            break;
+        case flight_event_kind::transaction_commit:
+            os << " tx:" << pointer(a[0])
+               << " status:" << enum_printer<StatusCode>{a[1]}
+               << " error:" << enum_printer<ErrorCode>{a[2]}
+               << " last_call_status:" << static_cast<std::int64_t>(a[3]);
+            break;
+        case flight_event_kind::transaction_abort:
+            os << " tx:" << pointer(a[0])
+               << " status:" << enum_printer<StatusCode>{a[1]}
+               << " last_call_status:" << static_cast<std::int64_t>(a[2]);
+            break;
+        case flight_event_kind::scan_open:
+            os << " tx:" << pointer(a[0]) << " iterator:" << pointer(a[1]);
+            break;
+        case flight_event_kind::scan_close:
+            os << " iterator:" << pointer(a[0]);
+            break;
+        case flight_event_kind::error: {
+            auto code = static_cast<std::int16_t>(a[1] & 0xffffU);
+            auto native_status = static_cast<std::int16_t>((a[1] >> 16U) & 0xffffU);
+            auto key_length = static_cast<std::uint32_t>(a[1] >> 32U);
+            os << " tx:" << pointer(a[0])
+               << " code:" << enum_printer<ErrorCode>{static_cast<std::uint64_t>(static_cast<std::int64_t>(code))}
+               << " last_call_status:" << native_status;
+            if (a[2] != 0) {
+                std::array<char, sizeof(std::uint64_t)> bytes{};
+                std::memcpy(bytes.data(), &a[2], bytes.size());
+                auto size = std::find(bytes.begin(), bytes.end(), '\0') - bytes.begin();
+                os << " storage:\"";
+                print_prefix(os, a[2], static_cast<std::size_t>(size));
+                os << (size == static_cast<std::ptrdiff_t>(bytes.size()) ? "...\"" : "\"");
+            }
+            if (key_length != no_key) {
+                os << " key(len=" << key_length << "):\"";
+                print_prefix(os, a[3], key_length);
+                os << (key_length > sizeof(std::uint64_t) ? "...\"" : "\"");
+            }
+            break;
+        }
+        default:
+            for (std::size_t i = 0; i < e.arg_count_; ++i) {
+                os << " " << a[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+            break;
+    }
+    os << std::endl;
+}
+
+dump_header current_header(std::size_t count) {
+    dump_header ret{};
+    ret.magic_ = dump_magic;
+    ret.version_ = dump_version;
+    ret.event_size_ = sizeof(trace_event);
+    ret.nanos_per_tick_ = trace_clock::nanos_per_tick();
+    ret.ticks_ = trace_clock::now();
+    ret.epoch_nanos_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    ret.count_ = count;
+    return ret;
+}
+
+// dumps the events on a dedicated thread, because signal handlers can only post the request
+class signal_dumper {
+public:
+    signal_dumper() {
+        ::sem_init(&requests_, 0, 0);
+        std::thread{[this] { run(); }}.detach();
+    }
+
+    signal_dumper(signal_dumper const& other) = delete;
+    signal_dumper& operator=(signal_dumper const& other) = delete;
+    signal_dumper(signal_dumper&& other) noexcept = delete;
+    signal_dumper& operator=(signal_dumper&& other) noexcept = delete;
+
+    // kept alive until the process exits, because the detached thread refers this
+    ~signal_dumper() = delete;
+
+    static signal_dumper& get() {
+        static auto* instance = new signal_dumper();  // NOLINT(cppcoreguidelines-owning-memory)
+        return *instance;
+    }
+
+    bool install(int signal, std::string prefix) {
+        {
+            std::unique_lock lk{mutex_};
+            prefix_ = std::move(prefix);
+        }
+        struct sigaction action{};
+        action.sa_handler = &signal_dumper::on_signal;  // NOLINT(cppcoreguidelines-pro-type-union-access)
+        ::sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        return ::sigaction(signal, &action, nullptr) == 0;
+    }
+
+private:
+    sem_t requests_{};
+    std::mutex mutex_{};
+    std::string prefix_{};
+    std::size_t sequence_{};
+
+    static void on_signal(int) {
+        auto saved = errno;
+        ::sem_post(&get().requests_);
+        errno = saved;
+    }
+
+    void run() {
+        while (true) {
+            if (::sem_wait(&requests_) != 0) {
+                continue;
+            }
+            std::string path{};
+            {
+                std::unique_lock lk{mutex_};
+                path = prefix_ + "-" + std::to_string(::getpid()) + "-" + std::to_string(sequence_++) + ".bin";
+            }
+            std::ofstream out{path, std::ios::binary | std::ios::trunc};
+            if (out) {
+                flight_recorder::dump(out);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+trace_channel& flight_recorder::channel() {
+    static trace_channel channel{"flight", capacity};
+    return channel;
+}
+
+StatusCode flight_recorder::configure(DatabaseOptions const& options) {
+    if (auto option = options.attribute(KEY_FLIGHT_RECORDER); option.has_value()) {
+        auto&& v = option.value();
+        if (v.empty() || v == "0" || v == "false") {
+            enabled(false);
+        } else if (v == "1" || v == "true") {
+            enabled(true);
+        } else {
+            return StatusCode::ERR_INVALID_ARGUMENT;
+        }
+    }
+    if (auto option = options.attribute(KEY_FLIGHT_RECORDER_SIGNAL); option.has_value()) {
+        int signal{};
+        try {
+            signal = std::stoi(option.value());
+        } catch (std::exception const&) {
+            return StatusCode::ERR_INVALID_ARGUMENT;
+        }
+        std::string prefix{};
+        if (auto path = options.attribute(KEY_FLIGHT_RECORDER_PATH); path.has_value()) {
+            prefix = path.value();
+        } else {
+            std::error_code ec{};
+            auto dir = std::filesystem::temp_directory_path(ec);
+            prefix = (ec ? std::filesystem::path{"."} : dir) / "sharksfin-flight";
+        }
+        if (! signal_dumper::get().install(signal, std::move(prefix))) {
+            return StatusCode::ERR_INVALID_ARGUMENT;
+        }
+    }
+    return StatusCode::OK;
+}
+
+void flight_recorder::record_error(
+    void const* transaction,
+    ErrorCode code,
+    std::int64_t native_status,
+    ErrorLocator const* locator) const noexcept {
+    if (! enabled()) {
+        return;
+    }
+    std::uint64_t storage{};
+    std::uint64_t key{};
+    std::uint32_t key_length = no_key;
+    if (locator != nullptr && locator->kind() == ErrorLocatorKind::storage_key) {
+        auto const& l = static_cast<StorageKeyErrorLocator const&>(*locator);  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+        if (auto s = l.storage(); s.has_value()) {
+            storage = prefix_of(*s);
+        }
+        if (auto k = l.key(); k.has_value()) {
+            key = prefix_of(*k);
+            key_length = static_cast<std::uint32_t>(std::min<std::size_t>(k->size(), no_key - 1));
+        }
+    }
+    record(flight_event_kind::error, transaction, pack_error(code, native_status, key_length), storage, key);
+}
+
+void flight_recorder::print(std::ostream& os) {
+    std::vector<trace_event> events{};
+    channel().collect(events);
+    if (events.empty()) {
+        return;
+    }
+    auto header = current_header(events.size());
+    os << "flight recorder (" << events.size() << " events):" << std::endl;
+    for (auto&& e : events) {
+        print_event(os, e, header);
+    }
+}
+
+void flight_recorder::dump(std::ostream& os) {
+    std::vector<trace_event> events{};
+    channel().collect(events);
+    auto header = current_header(events.size());
+    os.write(reinterpret_cast<char const*>(&header), sizeof(header));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    for (auto e : events) {
+        // labels are meaningless out of this process
+        e.label_ = nullptr;
+        os.write(reinterpret_cast<char const*>(&e), sizeof(e));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+    os.flush();
+}
+
+bool flight_recorder::decode(std::istream& in, std::ostream& os) {
+    dump_header header{};
+    if (! in.read(reinterpret_cast<char*>(&header), sizeof(header))  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        || header.magic_ != dump_magic
+        || header.version_ != dump_version
+        || header.event_size_ != sizeof(trace_event)) {
+        return false;
+    }
+    os << "flight recorder (" << header.count_ << " events):" << std::endl;
+    for (std::uint64_t i = 0; i < header.count_; ++i) {
+        trace_event e{};
+        if (! in.read(reinterpret_cast<char*>(&e), sizeof(e))) {  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return false;
+        }
+        e.arg_count_ = std::min<std::uint32_t>(e.arg_count_, trace_event::max_args);
+        print_event(os, e, header);
+    }
+    return true;
+}
+
+}  // namespace sharksfin::common
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+
+#include "sharksfin/DatabaseOptions.h"
+#include "sharksfin/ErrorCode.h"
+#include "sharksfin/ErrorLocator.h"
+#include "sharksfin/StatusCode.h"
+#include "trace_channel.h"
+
+namespace sharksfin::common {
+
+/**
+ * @brief the attribute key of whether or not the flight recorder is enabled (default: true).
+ */
+static constexpr std::string_view KEY_FLIGHT_RECORDER { "flight_recorder" };  // NOLINT
+
+/**
+ * @brief the attribute key of the signal number which requests dumping the flight recorder.
+ */
+static constexpr std::string_view KEY_FLIGHT_RECORDER_SIGNAL { "flight_recorder_signal" };  // NOLINT
+
+/**
+ * @brief the attribute key of the file path prefix where the flight recorder is dumped.
+ * @details the dump is written into "<prefix>-<pid>-<sequence>.bin" (default prefix: "<temp directory>/sharksfin-flight").
+ */
+static constexpr std::string_view KEY_FLIGHT_RECORDER_PATH { "flight_recorder_path" };  // NOLINT
+
+/**
+ * @brief the kind of flight recorder events.
+ */
+enum class flight_event_kind : std::uint32_t {
+
+    /**
+     * @brief a transaction has begun (args: transaction, transaction type, status code).
+     */
+    transaction_begin = 1,
+
+    /**
+     * @brief a commit request has finished (args: transaction, status code, error code, last call status).
+     */
+    transaction_commit = 2,
+
+    /**
+     * @brief a transaction was aborted (args: transaction, status code, last call status).
+     */
+    transaction_abort = 3,
+
+    /**
+     * @brief a scan was opened (args: transaction, iterator).
+     */
+    scan_open = 4,
+
+    /**
+     * @brief a scan was closed (args: iterator).
+     */
+    scan_close = 5,
+
+    /**
+     * @brief an operation failed (args: transaction, packed error code, storage name prefix, key prefix).
+     */
+    error = 6,
+};
+
+/**
+ * @brief returns the label of the given enum value.
+ * @param value the enum value
+ * @return the corresponded label
+ */
+std::string_view to_string_view(flight_event_kind value) noexcept;
+
+/**
+ * @brief an always-on recorder of the recent transaction lifecycle events.
+ * @details each event is a timestamp and a few integers written into the per-thread ring of a trace_channel, so that
+ * recording costs a few nanoseconds and never blocks. Each database owns its recorder, which decides whether or not
+ * the events of the database are recorded, while the recorded events of all databases are kept in the process-wide
+ * channel. The recent events are printed by print_diagnostics(), or dumped into a binary file when the configured
+ * signal is received. The binary dump can be decoded by sharksfin-flight-decoder.
+ */
+class flight_recorder {
+public:
+    /**
+     * @brief the number of events kept for each thread.
+     */
+    static constexpr std::size_t capacity = 4096;
+
+    /**
+     * @brief applies the flight recorder attributes of the database options.
+     * @details the dump signal and its file path are process-wide, so that the last configured ones are used.
+     * @param options the database options
+     * @return StatusCode::OK if the options are successfully applied
+     * @return StatusCode::ERR_INVALID_ARGUMENT if the attributes are malformed
+     */
+    StatusCode configure(DatabaseOptions const& options);
+
+    /**
+     * @brief returns whether or not this records events.
+     * @return true if this is enabled
+     * @return false otherwise
+     */
+    [[nodiscard]] bool enabled() const noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief sets whether or not this records events.
+     * @param on true to enable, false to disable
+     */
+    void enabled(bool on) noexcept {
+        enabled_.store(on, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief records an event.
+     * @param kind the event kind
+     * @param args the event arguments
+     */
+    template<class... Args>
+    void record(flight_event_kind kind, Args... args) const noexcept {
+        static_assert(sizeof...(Args) <= trace_event::max_args);
+        if (! enabled()) {
+            return;
+        }
+        trace_event event{};
+        event.timestamp_ = trace_clock::now();
+        event.kind_ = static_cast<std::uint32_t>(kind);
+        (event.add(to_arg(args)), ...);
+        channel().write(event);
+    }
+
+    /**
+     * @brief records an error event.
+     * @param transaction the transaction which caused the error
+     * @param code the error code
+     * @param native_status the status code of the underlying transaction engine
+     * @param locator the error locator, or nullptr if it is not available
+     */
+    void record_error(
+        void const* transaction,
+        ErrorCode code,
+        std::int64_t native_status,
+        ErrorLocator const* locator) const noexcept;
+
+    /**
+     * @brief prints the recorded events of all databases.
+     * @param os the target stream
+     */
+    static void print(std::ostream& os);
+
+    /**
+     * @brief writes the recorded events of all databases in the binary dump format.
+     * @param os the target stream
+     */
+    static void dump(std::ostream& os);
+
+    /**
+     * @brief prints the events in the binary dump.
+     * @param in the binary dump
+     * @param os the target stream
+     * @return true if the dump is successfully decoded
+     * @return false if the dump is malformed
+     */
+    static bool decode(std::istream& in, std::ostream& os);
+
+private:
+    std::atomic_bool enabled_{true};
+
+    static trace_channel& channel();
+
+    template<class T>
+    static std::uint64_t to_arg(T value) noexcept {
+        if constexpr (std::is_pointer_v<T>) {
+            return reinterpret_cast<std::uintptr_t>(value);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        } else {
+            return static_cast<std::uint64_t>(value);
+        }
+    }
+};
+
+}  // namespace sharksfin::common
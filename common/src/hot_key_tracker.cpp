@@ -0,0 +1,211 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hot_key_tracker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace sharksfin::common {
+
+namespace {
+
+// orders the heap so that the front is the least frequent key
+struct entry {
+    std::string key_{};
+    std::uint64_t count_{};
+
+    friend bool operator<(entry const& a, entry const& b) noexcept {
+        return a.count_ > b.count_;
+    }
+};
+
+class group {
+public:
+    explicit group(std::size_t capacity) :
+        capacity_(capacity)
+    {
+        heap_.reserve(capacity);
+    }
+
+    void add(std::string_view key) {
+        ++total_;
+        auto count = estimate_and_add(key);
+        if (auto it = std::find_if(heap_.begin(), heap_.end(), [&](auto& e) { return e.key_ == key; });
+            it != heap_.end()) {
+            it->count_ = count;
+            std::make_heap(heap_.begin(), heap_.end());
+            return;
+        }
+        if (heap_.size() < capacity_) {
+            heap_.emplace_back(entry{std::string{key}, count});
+            std::push_heap(heap_.begin(), heap_.end());
+            return;
+        }
+        if (! heap_.empty() && count > heap_.front().count_) {
+            std::pop_heap(heap_.begin(), heap_.end());
+            heap_.back() = entry{std::string{key}, count};
+            std::push_heap(heap_.begin(), heap_.end());
+        }
+    }
+
+    [[nodiscard]] std::vector<entry> top() const {
+        auto ret = heap_;
+        std::sort_heap(ret.begin(), ret.end());
+        return ret;
+    }
+
+private:
+    std::size_t capacity_;
+    std::uint64_t total_{};
+    std::vector<std::uint32_t> counters_ = std::vector<std::uint32_t>(
+        hot_key_tracker::sketch_depth * hot_key_tracker::sketch_width);
+    std::vector<entry> heap_{};
+
+    // conservative update: only the smallest counters are incremented, which keeps the overestimation lower
+    std::uint64_t estimate_and_add(std::string_view key) noexcept {
+        std::array<std::uint32_t*, hot_key_tracker::sketch_depth> cells{};
+        auto h1 = static_cast<std::uint64_t>(std::hash<std::string_view>{}(key));
+        // the columns of all rows must not be determined by the same low bits of the hash
+        auto h2 = ((h1 * 0x9e3779b97f4a7c15ULL) >> 32U) | 1U;
+        std::uint32_t min = UINT32_MAX;
+        for (std::size_t i = 0; i < hot_key_tracker::sketch_depth; ++i) {
+            auto column = static_cast<std::size_t>((h1 + i * h2) % hot_key_tracker::sketch_width);
+            cells[i] = &counters_[i * hot_key_tracker::sketch_width + column];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            min = std::min(min, *cells[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        if (min == UINT32_MAX) {
+            return min;
+        }
+        for (auto* cell : cells) {
+            if (*cell == min) {
+                ++*cell;
+            }
+        }
+        return min + 1U;
+    }
+};
+
+using group_key = std::pair<std::string, ErrorCode>;
+
+std::mutex instances_mutex_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::vector<hot_key_tracker const*> instances_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace
+
+namespace details {
+
+class hot_key_state {
+public:
+    mutable std::mutex mutex_{};
+    std::map<group_key, group> groups_{};
+};
+
+}  // namespace details
+
+hot_key_tracker::hot_key_tracker() :
+    state_(std::make_unique<details::hot_key_state>())
+{
+    std::unique_lock lk{instances_mutex_};
+    instances_.emplace_back(this);
+}
+
+hot_key_tracker::~hot_key_tracker() {
+    std::unique_lock lk{instances_mutex_};
+    instances_.erase(std::remove(instances_.begin(), instances_.end(), this), instances_.end());
+}
+
+StatusCode hot_key_tracker::configure(DatabaseOptions const& options) {
+    if (auto option = options.attribute(KEY_HOT_KEYS); option.has_value()) {
+        std::size_t capacity{};
+        try {
+            std::size_t pos{};
+            capacity = std::stoul(option.value(), &pos);
+            if (pos != option->size()) {
+                return StatusCode::ERR_INVALID_ARGUMENT;
+            }
+        } catch (std::exception const&) {
+            return StatusCode::ERR_INVALID_ARGUMENT;
+        }
+        std::unique_lock lk{state_->mutex_};
+        state_->groups_.clear();
+        capacity_ = capacity;
+    }
+    return StatusCode::OK;
+}
+
+void hot_key_tracker::record(ErrorCode reason, ErrorLocator const* locator) {
+    if (! enabled() || locator == nullptr || locator->kind() != ErrorLocatorKind::storage_key) {
+        return;
+    }
+    auto const& l = static_cast<StorageKeyErrorLocator const&>(*locator);  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    auto storage = l.storage();
+    auto key = l.key();
+    if (! storage && ! key) {
+        return;
+    }
+    record(storage.value_or(std::string_view{}), reason, key.value_or(std::string_view{}));
+}
+
+void hot_key_tracker::record(std::string_view storage, ErrorCode reason, std::string_view key) {
+    if (! enabled()) {
+        return;
+    }
+    key = key.substr(0, max_key_length);
+    std::unique_lock lk{state_->mutex_};
+    auto& groups = state_->groups_;
+    auto it = groups.find(group_key{storage, reason});
+    if (it == groups.end()) {
+        if (groups.size() >= max_groups) {
+            return;
+        }
+        it = groups.emplace(group_key{storage, reason}, group{capacity_}).first;
+    }
+    it->second.add(key);
+}
+
+void hot_key_tracker::snapshot(std::vector<HotKey>& out) const {
+    out.clear();
+    std::unique_lock lk{state_->mutex_};
+    for (auto&& [k, g] : state_->groups_) {
+        for (auto&& e : g.top()) {
+            out.emplace_back(HotKey{k.first, k.second, e.key_, e.count_});
+        }
+    }
+}
+
+void hot_key_tracker::print_diagnostics(std::ostream& os) {
+    std::unique_lock lk{instances_mutex_};
+    for (auto&& t : instances_) {
+        std::vector<HotKey> keys{};
+        t->snapshot(keys);
+        if (keys.empty()) {
+            continue;
+        }
+        os << "hot keys:" << std::endl;
+        for (auto&& k : keys) {
+            os << k << std::endl;
+        }
+    }
+}
+
+}  // namespace sharksfin::common
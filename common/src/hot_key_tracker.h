@@ -0,0 +1,150 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "sharksfin/DatabaseOptions.h"
+#include "sharksfin/ErrorCode.h"
+#include "sharksfin/ErrorLocator.h"
+#include "sharksfin/HotKey.h"
+#include "sharksfin/StatusCode.h"
+
+namespace sharksfin::common {
+
+/**
+ * @brief the attribute key of the number of hot keys tracked for each storage and reason (default: 16).
+ * @details "0" disables tracking hot keys.
+ */
+static constexpr std::string_view KEY_HOT_KEYS { "hot_keys" };  // NOLINT
+
+namespace details {
+class hot_key_state;
+}  // namespace details
+
+/**
+ * @brief tracks the keys which most frequently caused transaction failures.
+ * @details the failures are grouped by the storage and the reason. Each group estimates the number of failures
+ * per key with a count-min sketch, and keeps the top-k keys of the estimation in a min-heap, so that the memory
+ * usage of each group is fixed regardless of the number of distinct keys.
+ * Recording takes a lock, as this is only called on the failure path.
+ */
+class hot_key_tracker {
+public:
+    /**
+     * @brief the default number of keys tracked for each group.
+     */
+    static constexpr std::size_t default_capacity = 16;
+
+    /**
+     * @brief the max number of groups, the failures of the extra groups are ignored.
+     */
+    static constexpr std::size_t max_groups = 256;
+
+    /**
+     * @brief the max length of the tracked keys, the longer keys are truncated.
+     */
+    static constexpr std::size_t max_key_length = 64;
+
+    /**
+     * @brief the number of hash functions of the count-min sketch.
+     */
+    static constexpr std::size_t sketch_depth = 4;
+
+    /**
+     * @brief the number of counters for each hash function of the count-min sketch.
+     */
+    static constexpr std::size_t sketch_width = 1024;
+
+    /**
+     * @brief creates a new object with the default capacity.
+     */
+    hot_key_tracker();
+
+    hot_key_tracker(hot_key_tracker const& other) = delete;
+    hot_key_tracker& operator=(hot_key_tracker const& other) = delete;
+    hot_key_tracker(hot_key_tracker&& other) noexcept = delete;
+    hot_key_tracker& operator=(hot_key_tracker&& other) noexcept = delete;
+
+    /**
+     * @brief destroys this object.
+     */
+    ~hot_key_tracker();
+
+    /**
+     * @brief applies the hot key attributes of the database options.
+     * @param options the database options
+     * @return StatusCode::OK if the options are successfully applied
+     * @return StatusCode::ERR_INVALID_ARGUMENT if the attributes are malformed
+     */
+    StatusCode configure(DatabaseOptions const& options);
+
+    /**
+     * @brief returns whether or not this tracks hot keys.
+     * @return true if this is enabled
+     * @return false otherwise
+     */
+    [[nodiscard]] bool enabled() const noexcept {
+        return capacity_ != 0;
+    }
+
+    /**
+     * @brief returns the number of keys tracked for each group.
+     * @return the number of keys, or 0 if this is disabled
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    /**
+     * @brief records a failure located by the error locator.
+     * @details this does nothing if the locator is not available or has neither storage nor key.
+     * @param reason the failure reason
+     * @param locator the error locator, or nullptr if it is not available
+     */
+    void record(ErrorCode reason, ErrorLocator const* locator);
+
+    /**
+     * @brief records a failure caused by the key.
+     * @param storage the storage name
+     * @param reason the failure reason
+     * @param key the key which caused the failure
+     */
+    void record(std::string_view storage, ErrorCode reason, std::string_view key);
+
+    /**
+     * @brief returns the tracked hot keys.
+     * @details the result is ordered by the storage name and reason, and then by the descending count.
+     * @param out [OUT] the tracked hot keys
+     */
+    void snapshot(std::vector<HotKey>& out) const;
+
+    /**
+     * @brief prints the hot keys of all instances.
+     * @param os the target stream
+     */
+    static void print_diagnostics(std::ostream& os);
+
+private:
+    std::unique_ptr<details::hot_key_state> state_;
+    std::size_t capacity_{default_capacity};
+};
+
+}  // namespace sharksfin::common
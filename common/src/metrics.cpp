@@ -0,0 +1,370 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sharksfin::common {
+
+namespace {
+
+// the number of ErrorCode slots, whose values are multiples of -10
+constexpr std::size_t abort_reason_count = 11;
+
+std::size_t abort_index(ErrorCode reason) noexcept {
+    auto v = -static_cast<std::int64_t>(reason);
+    if (v < 0 || v % 10 != 0 || static_cast<std::size_t>(v / 10) >= abort_reason_count) {
+        return static_cast<std::size_t>(-static_cast<std::int64_t>(ErrorCode::ERROR) / 10);
+    }
+    return static_cast<std::size_t>(v / 10);
+}
+
+using counter = std::atomic<std::uint64_t>;
+
+// only the owner thread updates the counter, so that this avoids locked instructions
+void bump(counter& c, std::uint64_t n = 1) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+std::uint64_t load(counter const& c) noexcept {
+    return c.load(std::memory_order_relaxed);
+}
+
+struct storage_counters {
+    counter get_{};
+    counter put_{};
+    counter delete_{};
+    counter scan_{};
+};
+
+struct histogram {
+    std::array<counter, LatencyHistogram::bucket_count> buckets_{};
+    counter total_{};
+    counter max_{};
+};
+
+struct alignas(64) shard {
+    std::array<counter, metrics_operation_count> calls_{};
+    std::array<counter, metrics_operation_count> errors_{};
+    std::array<histogram, metrics_operation_count> latencies_{};
+    std::array<counter, abort_reason_count> aborts_{};
+    counter retries_{};
+    std::array<histogram, transaction_phase_count> phases_{};
+
+    // the owner thread reads the map without lock, and locks only to insert entries
+    std::map<std::string, storage_counters, std::less<>> storages_{};
+    std::mutex storages_mutex_{};
+
+    // accessed only from the owner thread
+    std::string last_storage_{};
+    storage_counters* last_counters_{};
+
+    bool in_use_{};
+
+    storage_counters& storage(std::string_view name) {
+        if (last_counters_ != nullptr && last_storage_ == name) {
+            return *last_counters_;
+        }
+        auto it = storages_.find(name);
+        if (it == storages_.end()) {
+            std::unique_lock lk{storages_mutex_};
+            it = storages_.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple()).first;
+        }
+        last_storage_.assign(name);
+        last_counters_ = &it->second;
+        return it->second;
+    }
+};
+
+std::atomic<std::uint64_t> next_state_id{1};
+
+// only the owner thread updates the histogram
+void add(histogram& h, std::uint64_t nanos) noexcept {
+    bump(h.buckets_[LatencyHistogram::bucket_index(nanos)]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    bump(h.total_, nanos);
+    if (nanos > load(h.max_)) {
+        h.max_.store(nanos, std::memory_order_relaxed);
+    }
+}
+
+void merge(LatencyHistogram& out, histogram const& h) noexcept {
+    for (std::size_t b = 0; b < LatencyHistogram::bucket_count; ++b) {
+        if (auto n = load(h.buckets_[b]); n > 0) {  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            out.add_bucket(b, n);
+        }
+    }
+    out.add_summary(load(h.total_), load(h.max_));
+}
+
+struct pending_durable {
+    std::uint64_t marker_;
+    metrics::clock::time_point at_;
+    std::shared_ptr<transaction_timer> timer_;
+
+    bool operator>(pending_durable const& other) const noexcept {
+        return marker_ > other.marker_;
+    }
+};
+
+}  // namespace
+
+namespace details {
+
+class metrics_state {
+public:
+    std::uint64_t id_{next_state_id.fetch_add(1, std::memory_order_relaxed)};
+    mutable std::mutex mutex_{};
+    std::vector<std::unique_ptr<shard>> shards_{};
+
+    std::mutex durable_mutex_{};
+    std::priority_queue<pending_durable, std::vector<pending_durable>, std::greater<>> pending_durable_{};
+
+    shard* acquire() {
+        std::unique_lock lk{mutex_};
+        for (auto&& s : shards_) {
+            if (! s->in_use_) {
+                s->in_use_ = true;
+                return s.get();
+            }
+        }
+        auto& s = shards_.emplace_back(std::make_unique<shard>());
+        s->in_use_ = true;
+        return s.get();
+    }
+
+    void release(shard* s) {
+        std::unique_lock lk{mutex_};
+        s->last_counters_ = nullptr;
+        s->in_use_ = false;
+    }
+};
+
+}  // namespace details
+
+namespace {
+
+struct local_entry {
+    std::uint64_t id_;
+    std::weak_ptr<details::metrics_state> owner_;
+    shard* shard_;
+};
+
+// returns the shards of the exited thread to their owners
+struct local_shards {
+    std::vector<local_entry> entries_{};
+
+    local_shards() = default;
+    local_shards(local_shards const& other) = delete;
+    local_shards& operator=(local_shards const& other) = delete;
+    local_shards(local_shards&& other) noexcept = delete;
+    local_shards& operator=(local_shards&& other) noexcept = delete;
+
+    ~local_shards() {
+        for (auto&& e : entries_) {
+            if (auto owner = e.owner_.lock()) {
+                owner->release(e.shard_);
+            }
+        }
+    }
+};
+
+thread_local local_shards local_shards_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local std::uint64_t cached_id_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local shard* cached_shard_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+shard& local_shard(std::shared_ptr<details::metrics_state> const& state) {
+    if (cached_id_ == state->id_) {
+        return *cached_shard_;
+    }
+    auto& entries = local_shards_.entries_;
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](auto& e) {
+        return e.owner_.expired();
+    }), entries.end());
+    shard* found{};
+    for (auto&& e : entries) {
+        if (e.id_ == state->id_) {
+            found = e.shard_;
+            break;
+        }
+    }
+    if (found == nullptr) {
+        found = state->acquire();
+        entries.emplace_back(local_entry{state->id_, state, found});
+    }
+    cached_id_ = state->id_;
+    cached_shard_ = found;
+    return *found;
+}
+
+std::mutex instances_mutex_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::vector<metrics const*> instances_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace
+
+metrics::metrics() :
+    state_(std::make_shared<details::metrics_state>())
+{
+    std::unique_lock lk{instances_mutex_};
+    instances_.emplace_back(this);
+}
+
+metrics::~metrics() {
+    std::unique_lock lk{instances_mutex_};
+    instances_.erase(std::remove(instances_.begin(), instances_.end(), this), instances_.end());
+}
+
+void metrics::record(MetricsOperation op, std::uint64_t nanos, bool error) noexcept {
+    if (! enabled_) {
+        return;
+    }
+    auto& s = local_shard(state_);
+    auto index = static_cast<std::size_t>(op);
+    bump(s.calls_[index]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    if (error) {
+        bump(s.errors_[index]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+    add(s.latencies_[index], nanos);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+void metrics::record_phases(TransactionTimings const& timings) noexcept {
+    if (! enabled_) {
+        return;
+    }
+    auto& s = local_shard(state_);
+    for (std::size_t i = 0; i < transaction_phase_count; ++i) {
+        if (auto d = timings.duration(static_cast<TransactionPhase>(i)); d) {
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(*d).count();
+            add(s.phases_[i], static_cast<std::uint64_t>(std::max<std::int64_t>(nanos, 0)));  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+}
+
+void metrics::record_storage(std::string_view storage, MetricsOperation op) {
+    if (! enabled_) {
+        return;
+    }
+    auto& c = local_shard(state_).storage(storage);
+    switch (op) {
+        case MetricsOperation::GET: bump(c.get_); break;
+        case MetricsOperation::PUT: bump(c.put_); break;
+        case MetricsOperation::DELETE: bump(c.delete_); break;
+        case MetricsOperation::SCAN_OPEN: bump(c.scan_); break;
+        default: break;
+    }
+}
+
+void metrics::record_abort(ErrorCode reason) noexcept {
+    if (! enabled_) {
+        return;
+    }
+    bump(local_shard(state_).aborts_[abort_index(reason)]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+void metrics::record_retry() noexcept {
+    if (! enabled_) {
+        return;
+    }
+    bump(local_shard(state_).retries_);
+}
+
+void metrics::enqueue_durable(std::uint64_t marker, std::shared_ptr<transaction_timer> timer) {
+    if (! enabled_) {
+        return;
+    }
+    std::unique_lock lk{state_->durable_mutex_};
+    state_->pending_durable_.emplace(pending_durable{marker, clock::now(), std::move(timer)});
+}
+
+void metrics::durable(std::uint64_t marker) {
+    if (! enabled_) {
+        return;
+    }
+    auto now = clock::now();
+    std::vector<pending_durable> finished{};
+    {
+        std::unique_lock lk{state_->durable_mutex_};
+        auto& pending = state_->pending_durable_;
+        while (! pending.empty() && pending.top().marker_ <= marker) {
+            finished.emplace_back(pending.top());
+            pending.pop();
+        }
+    }
+    auto& s = local_shard(state_);
+    for (auto&& e : finished) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - e.at_).count();
+        record(MetricsOperation::DURABLE_WAIT, static_cast<std::uint64_t>(elapsed), false);
+        if (e.timer_) {
+            e.timer_->mark(TransactionEvent::DURABLE, now);
+            if (auto d = e.timer_->timings().duration(TransactionPhase::DURABILITY); d) {
+                auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(*d).count();
+                add(s.phases_[static_cast<std::size_t>(TransactionPhase::DURABILITY)], static_cast<std::uint64_t>(std::max<std::int64_t>(nanos, 0)));  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    }
+}
+
+void metrics::snapshot(MetricsSnapshot& out) const {
+    out = {};
+    std::unique_lock lk{state_->mutex_};
+    for (auto&& s : state_->shards_) {
+        for (std::size_t i = 0; i < metrics_operation_count; ++i) {
+            auto& op = out.operations[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            op.calls += load(s->calls_[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            op.errors += load(s->errors_[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            merge(op.latency, s->latencies_[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        for (std::size_t i = 0; i < transaction_phase_count; ++i) {
+            merge(out.phases[i], s->phases_[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        for (std::size_t i = 0; i < abort_reason_count; ++i) {
+            if (auto n = load(s->aborts_[i]); n > 0) {  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                out.aborts[static_cast<ErrorCode>(-static_cast<std::int64_t>(i) * 10)] += n;
+            }
+        }
+        out.retries += load(s->retries_);
+        std::unique_lock slk{s->storages_mutex_};
+        for (auto&& [name, c] : s->storages_) {
+            auto& e = out.storages[name];
+            e.get_count += load(c.get_);
+            e.put_count += load(c.put_);
+            e.delete_count += load(c.delete_);
+            e.scan_count += load(c.scan_);
+        }
+    }
+}
+
+void metrics::print_diagnostics(std::ostream& os) {
+    std::unique_lock lk{instances_mutex_};
+    for (auto&& m : instances_) {
+        if (! m->enabled()) {
+            continue;
+        }
+        MetricsSnapshot snapshot{};
+        m->snapshot(snapshot);
+        os << "metrics:" << std::endl << snapshot;
+    }
+}
+
+}  // namespace sharksfin::common
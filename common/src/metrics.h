@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string_view>
+
+#include "sharksfin/ErrorCode.h"
+#include "sharksfin/Metrics.h"
+#include "sharksfin/StatusCode.h"
+#include "transaction_timer.h"
+
+namespace sharksfin::common {
+
+namespace details {
+class metrics_state;
+}  // namespace details
+
+/**
+ * @brief collects the per-operation metrics of a database.
+ * @details the counters and histograms are sharded per thread: each thread updates only its own shard without
+ * synchronization, and snapshot() sums up all shards. The shard of an exited thread is recycled by the threads
+ * created later, so that the number of shards is bounded by the max number of concurrent threads.
+ * Recording methods do nothing unless this is enabled.
+ */
+class metrics {
+public:
+    /**
+     * @brief the clock type.
+     */
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief creates a new disabled object.
+     */
+    metrics();
+
+    metrics(metrics const& other) = delete;
+    metrics& operator=(metrics const& other) = delete;
+    metrics(metrics&& other) noexcept = delete;
+    metrics& operator=(metrics&& other) noexcept = delete;
+
+    /**
+     * @brief destroys this object.
+     */
+    ~metrics();
+
+    /**
+     * @brief returns whether or not this collects metrics.
+     * @return true if this is enabled
+     * @return false otherwise
+     */
+    [[nodiscard]] bool enabled() const noexcept {
+        return enabled_;
+    }
+
+    /**
+     * @brief sets whether or not this collects metrics.
+     * @param on true to enable, false to disable
+     */
+    void enabled(bool on) noexcept {
+        enabled_ = on;
+    }
+
+    /**
+     * @brief returns the start time of an operation.
+     * @return the current time if this is enabled, or the epoch otherwise
+     */
+    [[nodiscard]] clock::time_point start() const noexcept {
+        if (! enabled_) {
+            return {};
+        }
+        return clock::now();
+    }
+
+    /**
+     * @brief records a finished operation.
+     * @param op the operation kind
+     * @param started the start time of the operation, which was returned by start()
+     * @param rc the operation result
+     */
+    void record(MetricsOperation op, clock::time_point started, StatusCode rc) noexcept {
+        if (! enabled_) {
+            return;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started).count();
+        record(op, static_cast<std::uint64_t>(elapsed), static_cast<std::int64_t>(rc) < 0);
+    }
+
+    /**
+     * @brief records a finished operation.
+     * @param op the operation kind
+     * @param nanos the latency in nanoseconds
+     * @param error whether or not the operation failed
+     */
+    void record(MetricsOperation op, std::uint64_t nanos, bool error) noexcept;
+
+    /**
+     * @brief records an operation against the storage.
+     * @param storage the storage name
+     * @param op the operation kind, one of GET, PUT, DELETE, or SCAN_OPEN
+     */
+    void record_storage(std::string_view storage, MetricsOperation op);
+
+    /**
+     * @brief records an aborted transaction.
+     * @param reason the abort reason
+     */
+    void record_abort(ErrorCode reason) noexcept;
+
+    /**
+     * @brief records a retry of the transaction by transaction_exec().
+     */
+    void record_retry() noexcept;
+
+    /**
+     * @brief records the elapsed time of the finished phases of the transaction.
+     * @param timings the timestamps of the transaction lifecycle
+     */
+    void record_phases(TransactionTimings const& timings) noexcept;
+
+    /**
+     * @brief remembers the committed transaction which is waiting to be durable.
+     * @param marker the durability marker of the transaction
+     * @param timer the timer of the transaction to mark TransactionEvent::DURABLE, or nullptr
+     */
+    void enqueue_durable(std::uint64_t marker, std::shared_ptr<transaction_timer> timer = {});
+
+    /**
+     * @brief records DURABLE_WAIT of the transactions which became durable.
+     * @details this also marks TransactionEvent::DURABLE of the enqueued timers, and records their
+     * TransactionPhase::DURABILITY.
+     * @param marker the durability marker which has been reached
+     */
+    void durable(std::uint64_t marker);
+
+    /**
+     * @brief sums up the collected metrics.
+     * @param out [OUT] the collected metrics
+     */
+    void snapshot(MetricsSnapshot& out) const;
+
+    /**
+     * @brief prints the metrics of all enabled instances.
+     * @param os the target stream
+     */
+    static void print_diagnostics(std::ostream& os);
+
+private:
+    std::shared_ptr<details::metrics_state> state_;
+    bool enabled_{};
+};
+
+}  // namespace sharksfin::common
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sharksfin::common {
+
+/**
+ * @brief a set of buffers whose contents stay at the same address until they are released.
+ * @details this is used to keep the results of pinned reads available across the subsequent API calls.
+ * Released buffers are recycled (with their capacity) by the later acquisitions.
+ * This object is thread-safe so that strands of the same transaction can share it.
+ */
+class pinned_buffers {
+public:
+    /**
+     * @brief the buffer type.
+     */
+    using buffer_type = std::string;
+
+    /**
+     * @brief acquires a new pinned buffer.
+     * @return the acquired buffer, which is available until release() or clear()
+     */
+    buffer_type& acquire() {
+        std::unique_lock lk{mutex_};
+        std::unique_ptr<buffer_type> buffer{};
+        if (free_.empty()) {
+            buffer = std::make_unique<buffer_type>();
+        } else {
+            buffer = std::move(free_.back());
+            free_.pop_back();
+            buffer->clear();
+        }
+        auto& ret = *buffer;
+        pinned_.emplace_back(std::move(buffer));
+        return ret;
+    }
+
+    /**
+     * @brief releases the pinned buffer.
+     * @param data the data pointer of the buffer to release
+     * @return true if the buffer was released
+     * @return false if the buffer is not pinned
+     */
+    bool release(void const* data) {
+        std::unique_lock lk{mutex_};
+        // search from the back because recently pinned buffers are likely released first
+        for (auto it = pinned_.rbegin(); it != pinned_.rend(); ++it) {
+            if (static_cast<void const*>((*it)->data()) == data) {
+                free_.emplace_back(std::move(*it));
+                *it = std::move(pinned_.back());
+                pinned_.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief releases all pinned buffers.
+     */
+    void clear() {
+        std::unique_lock lk{mutex_};
+        for (auto&& e : pinned_) {
+            free_.emplace_back(std::move(e));
+        }
+        pinned_.clear();
+    }
+
+    /**
+     * @brief returns the number of pinned buffers.
+     * @return the number of pinned buffers
+     */
+    [[nodiscard]] std::size_t size() const {
+        std::unique_lock lk{mutex_};
+        return pinned_.size();
+    }
+
+private:
+    std::vector<std::unique_ptr<buffer_type>> pinned_{};
+    std::vector<std::unique_ptr<buffer_type>> free_{};
+    mutable std::mutex mutex_{};
+};
+
+}  // namespace sharksfin::common
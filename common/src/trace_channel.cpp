@@ -0,0 +1,212 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "trace_channel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace sharksfin::common {
+
+double trace_clock::nanos_per_tick() {
+    static double const ratio = [] {
+        using clock = std::chrono::steady_clock;
+        auto t0 = clock::now();
+        auto c0 = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        auto t1 = clock::now();
+        auto c1 = now();
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        if (c1 <= c0) {
+            return 1.0;
+        }
+        return static_cast<double>(nanos) / static_cast<double>(c1 - c0);
+    }();
+    return ratio;
+}
+
+namespace details {
+
+class trace_ring {
+public:
+    static constexpr std::size_t words_per_event = sizeof(trace_event) / sizeof(std::uint64_t);
+
+    explicit trace_ring(std::size_t capacity) :
+        words_(std::make_unique<std::atomic<std::uint64_t>[]>(capacity * words_per_event)),
+        mask_(capacity - 1)
+    {}
+
+    // only the owner thread calls this
+    void write(trace_event const& event) noexcept {
+        std::array<std::uint64_t, words_per_event> buf{};
+        std::memcpy(buf.data(), &event, sizeof(event));
+        auto head = head_.load(std::memory_order_relaxed);
+        auto* slot = &words_[(head & mask_) * words_per_event];
+        // as the writer of seqlock: the reader which observes any of the following stores also observes the
+        // preceding head, and then it drops the overwritten event
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < words_per_event; ++i) {
+            slot[i].store(buf[i], std::memory_order_relaxed);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    void collect(std::vector<trace_event>& out) const {
+        auto capacity = mask_ + 1;
+        auto end = head_.load(std::memory_order_acquire);
+        auto begin = end > capacity ? end - capacity : 0;
+        auto base = out.size();
+        for (auto i = begin; i < end; ++i) {
+            std::array<std::uint64_t, words_per_event> buf{};
+            auto* slot = &words_[(i & mask_) * words_per_event];
+            for (std::size_t w = 0; w < words_per_event; ++w) {
+                buf[w] = slot[w].load(std::memory_order_relaxed);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            std::memcpy(static_cast<void*>(&out.emplace_back()), buf.data(), sizeof(trace_event));
+        }
+        // drop the events which may have been overwritten by the writer while reading
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto after = head_.load(std::memory_order_relaxed);
+        // the writer may be overwriting the slot of the event (after - capacity), whose head is not yet advanced
+        if (after + 1 > begin + capacity) {
+            auto torn = std::min<std::uint64_t>(after + 1 - (begin + capacity), end - begin);
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(base), out.begin() + static_cast<std::ptrdiff_t>(base + torn));
+        }
+    }
+
+    std::atomic_bool in_use_{};
+    std::atomic_bool detached_{};
+
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words_;
+    std::uint64_t mask_;
+    std::atomic<std::uint64_t> head_{};
+};
+
+}  // namespace details
+
+namespace {
+
+std::atomic<std::size_t> next_channel_id{1};
+
+std::uint64_t current_thread_id() noexcept {
+    return static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+// releases the rings of the exited thread, so that the later threads reuse them
+struct local_rings {
+    std::vector<std::pair<std::size_t, std::shared_ptr<details::trace_ring>>> entries_{};
+    std::uint64_t thread_{current_thread_id()};
+
+    local_rings() = default;
+    local_rings(local_rings const& other) = delete;
+    local_rings& operator=(local_rings const& other) = delete;
+    local_rings(local_rings&& other) noexcept = delete;
+    local_rings& operator=(local_rings&& other) noexcept = delete;
+
+    ~local_rings() {
+        for (auto&& [id, ring] : entries_) {
+            ring->in_use_.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local local_rings local_rings_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+std::size_t round_up(std::size_t capacity) noexcept {
+    std::size_t ret = 1;
+    while (ret < capacity) {
+        ret <<= 1U;
+    }
+    return ret;
+}
+
+}  // namespace
+
+trace_channel::trace_channel(std::string_view name, std::size_t capacity) :
+    name_(name),
+    capacity_(round_up(capacity)),
+    id_(next_channel_id.fetch_add(1, std::memory_order_relaxed))
+{}
+
+trace_channel::~trace_channel() {
+    std::unique_lock lk{mutex_};
+    for (auto&& ring : rings_) {
+        ring->detached_.store(true, std::memory_order_release);
+    }
+}
+
+details::trace_ring* trace_channel::local_ring() noexcept {
+    auto& entries = local_rings_.entries_;
+    for (auto&& [id, ring] : entries) {
+        if (id == id_) {
+            return ring.get();
+        }
+    }
+    try {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [](auto& e) {
+            return e.second->detached_.load(std::memory_order_acquire);
+        }), entries.end());
+        // reserve before acquiring the ring, so that the ring is never left in use by nobody
+        entries.reserve(entries.size() + 1);
+        std::shared_ptr<details::trace_ring> found{};
+        {
+            std::unique_lock lk{mutex_};
+            for (auto&& ring : rings_) {
+                bool expected = false;
+                if (ring->in_use_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                    found = ring;
+                    break;
+                }
+            }
+            if (! found) {
+                found = rings_.emplace_back(std::make_shared<details::trace_ring>(capacity_));
+                found->in_use_.store(true, std::memory_order_relaxed);
+            }
+        }
+        return entries.emplace_back(id_, std::move(found)).second.get();
+    } catch (...) {
+        // tracing is best-effort, and must not affect the traced operation
+        return nullptr;
+    }
+}
+
+void trace_channel::write(trace_event const& event) noexcept {
+    auto* ring = local_ring();
+    if (ring == nullptr) {
+        return;
+    }
+    auto e = event;
+    e.thread_ = local_rings_.thread_;
+    ring->write(e);
+}
+
+void trace_channel::collect(std::vector<trace_event>& out) const {
+    out.clear();
+    {
+        std::unique_lock lk{mutex_};
+        for (auto&& ring : rings_) {
+            ring->collect(out);
+        }
+    }
+    std::stable_sort(out.begin(), out.end(), [](auto& a, auto& b) {
+        return a.timestamp_ < b.timestamp_;
+    });
+}
+
+}  // namespace sharksfin::common
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace sharksfin::common {
+
+/**
+ * @brief the clock of trace events.
+ * @details this reads the time stamp counter where available, and the ticks are converted into nanoseconds only when
+ * the events are decoded.
+ */
+class trace_clock {
+public:
+    /**
+     * @brief returns the current ticks.
+     * @return the current ticks
+     */
+    static std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /**
+     * @brief returns the number of nanoseconds per tick.
+     * @details this is measured on the first call, and takes a few milliseconds.
+     * @return the nanoseconds per tick
+     */
+    static double nanos_per_tick();
+};
+
+/**
+ * @brief a fixed size binary trace event.
+ * @details the event occupies a cache line, and only consists of integral values so that recording it never formats
+ * or allocates anything. The label must point to a string with static storage duration.
+ */
+struct trace_event {
+
+    /**
+     * @brief the max number of arguments.
+     */
+    static constexpr std::size_t max_args = 4;
+
+    /**
+     * @brief the ticks when the event occurred.
+     */
+    std::uint64_t timestamp_{};
+
+    /**
+     * @brief the static label of the event (e.g. function name).
+     */
+    char const* label_{};
+
+    /**
+     * @brief the channel specific event kind.
+     */
+    std::uint32_t kind_{};
+
+    /**
+     * @brief the number of available arguments.
+     */
+    std::uint32_t arg_count_{};
+
+    /**
+     * @brief the ID of the thread which recorded the event (filled by the channel).
+     */
+    std::uint64_t thread_{};
+
+    /**
+     * @brief the event arguments.
+     */
+    std::array<std::uint64_t, max_args> args_{};
+
+    /**
+     * @brief appends an argument if room is left.
+     * @param value the argument value
+     */
+    void add(std::uint64_t value) noexcept {
+        if (arg_count_ < max_args) {
+            args_[arg_count_++] = value;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+};
+
+static_assert(sizeof(trace_event) == 64);
+
+namespace details {
+class trace_ring;
+}  // namespace details
+
+/**
+ * @brief a set of per-thread ring buffers which keep the recent trace events.
+ * @details each thread writes into its own ring without locks or atomic read-modify-write instructions, and the
+ * oldest events are overwritten when the ring is full. The rings of exited threads are kept and recycled by the
+ * later threads, so that their recent events are still available.
+ * collect() can run concurrently with writers, and drops the events which may have been overwritten while reading.
+ */
+class trace_channel {
+public:
+    /**
+     * @brief creates a new channel.
+     * @param name the channel name
+     * @param capacity the number of events kept for each thread, rounded up to a power of two
+     */
+    trace_channel(std::string_view name, std::size_t capacity);
+
+    trace_channel(trace_channel const& other) = delete;
+    trace_channel& operator=(trace_channel const& other) = delete;
+    trace_channel(trace_channel&& other) noexcept = delete;
+    trace_channel& operator=(trace_channel&& other) noexcept = delete;
+
+    /**
+     * @brief destroys this channel.
+     */
+    ~trace_channel();
+
+    /**
+     * @brief records an event into the ring of the current thread.
+     * @details the event is dropped if the ring for the current thread cannot be allocated.
+     * @param event the event to record
+     */
+    void write(trace_event const& event) noexcept;
+
+    /**
+     * @brief collects the recorded events of all threads.
+     * @param out [OUT] the recorded events in timestamp order
+     */
+    void collect(std::vector<trace_event>& out) const;
+
+    /**
+     * @brief returns the channel name.
+     * @return the channel name
+     */
+    [[nodiscard]] std::string_view name() const noexcept {
+        return name_;
+    }
+
+    /**
+     * @brief returns the number of events kept for each thread.
+     * @return the ring capacity
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    std::string name_;
+    std::size_t capacity_;
+    std::size_t id_;
+    mutable std::mutex mutex_{};
+    std::vector<std::shared_ptr<details::trace_ring>> rings_{};
+
+    details::trace_ring* local_ring() noexcept;
+};
+
+}  // namespace sharksfin::common
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "sharksfin/TransactionInfo.h"
+
+namespace sharksfin::common {
+
+/**
+ * @brief records the timestamps of the transaction lifecycle events.
+ * @details each event keeps the time when it was marked first, and the later marks are ignored. Marking an event
+ * which has been already marked only costs a relaxed load, so that it can be called on every operation.
+ * The events may be marked from different threads (e.g. commit and durability callbacks).
+ */
+class transaction_timer {
+public:
+    /**
+     * @brief the clock type.
+     */
+    using clock = TransactionTimings::clock;
+
+    /**
+     * @brief marks the event with the current time, if it has not been marked yet.
+     * @param event the target event
+     */
+    void mark(TransactionEvent event) noexcept {
+        if (marked(event)) {
+            return;
+        }
+        mark(event, clock::now());
+    }
+
+    /**
+     * @brief marks the event with the given time, if it has not been marked yet.
+     * @param event the target event
+     * @param at the time when the event occurred
+     */
+    void mark(TransactionEvent event, clock::time_point at) noexcept {
+        auto& e = slot(event);
+        clock::rep expected{};
+        e.compare_exchange_strong(expected, at.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief returns whether or not the event has been marked.
+     * @param event the target event
+     * @return true if the event has been marked
+     * @return false otherwise
+     */
+    [[nodiscard]] bool marked(TransactionEvent event) const noexcept {
+        return slot(event).load(std::memory_order_relaxed) != 0;
+    }
+
+    /**
+     * @brief returns the snapshot of the marked events.
+     * @return the marked events
+     */
+    [[nodiscard]] TransactionTimings timings() const noexcept {
+        TransactionTimings ret{};
+        for (std::size_t i = 0; i < transaction_event_count; ++i) {
+            auto event = static_cast<TransactionEvent>(i);
+            if (auto v = slot(event).load(std::memory_order_relaxed); v != 0) {
+                ret.at(event, clock::time_point{clock::duration{v}});
+            }
+        }
+        return ret;
+    }
+
+private:
+    std::array<std::atomic<clock::rep>, transaction_event_count> events_{};
+
+    [[nodiscard]] std::atomic<clock::rep>& slot(TransactionEvent event) noexcept {
+        return events_[static_cast<std::size_t>(event)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    [[nodiscard]] std::atomic<clock::rep> const& slot(TransactionEvent event) const noexcept {
+        return events_[static_cast<std::size_t>(event)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+};
+
+}  // namespace sharksfin::common
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_BENCH_ARGUMENTS_H_
+#define SHARKSFIN_BENCH_ARGUMENTS_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sharksfin/DatabaseOptions.h"
+
+namespace sharksfin::bench {
+
+/**
+ * @brief command line arguments of the benchmark programs.
+ * @details "-D<key>=<value>" is a database attribute, and "--<name>=<value>" (or "--<name>" for "true") is a
+ * benchmark option. Malformed or unknown arguments are reported as std::invalid_argument.
+ */
+class Arguments {
+public:
+    Arguments() = default;
+
+    /**
+     * @brief parses the command line arguments.
+     * @param args the command line arguments, including the program name
+     */
+    explicit Arguments(std::vector<char*> const& args) {
+        for (std::size_t i = 1, n = args.size(); i < n; ++i) {
+            std::string s { args[i] };  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (s.size() >= 3 && s.substr(0, 2) == "-D") {
+                if (auto delim = s.find('=', 2); delim != std::string::npos) {
+                    database_.attribute(s.substr(2, delim - 2), s.substr(delim + 1));
+                } else {
+                    database_.attribute(s.substr(2), "");
+                }
+                continue;
+            }
+            if (s.size() >= 3 && s.substr(0, 2) == "--") {
+                if (auto delim = s.find('=', 2); delim != std::string::npos) {
+                    options_[s.substr(2, delim - 2)] = s.substr(delim + 1);
+                } else {
+                    options_[s.substr(2)] = "true";
+                }
+                continue;
+            }
+            throw std::invalid_argument("unrecognized argument: " + s);
+        }
+    }
+
+    /**
+     * @brief returns the database options.
+     * @return the database options
+     */
+    [[nodiscard]] DatabaseOptions& database() noexcept {
+        return database_;
+    }
+
+    /**
+     * @brief returns whether or not the option is specified.
+     * @param name the option name
+     * @return true if the option is specified
+     */
+    [[nodiscard]] bool has(std::string_view name) {
+        used_.emplace(name);
+        return options_.find(name) != options_.end();
+    }
+
+    /**
+     * @brief returns the string option.
+     * @param name the option name
+     * @param default_value the value if the option is not specified
+     * @return the option value
+     */
+    [[nodiscard]] std::string text(std::string_view name, std::string_view default_value) {
+        used_.emplace(name);
+        if (auto it = options_.find(name); it != options_.end()) {
+            return it->second;
+        }
+        return std::string{default_value};
+    }
+
+    /**
+     * @brief returns the unsigned integer option.
+     * @param name the option name
+     * @param default_value the value if the option is not specified
+     * @return the option value
+     */
+    [[nodiscard]] std::uint64_t integer(std::string_view name, std::uint64_t default_value) {
+        auto v = text(name, {});
+        if (v.empty()) {
+            return default_value;
+        }
+        std::size_t pos{};
+        std::uint64_t ret{};
+        try {
+            ret = std::stoull(v, &pos);
+        } catch (std::exception const&) {
+            pos = 0;
+        }
+        if (pos != v.size()) {
+            throw std::invalid_argument("--" + std::string{name} + " must be an unsigned integer: " + v);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief returns the floating point option.
+     * @param name the option name
+     * @param default_value the value if the option is not specified
+     * @return the option value
+     */
+    [[nodiscard]] double real(std::string_view name, double default_value) {
+        auto v = text(name, {});
+        if (v.empty()) {
+            return default_value;
+        }
+        std::size_t pos{};
+        double ret{};
+        try {
+            ret = std::stod(v, &pos);
+        } catch (std::exception const&) {
+            pos = 0;
+        }
+        if (pos != v.size()) {
+            throw std::invalid_argument("--" + std::string{name} + " must be a number: " + v);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief returns the boolean option.
+     * @param name the option name
+     * @return true if the option is specified without value or with "true"
+     */
+    [[nodiscard]] bool flag(std::string_view name) {
+        auto v = text(name, "false");
+        if (v == "true" || v == "1") {
+            return true;
+        }
+        if (v == "false" || v == "0") {
+            return false;
+        }
+        throw std::invalid_argument("--" + std::string{name} + " must be true or false: " + v);
+    }
+
+    /**
+     * @brief validates that all the specified options have been consumed.
+     */
+    void check_unused() const {
+        for (auto&& [name, value] : options_) {
+            if (used_.find(name) == used_.end()) {
+                throw std::invalid_argument("unknown option: --" + name);
+            }
+        }
+    }
+
+private:
+    DatabaseOptions database_{};
+    std::map<std::string, std::string, std::less<>> options_{};
+    std::set<std::string, std::less<>> used_{};
+};
+
+}  // namespace sharksfin::bench
+
+#endif  // SHARKSFIN_BENCH_ARGUMENTS_H_
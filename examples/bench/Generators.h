@@ -0,0 +1,238 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_BENCH_GENERATORS_H_
+#define SHARKSFIN_BENCH_GENERATORS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace sharksfin::bench {
+
+/**
+ * @brief the random number engine used by the benchmark threads.
+ */
+using Random = std::mt19937_64;
+
+/**
+ * @brief the distribution of chosen items.
+ */
+enum class Distribution {
+
+    /**
+     * @brief every item is chosen with the same probability.
+     */
+    UNIFORM,
+
+    /**
+     * @brief a few items are chosen much more frequently than the others.
+     */
+    ZIPFIAN,
+
+    /**
+     * @brief the recently inserted items are chosen more frequently.
+     */
+    LATEST,
+};
+
+/**
+ * @brief returns the distribution of the given name.
+ * @param name the distribution name ("uniform", "zipfian", or "latest")
+ * @return the distribution
+ * @throws std::invalid_argument if the name is unknown
+ */
+inline Distribution parse_distribution(std::string_view name) {
+    if (name == "uniform") {
+        return Distribution::UNIFORM;
+    }
+    if (name == "zipfian") {
+        return Distribution::ZIPFIAN;
+    }
+    if (name == "latest") {
+        return Distribution::LATEST;
+    }
+    throw std::invalid_argument("unknown distribution: " + std::string{name});
+}
+
+/**
+ * @brief generates zipfian distributed integers in [0, items), where 0 is the most frequent.
+ * @details this is the algorithm of Gray et al. "Quickly generating billion-record synthetic databases", which
+ * is also used by YCSB. Building an object takes O(items) time to compute the zeta constant.
+ */
+class ZipfianGenerator {
+public:
+    /**
+     * @brief the default skew of the distribution, which is same as YCSB.
+     */
+    static constexpr double default_theta = 0.99;
+
+    /**
+     * @brief creates a new object.
+     * @param items the number of items, must be positive
+     * @param theta the skew of the distribution in (0, 1)
+     */
+    explicit ZipfianGenerator(std::uint64_t items, double theta = default_theta) :
+        items_(std::max<std::uint64_t>(items, 1)),
+        theta_(theta),
+        alpha_(1.0 / (1.0 - theta)),
+        zetan_(zeta(items_, theta)),
+        eta_((1.0 - std::pow(2.0 / static_cast<double>(items_), 1.0 - theta)) / (1.0 - zeta(2, theta) / zetan_))
+    {}
+
+    /**
+     * @brief returns the next integer.
+     * @param random the random number engine
+     * @return the generated integer in [0, items)
+     */
+    std::uint64_t operator()(Random& random) const {
+        auto u = std::uniform_real_distribution<double>{}(random);
+        auto uz = u * zetan_;
+        if (uz < 1.0) {
+            return 0;
+        }
+        if (uz < 1.0 + std::pow(0.5, theta_)) {
+            return std::min<std::uint64_t>(1, items_ - 1);
+        }
+        auto ret = static_cast<std::uint64_t>(static_cast<double>(items_) * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+        return std::min(ret, items_ - 1);
+    }
+
+private:
+    std::uint64_t items_;
+    double theta_;
+    double alpha_;
+    double zetan_;
+    double eta_;
+
+    static double zeta(std::uint64_t n, double theta) {
+        double ret = 0.0;
+        for (std::uint64_t i = 1; i <= n; ++i) {
+            ret += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return ret;
+    }
+};
+
+/**
+ * @brief chooses item numbers in the given distribution.
+ * @details the number of items can grow by inserts after this object was created. Zipfian choices are made over the
+ * initial items, and latest choices count back from the most recent item.
+ */
+class ItemChooser {
+public:
+    /**
+     * @brief creates a new object.
+     * @param distribution the distribution
+     * @param items the initial number of items, must be positive
+     */
+    ItemChooser(Distribution distribution, std::uint64_t items) :
+        distribution_(distribution),
+        zipfian_(distribution == Distribution::UNIFORM ? 1 : items)
+    {}
+
+    /**
+     * @brief returns the next item number.
+     * @param random the random number engine
+     * @param items the current number of items
+     * @return the chosen item number in [0, items)
+     */
+    std::uint64_t operator()(Random& random, std::uint64_t items) const {
+        switch (distribution_) {
+            case Distribution::UNIFORM:
+                return std::uniform_int_distribution<std::uint64_t>{0, items - 1}(random);
+            case Distribution::ZIPFIAN:
+                return std::min(zipfian_(random), items - 1);
+            case Distribution::LATEST:
+                return items - 1 - std::min(zipfian_(random), items - 1);
+        }
+        std::abort();
+    }
+
+private:
+    Distribution distribution_;
+    ZipfianGenerator zipfian_;
+};
+
+/**
+ * @brief chooses sizes (e.g. value lengths) in the given range.
+ */
+class SizeChooser {
+public:
+    /**
+     * @brief creates a new object.
+     * @param distribution the distribution, LATEST is treated as ZIPFIAN
+     * @param min the min size
+     * @param max the max size, must not be less than min
+     */
+    SizeChooser(Distribution distribution, std::size_t min, std::size_t max) :
+        distribution_(distribution),
+        min_(min),
+        max_(std::max(min, max)),
+        zipfian_(distribution == Distribution::UNIFORM ? 1 : max_ - min_ + 1)
+    {}
+
+    /**
+     * @brief returns the next size.
+     * @param random the random number engine
+     * @return the chosen size, smaller sizes are more frequent if the distribution is skewed
+     */
+    std::size_t operator()(Random& random) const {
+        if (min_ == max_) {
+            return min_;
+        }
+        if (distribution_ == Distribution::UNIFORM) {
+            return std::uniform_int_distribution<std::size_t>{min_, max_}(random);
+        }
+        return min_ + static_cast<std::size_t>(zipfian_(random));
+    }
+
+    /**
+     * @brief returns the max size.
+     * @return the max size
+     */
+    [[nodiscard]] std::size_t max() const noexcept {
+        return max_;
+    }
+
+private:
+    Distribution distribution_;
+    std::size_t min_;
+    std::size_t max_;
+    ZipfianGenerator zipfian_;
+};
+
+/**
+ * @brief returns the hash of the item number, which scatters the consecutive items over the key space.
+ * @param value the item number
+ * @return the FNV-1a hash of the item number
+ */
+inline std::uint64_t fnv_hash(std::uint64_t value) noexcept {
+    std::uint64_t ret = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        ret ^= (value >> (i * 8U)) & 0xffU;
+        ret *= 0x100000001b3ULL;
+    }
+    return ret;
+}
+
+}  // namespace sharksfin::bench
+
+#endif  // SHARKSFIN_BENCH_GENERATORS_H_
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_BENCH_KEY_BUILDER_H_
+#define SHARKSFIN_BENCH_KEY_BUILDER_H_
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "sharksfin/Slice.h"
+
+namespace sharksfin::bench {
+
+/**
+ * @brief builds order preserving keys from unsigned integers.
+ * @details each integer is encoded in big-endian, so that the byte-wise order of the keys is same as the
+ * lexicographic order of the integer tuples.
+ */
+class KeyBuilder {
+public:
+    /**
+     * @brief appends an unsigned integer.
+     * @tparam T the integer type
+     * @param value the integer
+     * @return this
+     */
+    template<class T>
+    KeyBuilder& add(T value) {
+        static_assert(std::is_unsigned_v<T>);
+        for (std::size_t i = sizeof(T); i > 0; --i) {
+            buffer_.push_back(static_cast<char>(static_cast<std::uint64_t>(value) >> ((i - 1) * 8U)));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief returns the built key.
+     * @return the key
+     */
+    [[nodiscard]] std::string const& str() const noexcept {
+        return buffer_;
+    }
+
+    /**
+     * @brief returns the built key.
+     * @return the key
+     */
+    operator Slice() const noexcept {  // NOLINT(google-explicit-constructor)
+        return Slice{buffer_};
+    }
+
+    /**
+     * @brief reads an unsigned integer from the key.
+     * @tparam T the integer type
+     * @param key the key
+     * @param offset the byte offset of the integer
+     * @return the integer
+     */
+    template<class T>
+    static T read(Slice key, std::size_t offset) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        std::uint64_t ret = 0;
+        for (std::size_t i = 0; i < sizeof(T) && offset + i < key.size(); ++i) {
+            ret = (ret << 8U) | static_cast<std::uint8_t>(key.data<char>()[offset + i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        return static_cast<T>(ret);
+    }
+
+private:
+    std::string buffer_{};
+};
+
+/**
+ * @brief builds an order preserving key from the integers.
+ * @tparam Args the unsigned integer types
+ * @param values the integers
+ * @return the built key
+ */
+template<class... Args>
+KeyBuilder make_key(Args... values) {
+    KeyBuilder ret{};
+    (ret.add(values), ...);
+    return ret;
+}
+
+}  // namespace sharksfin::bench
+
+#endif  // SHARKSFIN_BENCH_KEY_BUILDER_H_
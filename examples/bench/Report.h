@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_BENCH_REPORT_H_
+#define SHARKSFIN_BENCH_REPORT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+#include "sharksfin/api.h"
+
+namespace sharksfin::bench {
+
+/**
+ * @brief the clock to measure latencies.
+ */
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief returns the elapsed time in nanoseconds.
+ * @param from the start time
+ * @param to the end time
+ * @return the elapsed nanoseconds
+ */
+inline std::uint64_t nanos_between(Clock::time_point from, Clock::time_point to) noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+/**
+ * @brief prints the latency distribution in a line.
+ * @param out the target stream
+ * @param label the label of the line
+ * @param latency the latency distribution
+ */
+inline void print_latency(std::ostream& out, std::string_view label, LatencyHistogram const& latency) {
+    out << "latency " << label << ": count=" << latency.count();
+    if (latency.count() > 0) {
+        out << " mean_ns=" << latency.mean()
+            << " p50_ns=" << latency.percentile(50)
+            << " p90_ns=" << latency.percentile(90)
+            << " p99_ns=" << latency.percentile(99)
+            << " p999_ns=" << latency.percentile(99.9)
+            << " max_ns=" << latency.max();
+    }
+    out << std::endl;
+}
+
+/**
+ * @brief prints the name of the linked implementation.
+ * @param out the target stream
+ */
+inline void print_implementation(std::ostream& out) {
+    Slice id{};
+    if (implementation_id(&id) == StatusCode::OK) {
+        out << "implementation: " << id.to_string_view() << std::endl;
+    }
+}
+
+}  // namespace sharksfin::bench
+
+#endif  // SHARKSFIN_BENCH_REPORT_H_
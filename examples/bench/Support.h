@@ -0,0 +1,78 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_BENCH_SUPPORT_H_
+#define SHARKSFIN_BENCH_SUPPORT_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "sharksfin/api.h"
+
+namespace sharksfin::bench {
+
+/**
+ * @brief raises an error if the status code is not StatusCode::OK.
+ * @param rc the status code
+ * @param what the description of the failed request
+ * @throws std::runtime_error if the status code is not StatusCode::OK
+ */
+inline void check(StatusCode rc, std::string_view what) {
+    if (rc != StatusCode::OK) {
+        throw std::runtime_error(std::string{what} + " failed: " + std::string{to_string_view(rc)});
+    }
+}
+
+/**
+ * @brief waits until the transaction leaves StateKind::WAITING_START.
+ * @details long transactions reject operations until they start.
+ * @param handle the target transaction
+ */
+inline void wait_for_start(TransactionControlHandle handle) {
+    while (true) {
+        TransactionState state{};
+        if (transaction_check(handle, state) != StatusCode::OK
+                || state.state_kind() != TransactionState::StateKind::WAITING_START) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief runs the function on the given number of threads, and waits for them.
+ * @tparam Function the function type, which accepts the thread index
+ * @param threads the number of threads
+ * @param function the function
+ */
+template<class Function>
+void run_threads(std::size_t threads, Function&& function) {
+    std::vector<std::thread> workers{};
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&function, i] { function(i); });
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+}  // namespace sharksfin::bench
+
+#endif  // SHARKSFIN_BENCH_SUPPORT_H_
@@ -0,0 +1,947 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Arguments.h"
+#include "Generators.h"
+#include "KeyBuilder.h"
+#include "Report.h"
+#include "Support.h"
+
+#include "sharksfin/api.h"
+#include "sharksfin/HandleHolder.h"
+#include "sharksfin/Environment.h"
+
+namespace sharksfin::bench {
+
+/**
+ * @brief the TPC-C transaction profiles.
+ */
+enum class Procedure : std::size_t {
+    NEW_ORDER = 0,
+    PAYMENT,
+    ORDER_STATUS,
+    DELIVERY,
+    STOCK_LEVEL,
+};
+
+static constexpr std::size_t procedure_count = static_cast<std::size_t>(Procedure::STOCK_LEVEL) + 1;
+
+static constexpr std::string_view to_string_view(Procedure value) {
+    switch (value) {
+        case Procedure::NEW_ORDER: return "NEW_ORDER";
+        case Procedure::PAYMENT: return "PAYMENT";
+        case Procedure::ORDER_STATUS: return "ORDER_STATUS";
+        case Procedure::DELIVERY: return "DELIVERY";
+        case Procedure::STOCK_LEVEL: return "STOCK_LEVEL";
+    }
+    std::abort();
+}
+
+// the standard mix of the transaction profiles
+static constexpr std::array<double, procedure_count> procedure_mix { 0.45, 0.43, 0.04, 0.04, 0.04 };
+
+/**
+ * @brief the storages of the TPC-C tables.
+ */
+enum class Table : std::size_t {
+    WAREHOUSE = 0,
+    DISTRICT,
+    CUSTOMER,
+    HISTORY,
+    NEW_ORDER,
+    ORDERS,
+    ORDER_LINE,
+    ITEM,
+    STOCK,
+};
+
+static constexpr std::size_t table_count = static_cast<std::size_t>(Table::STOCK) + 1;
+
+static constexpr std::array<std::string_view, table_count> table_names {
+    "tpcc.warehouse",
+    "tpcc.district",
+    "tpcc.customer",
+    "tpcc.history",
+    "tpcc.new_order",
+    "tpcc.orders",
+    "tpcc.order_line",
+    "tpcc.item",
+    "tpcc.stock",
+};
+
+static constexpr std::uint32_t districts_per_warehouse = 10;
+static constexpr std::uint32_t min_order_lines = 5;
+static constexpr std::uint32_t max_order_lines = 15;
+static constexpr std::uint32_t stock_level_orders = 20;
+static constexpr std::size_t load_batch_size = 500;
+
+// the records are stored as their object representation
+struct WarehouseRecord {
+    double ytd;
+    double tax;
+    std::array<char, 80> address;
+};
+
+struct DistrictRecord {
+    double ytd;
+    double tax;
+    std::uint32_t next_o_id;
+    std::array<char, 76> address;
+};
+
+struct CustomerRecord {
+    double balance;
+    double ytd_payment;
+    double discount;
+    std::uint32_t payment_cnt;
+    std::uint32_t delivery_cnt;
+    std::uint32_t last_o_id;
+    std::uint32_t bad_credit;
+    std::array<char, 300> data;
+};
+
+struct HistoryRecord {
+    double amount;
+    std::uint32_t c_w_id;
+    std::uint32_t c_d_id;
+    std::uint32_t c_id;
+    std::array<char, 24> data;
+};
+
+struct OrderRecord {
+    std::int64_t entry_d;
+    std::uint32_t c_id;
+    std::uint32_t carrier_id;
+    std::uint32_t ol_cnt;
+    std::uint32_t all_local;
+};
+
+struct OrderLineRecord {
+    std::int64_t delivery_d;
+    double amount;
+    std::uint32_t i_id;
+    std::uint32_t supply_w_id;
+    std::uint32_t quantity;
+    std::array<char, 24> dist_info;
+};
+
+struct ItemRecord {
+    double price;
+    std::uint32_t im_id;
+    std::array<char, 74> data;
+};
+
+struct StockRecord {
+    std::uint32_t quantity;
+    std::uint32_t ytd;
+    std::uint32_t order_cnt;
+    std::uint32_t remote_cnt;
+    std::array<char, 290> data;
+};
+
+template<class T>
+static Slice as_slice(T const& record) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return Slice{&record, sizeof(T)};
+}
+
+struct Config {
+    std::uint32_t warehouses{};
+    std::size_t threads{};
+    double duration{};
+    std::uint32_t items{};
+    std::uint32_t customers{};
+    std::uint32_t orders{};
+    bool long_transactions{};
+    std::uint64_t seed{};
+
+    [[nodiscard]] std::uint32_t first_new_order() const noexcept {
+        // the last 30% of the initial orders are not delivered yet (900 of 3000 in the specification)
+        return orders - orders * 3 / 10 + 1;
+    }
+};
+
+struct Database {
+    DatabaseHandle handle{};
+    std::array<StorageHandle, table_count> storages{};
+    SequenceId history_sequence{};
+    std::atomic<std::uint64_t> history_ids{};
+
+    StorageHandle operator[](Table table) const noexcept {
+        return storages[static_cast<std::size_t>(table)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+};
+
+struct Statistics {
+    std::array<std::uint64_t, procedure_count> committed{};
+    std::array<std::uint64_t, procedure_count> aborted{};
+    std::array<std::uint64_t, procedure_count> rolled_back{};
+    std::array<LatencyHistogram, procedure_count> latency{};
+
+    void merge(Statistics const& other) {
+        for (std::size_t i = 0; i < procedure_count; ++i) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            committed[i] += other.committed[i];
+            aborted[i] += other.aborted[i];
+            rolled_back[i] += other.rolled_back[i];
+            latency[i].merge(other.latency[i]);
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+};
+
+static std::int64_t now() {
+    return std::chrono::system_clock::now().time_since_epoch().count();
+}
+
+template<class T>
+static StatusCode read(TransactionHandle tx, StorageHandle storage, Slice key, T& result) {
+    Slice value{};
+    if (auto rc = content_get(tx, storage, key, &value); rc != StatusCode::OK) {
+        return rc;
+    }
+    if (value.size() != sizeof(T)) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    std::memcpy(&result, value.data(), sizeof(T));
+    return StatusCode::OK;
+}
+
+static StatusCode commit(TransactionControlHandle handle) {
+    std::promise<StatusCode> promise{};
+    auto result = promise.get_future();
+    transaction_commit_with_callback(handle, [&promise](StatusCode rc, ErrorCode, durability_marker_type) {
+        promise.set_value(rc);
+    });
+    return result.get();
+}
+
+// puts the records in batches of transactions, retrying the aborted batch
+class Loader {
+public:
+    explicit Loader(Database& database) :
+        database_(database)
+    {}
+
+    void put(Table table, KeyBuilder const& key, Slice value) {
+        pending_.emplace_back(table, key.str(), value.to_string());
+        if (pending_.size() >= load_batch_size) {
+            flush();
+        }
+    }
+
+    void flush() {
+        while (! pending_.empty()) {
+            HandleHolder<TransactionControlHandle> tch{};
+            check(transaction_begin(database_.handle, {}, &tch.get()), "transaction_begin");
+            TransactionHandle tx{};
+            check(transaction_borrow_handle(tch.get(), &tx), "transaction_borrow_handle");
+            StatusCode rc{};
+            for (auto&& [table, key, value] : pending_) {
+                if (rc = content_put(tx, database_[table], key, value); rc != StatusCode::OK) {
+                    break;
+                }
+            }
+            if (rc == StatusCode::OK) {
+                rc = commit(tch.get());
+            } else {
+                transaction_abort(tch.get());
+            }
+            if (rc == StatusCode::OK) {
+                pending_.clear();
+            } else if (rc != StatusCode::ERR_ABORTED && rc != StatusCode::ERR_ABORTED_RETRYABLE) {
+                check(rc, "loading records");
+            }
+        }
+    }
+
+private:
+    Database& database_;
+    std::vector<std::tuple<Table, std::string, std::string>> pending_{};
+};
+
+class Worker {
+public:
+    Worker(Database& database, Config const& config, std::size_t index) :
+        database_(database),
+        config_(config),
+        random_(config.seed + index),
+        home_(static_cast<std::uint32_t>(index % config.warehouses) + 1)
+    {}
+
+    void load_items() {
+        Loader loader{database_};
+        for (std::uint32_t i = 1; i <= config_.items; ++i) {
+            ItemRecord item{};
+            item.price = static_cast<double>(uniform(100, 10000)) / 100.0;
+            item.im_id = uniform(1, 10000);
+            fill(item.data);
+            loader.put(Table::ITEM, make_key(i), as_slice(item));
+        }
+        loader.flush();
+    }
+
+    void load_warehouse(std::uint32_t w) {
+        Loader loader{database_};
+        WarehouseRecord warehouse{};
+        warehouse.ytd = 300000.0;
+        warehouse.tax = static_cast<double>(uniform(0, 2000)) / 10000.0;
+        fill(warehouse.address);
+        loader.put(Table::WAREHOUSE, make_key(w), as_slice(warehouse));
+        for (std::uint32_t i = 1; i <= config_.items; ++i) {
+            StockRecord stock{};
+            stock.quantity = uniform(10, 100);
+            fill(stock.data);
+            loader.put(Table::STOCK, make_key(w, i), as_slice(stock));
+        }
+        for (std::uint32_t d = 1; d <= districts_per_warehouse; ++d) {
+            DistrictRecord district{};
+            district.ytd = 30000.0;
+            district.tax = static_cast<double>(uniform(0, 2000)) / 10000.0;
+            district.next_o_id = config_.orders + 1;
+            fill(district.address);
+            loader.put(Table::DISTRICT, make_key(w, d), as_slice(district));
+
+            // each order is placed by a distinct customer while the customers remain
+            std::vector<std::uint32_t> placed_by(config_.orders);
+            std::iota(placed_by.begin(), placed_by.end(), 0U);
+            std::shuffle(placed_by.begin(), placed_by.end(), random_);
+            std::vector<std::uint32_t> last_order(config_.customers + 1);
+            for (std::uint32_t o = 1; o <= config_.orders; ++o) {
+                auto c = placed_by[o - 1] % config_.customers + 1;
+                last_order[c] = o;
+                bool delivered = o < config_.first_new_order();
+                OrderRecord order{};
+                order.entry_d = now();
+                order.c_id = c;
+                order.carrier_id = delivered ? uniform(1, 10) : 0;
+                order.ol_cnt = uniform(min_order_lines, max_order_lines);
+                order.all_local = 1;
+                loader.put(Table::ORDERS, make_key(w, d, o), as_slice(order));
+                for (std::uint32_t l = 1; l <= order.ol_cnt; ++l) {
+                    OrderLineRecord line{};
+                    line.delivery_d = delivered ? order.entry_d : 0;
+                    line.amount = delivered ? 0.0 : static_cast<double>(uniform(1, 999999)) / 100.0;
+                    line.i_id = uniform(1, config_.items);
+                    line.supply_w_id = w;
+                    line.quantity = 5;
+                    fill(line.dist_info);
+                    loader.put(Table::ORDER_LINE, make_key(w, d, o, l), as_slice(line));
+                }
+                if (! delivered) {
+                    loader.put(Table::NEW_ORDER, make_key(w, d, o), {});
+                }
+            }
+            for (std::uint32_t c = 1; c <= config_.customers; ++c) {
+                CustomerRecord customer{};
+                customer.balance = -10.0;
+                customer.ytd_payment = 10.0;
+                customer.discount = static_cast<double>(uniform(0, 5000)) / 10000.0;
+                customer.payment_cnt = 1;
+                customer.last_o_id = last_order[c];
+                customer.bad_credit = uniform(1, 10) == 1 ? 1 : 0;
+                fill(customer.data);
+                loader.put(Table::CUSTOMER, make_key(w, d, c), as_slice(customer));
+
+                HistoryRecord history{};
+                history.amount = 10.0;
+                history.c_w_id = w;
+                history.c_d_id = d;
+                history.c_id = c;
+                fill(history.data);
+                loader.put(Table::HISTORY, make_key(database_.history_ids.fetch_add(1) + 1), as_slice(history));
+            }
+        }
+        loader.flush();
+    }
+
+    Statistics run(std::atomic_bool const& stop) {
+        Statistics stats{};
+        while (! stop.load(std::memory_order_relaxed)) {
+            auto procedure = choose_procedure();
+            auto index = static_cast<std::size_t>(procedure);
+            auto started = Clock::now();
+            // the aborted transactions are retried until they are committed or rolled back
+            while (true) {
+                auto rc = execute(procedure);
+                if (rc == StatusCode::OK) {
+                    ++stats.committed[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                    stats.latency[index].add(nanos_between(started, Clock::now()));  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                    break;
+                }
+                if (rc == StatusCode::USER_ROLLBACK) {
+                    ++stats.rolled_back[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                    break;
+                }
+                ++stats.aborted[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                if (stop.load(std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+        }
+        return stats;
+    }
+
+private:
+    Database& database_;
+    Config const& config_;
+    Random random_;
+    std::uint32_t home_;
+
+    std::uint32_t uniform(std::uint32_t min, std::uint32_t max) {
+        return std::uniform_int_distribution<std::uint32_t>{min, max}(random_);
+    }
+
+    // non-uniform random of the specification, which makes a few customers and items hot
+    std::uint32_t nurand(std::uint32_t a, std::uint32_t c, std::uint32_t min, std::uint32_t max) {
+        return (((uniform(0, a) | uniform(min, max)) + c) % (max - min + 1)) + min;
+    }
+
+    std::uint32_t customer_id() {
+        return nurand(1023, 259, 1, config_.customers);
+    }
+
+    std::uint32_t item_id() {
+        return nurand(8191, 7911, 1, config_.items);
+    }
+
+    std::uint32_t other_warehouse() {
+        if (config_.warehouses == 1) {
+            return home_;
+        }
+        auto w = uniform(1, config_.warehouses - 1);
+        return w >= home_ ? w + 1 : w;
+    }
+
+    template<std::size_t N>
+    void fill(std::array<char, N>& data) {
+        std::uniform_int_distribution<int> chars{'a', 'z'};
+        for (auto& c : data) {
+            c = static_cast<char>(chars(random_));
+        }
+    }
+
+    Procedure choose_procedure() {
+        auto u = std::uniform_real_distribution<double>{}(random_);
+        for (std::size_t i = 0; i < procedure_count; ++i) {
+            u -= procedure_mix[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (u < 0) {
+                return static_cast<Procedure>(i);
+            }
+        }
+        return Procedure::NEW_ORDER;
+    }
+
+    TransactionOptions options(Procedure procedure) const {
+        if (! config_.long_transactions) {
+            return {};
+        }
+        auto preserve = [&](std::initializer_list<Table> tables) {
+            TransactionOptions::WritePreserves ret{};
+            for (auto t : tables) {
+                ret.emplace_back(database_[t]);
+            }
+            return TransactionOptions{TransactionOptions::TransactionType::LONG, std::move(ret)};
+        };
+        switch (procedure) {
+            case Procedure::NEW_ORDER:
+                return preserve({ Table::DISTRICT, Table::CUSTOMER, Table::NEW_ORDER,
+                                  Table::ORDERS, Table::ORDER_LINE, Table::STOCK });
+            case Procedure::PAYMENT:
+                return preserve({ Table::WAREHOUSE, Table::DISTRICT, Table::CUSTOMER, Table::HISTORY });
+            case Procedure::DELIVERY:
+                return preserve({ Table::NEW_ORDER, Table::ORDERS, Table::ORDER_LINE, Table::CUSTOMER });
+            case Procedure::ORDER_STATUS:
+            case Procedure::STOCK_LEVEL:
+                return TransactionOptions{TransactionOptions::TransactionType::READ_ONLY, {}};
+        }
+        std::abort();
+    }
+
+    StatusCode execute(Procedure procedure) {
+        auto opts = options(procedure);
+        HandleHolder<TransactionControlHandle> tch{};
+        check(transaction_begin(database_.handle, opts, &tch.get()), "transaction_begin");
+        if (opts.transaction_type() != TransactionOptions::TransactionType::SHORT) {
+            wait_for_start(tch.get());
+        }
+        TransactionHandle tx{};
+        check(transaction_borrow_handle(tch.get(), &tx), "transaction_borrow_handle");
+        StatusCode rc{};
+        switch (procedure) {
+            case Procedure::NEW_ORDER: rc = new_order(tx); break;
+            case Procedure::PAYMENT: rc = payment(tx); break;
+            case Procedure::ORDER_STATUS: rc = order_status(tx); break;
+            case Procedure::DELIVERY: rc = delivery(tx); break;
+            case Procedure::STOCK_LEVEL: rc = stock_level(tx); break;
+        }
+        if (rc != StatusCode::OK) {
+            transaction_abort(tch.get());
+            return rc;
+        }
+        return commit(tch.get());
+    }
+
+    StatusCode new_order(TransactionHandle tx) {
+        auto w = home_;
+        auto d = uniform(1, districts_per_warehouse);
+        auto c = customer_id();
+        auto ol_cnt = uniform(min_order_lines, max_order_lines);
+        bool rollback = uniform(1, 100) == 1;
+
+        WarehouseRecord warehouse{};
+        if (auto rc = read(tx, database_[Table::WAREHOUSE], make_key(w), warehouse); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto district_key = make_key(w, d);
+        DistrictRecord district{};
+        if (auto rc = read(tx, database_[Table::DISTRICT], district_key, district); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto o = district.next_o_id++;
+        if (auto rc = content_put(tx, database_[Table::DISTRICT], district_key, as_slice(district)); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto customer_key = make_key(w, d, c);
+        CustomerRecord customer{};
+        if (auto rc = read(tx, database_[Table::CUSTOMER], customer_key, customer); rc != StatusCode::OK) {
+            return rc;
+        }
+
+        OrderRecord order{};
+        order.entry_d = now();
+        order.c_id = c;
+        order.ol_cnt = ol_cnt;
+        order.all_local = 1;
+        for (std::uint32_t l = 1; l <= ol_cnt; ++l) {
+            // an unused item number makes 1% of the orders rolled back
+            auto i = (rollback && l == ol_cnt) ? config_.items + 1 : item_id();
+            auto supply_w = uniform(1, 100) == 1 ? other_warehouse() : w;
+            if (supply_w != w) {
+                order.all_local = 0;
+            }
+            auto quantity = uniform(1, 10);
+            ItemRecord item{};
+            if (auto rc = read(tx, database_[Table::ITEM], make_key(i), item); rc == StatusCode::NOT_FOUND) {
+                return StatusCode::USER_ROLLBACK;
+            } else if (rc != StatusCode::OK) {  // NOLINT(readability-else-after-return)
+                return rc;
+            }
+            auto stock_key = make_key(supply_w, i);
+            StockRecord stock{};
+            if (auto rc = read(tx, database_[Table::STOCK], stock_key, stock); rc != StatusCode::OK) {
+                return rc;
+            }
+            stock.quantity = stock.quantity >= quantity + 10 ? stock.quantity - quantity : stock.quantity - quantity + 91;
+            stock.ytd += quantity;
+            ++stock.order_cnt;
+            if (supply_w != w) {
+                ++stock.remote_cnt;
+            }
+            if (auto rc = content_put(tx, database_[Table::STOCK], stock_key, as_slice(stock)); rc != StatusCode::OK) {
+                return rc;
+            }
+            OrderLineRecord line{};
+            line.amount = quantity * item.price * (1.0 + warehouse.tax + district.tax) * (1.0 - customer.discount);
+            line.i_id = i;
+            line.supply_w_id = supply_w;
+            line.quantity = quantity;
+            std::memcpy(line.dist_info.data(), stock.data.data(), line.dist_info.size());
+            if (auto rc = content_put(tx, database_[Table::ORDER_LINE], make_key(w, d, o, l), as_slice(line), PutOperation::CREATE);
+                    rc != StatusCode::OK) {
+                return rc;
+            }
+        }
+        if (auto rc = content_put(tx, database_[Table::ORDERS], make_key(w, d, o), as_slice(order), PutOperation::CREATE);
+                rc != StatusCode::OK) {
+            return rc;
+        }
+        if (auto rc = content_put(tx, database_[Table::NEW_ORDER], make_key(w, d, o), {}, PutOperation::CREATE);
+                rc != StatusCode::OK) {
+            return rc;
+        }
+        customer.last_o_id = o;
+        return content_put(tx, database_[Table::CUSTOMER], customer_key, as_slice(customer));
+    }
+
+    StatusCode payment(TransactionHandle tx) {
+        auto w = home_;
+        auto d = uniform(1, districts_per_warehouse);
+        bool local = uniform(1, 100) <= 85;
+        auto c_w = local ? w : other_warehouse();
+        auto c_d = local ? d : uniform(1, districts_per_warehouse);
+        auto c = customer_id();
+        auto amount = static_cast<double>(uniform(100, 500000)) / 100.0;
+
+        auto warehouse_key = make_key(w);
+        WarehouseRecord warehouse{};
+        if (auto rc = read(tx, database_[Table::WAREHOUSE], warehouse_key, warehouse); rc != StatusCode::OK) {
+            return rc;
+        }
+        warehouse.ytd += amount;
+        if (auto rc = content_put(tx, database_[Table::WAREHOUSE], warehouse_key, as_slice(warehouse)); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto district_key = make_key(w, d);
+        DistrictRecord district{};
+        if (auto rc = read(tx, database_[Table::DISTRICT], district_key, district); rc != StatusCode::OK) {
+            return rc;
+        }
+        district.ytd += amount;
+        if (auto rc = content_put(tx, database_[Table::DISTRICT], district_key, as_slice(district)); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto customer_key = make_key(c_w, c_d, c);
+        CustomerRecord customer{};
+        if (auto rc = read(tx, database_[Table::CUSTOMER], customer_key, customer); rc != StatusCode::OK) {
+            return rc;
+        }
+        customer.balance -= amount;
+        customer.ytd_payment += amount;
+        ++customer.payment_cnt;
+        if (customer.bad_credit != 0) {
+            std::memmove(customer.data.data() + 16, customer.data.data(), customer.data.size() - 16);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy(customer.data.data(), &amount, sizeof(amount));
+        }
+        if (auto rc = content_put(tx, database_[Table::CUSTOMER], customer_key, as_slice(customer)); rc != StatusCode::OK) {
+            return rc;
+        }
+
+        // history keys are taken from a sequence, as SQL engines do for surrogate keys
+        auto id = database_.history_ids.fetch_add(1) + 1;
+        if (auto rc = sequence_put(tx, database_.history_sequence, id, static_cast<SequenceValue>(id)); rc != StatusCode::OK) {
+            return rc;
+        }
+        HistoryRecord history{};
+        history.amount = amount;
+        history.c_w_id = c_w;
+        history.c_d_id = c_d;
+        history.c_id = c;
+        return content_put(tx, database_[Table::HISTORY], make_key(id), as_slice(history), PutOperation::CREATE);
+    }
+
+    StatusCode order_status(TransactionHandle tx) {
+        auto w = home_;
+        auto d = uniform(1, districts_per_warehouse);
+        auto c = customer_id();
+        CustomerRecord customer{};
+        if (auto rc = read(tx, database_[Table::CUSTOMER], make_key(w, d, c), customer); rc != StatusCode::OK) {
+            return rc;
+        }
+        if (customer.last_o_id == 0) {
+            return StatusCode::OK;
+        }
+        OrderRecord order{};
+        if (auto rc = read(tx, database_[Table::ORDERS], make_key(w, d, customer.last_o_id), order); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto prefix = make_key(w, d, customer.last_o_id);
+        return scan(tx, Table::ORDER_LINE, prefix, EndPointKind::PREFIXED_INCLUSIVE, prefix, EndPointKind::PREFIXED_INCLUSIVE, 0,
+            [](Slice, Slice) {});
+    }
+
+    StatusCode delivery(TransactionHandle tx) {
+        auto w = home_;
+        auto carrier = uniform(1, 10);
+        for (std::uint32_t d = 1; d <= districts_per_warehouse; ++d) {
+            // the oldest undelivered order of the district
+            auto prefix = make_key(w, d);
+            std::uint32_t o = 0;
+            if (auto rc = scan(tx, Table::NEW_ORDER, prefix, EndPointKind::PREFIXED_INCLUSIVE, prefix, EndPointKind::PREFIXED_INCLUSIVE, 1,
+                    [&](Slice key, Slice) { o = KeyBuilder::read<std::uint32_t>(key, 8); }); rc != StatusCode::OK) {
+                return rc;
+            }
+            if (o == 0) {
+                continue;
+            }
+            auto order_key = make_key(w, d, o);
+            if (auto rc = content_delete(tx, database_[Table::NEW_ORDER], order_key); rc != StatusCode::OK) {
+                return rc;
+            }
+            OrderRecord order{};
+            if (auto rc = read(tx, database_[Table::ORDERS], order_key, order); rc != StatusCode::OK) {
+                return rc;
+            }
+            order.carrier_id = carrier;
+            if (auto rc = content_put(tx, database_[Table::ORDERS], order_key, as_slice(order)); rc != StatusCode::OK) {
+                return rc;
+            }
+            // collect the lines before updating them, so that the writes never disturb the scan
+            std::vector<std::pair<std::string, OrderLineRecord>> lines{};
+            if (auto rc = scan(tx, Table::ORDER_LINE, order_key, EndPointKind::PREFIXED_INCLUSIVE, order_key, EndPointKind::PREFIXED_INCLUSIVE, 0,
+                    [&](Slice key, Slice value) {
+                        auto& e = lines.emplace_back(key.to_string(), OrderLineRecord{});
+                        std::memcpy(&e.second, value.data(), std::min(value.size(), sizeof(OrderLineRecord)));
+                    }); rc != StatusCode::OK) {
+                return rc;
+            }
+            double total = 0;
+            auto delivery_d = now();
+            for (auto&& [key, line] : lines) {
+                total += line.amount;
+                line.delivery_d = delivery_d;
+                if (auto rc = content_put(tx, database_[Table::ORDER_LINE], key, as_slice(line)); rc != StatusCode::OK) {
+                    return rc;
+                }
+            }
+            auto customer_key = make_key(w, d, order.c_id);
+            CustomerRecord customer{};
+            if (auto rc = read(tx, database_[Table::CUSTOMER], customer_key, customer); rc != StatusCode::OK) {
+                return rc;
+            }
+            customer.balance += total;
+            ++customer.delivery_cnt;
+            if (auto rc = content_put(tx, database_[Table::CUSTOMER], customer_key, as_slice(customer)); rc != StatusCode::OK) {
+                return rc;
+            }
+        }
+        return StatusCode::OK;
+    }
+
+    StatusCode stock_level(TransactionHandle tx) {
+        auto w = home_;
+        auto d = uniform(1, districts_per_warehouse);
+        auto threshold = uniform(10, 20);
+        DistrictRecord district{};
+        if (auto rc = read(tx, database_[Table::DISTRICT], make_key(w, d), district); rc != StatusCode::OK) {
+            return rc;
+        }
+        auto first = district.next_o_id > stock_level_orders ? district.next_o_id - stock_level_orders : 1U;
+        std::set<std::uint32_t> items{};
+        if (auto rc = scan(tx, Table::ORDER_LINE,
+                make_key(w, d, first), EndPointKind::PREFIXED_INCLUSIVE,
+                make_key(w, d, district.next_o_id), EndPointKind::PREFIXED_EXCLUSIVE, 0,
+                [&](Slice, Slice value) {
+                    OrderLineRecord line{};
+                    std::memcpy(&line, value.data(), std::min(value.size(), sizeof(line)));
+                    items.emplace(line.i_id);
+                }); rc != StatusCode::OK) {
+            return rc;
+        }
+        std::size_t low = 0;
+        for (auto i : items) {
+            StockRecord stock{};
+            if (auto rc = read(tx, database_[Table::STOCK], make_key(w, i), stock); rc != StatusCode::OK) {
+                return rc;
+            }
+            if (stock.quantity < threshold) {
+                ++low;
+            }
+        }
+        (void) low;
+        return StatusCode::OK;
+    }
+
+    template<class Consumer>
+    StatusCode scan(
+            TransactionHandle tx,
+            Table table,
+            Slice begin, EndPointKind begin_kind,
+            Slice end, EndPointKind end_kind,
+            std::size_t limit,
+            Consumer&& consumer) {
+        IteratorHandle iter{};
+        if (auto rc = content_scan(tx, database_[table], begin, begin_kind, end, end_kind, &iter, limit); rc != StatusCode::OK) {
+            return rc;
+        }
+        HandleHolder closer { iter };
+        StatusCode rc{};
+        while ((rc = iterator_next(iter)) == StatusCode::OK) {
+            Slice key{};
+            Slice value{};
+            if (rc = iterator_get_key(iter, &key); rc != StatusCode::OK) {
+                return rc;
+            }
+            if (rc = iterator_get_value(iter, &value); rc != StatusCode::OK) {
+                return rc;
+            }
+            consumer(key, value);
+        }
+        return rc == StatusCode::NOT_FOUND ? StatusCode::OK : rc;
+    }
+};
+
+static void usage(char const* program) {
+    std::cerr << "usage: " << program << " [-D<database-attribute-key>=<value>...] [--<option>=<value>...]" << std::endl
+        << "available options:" << std::endl
+        << "    --warehouses=<n>                    number of warehouses (default: 1)" << std::endl
+        << "    --threads=<n>                       number of terminal threads (default: 1)" << std::endl
+        << "    --duration=<seconds>                measurement duration (default: 10)" << std::endl
+        << "    --items=<n>                         number of items (default: 100000)" << std::endl
+        << "    --customers=<n>                     number of customers per district (default: 3000)" << std::endl
+        << "    --orders=<n>                        number of initial orders per district (default: 3000)" << std::endl
+        << "    --transaction-type=short|long       type of the read-write transactions (default: short)" << std::endl
+        << "                                        long also runs the read-only profiles as read_only" << std::endl
+        << "    --seed=<n>                          random seed (default: 0)" << std::endl
+        << "The existing TPC-C storages are deleted and loaded again." << std::endl;
+}
+
+static Config parse(Arguments& arguments) {
+    Config config{};
+    config.warehouses = static_cast<std::uint32_t>(std::max<std::uint64_t>(arguments.integer("warehouses", 1), 1));
+    config.threads = std::max<std::size_t>(arguments.integer("threads", 1), 1);
+    config.duration = arguments.real("duration", 10.0);
+    config.items = static_cast<std::uint32_t>(std::max<std::uint64_t>(arguments.integer("items", 100'000), 1));
+    config.customers = static_cast<std::uint32_t>(std::max<std::uint64_t>(arguments.integer("customers", 3'000), 1));
+    config.orders = static_cast<std::uint32_t>(std::max<std::uint64_t>(arguments.integer("orders", 3'000), 1));
+    auto type = arguments.text("transaction-type", "short");
+    if (type != "short" && type != "long") {
+        throw std::invalid_argument("unknown transaction type: " + type);
+    }
+    config.long_transactions = type == "long";
+    config.seed = arguments.integer("seed", 0);
+    return config;
+}
+
+static void create_storages(Database& database) {
+    for (std::size_t i = 0; i < table_count; ++i) {
+        auto name = table_names[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        StorageHandle existing{};
+        if (auto rc = storage_get(database.handle, name, &existing); rc == StatusCode::OK) {
+            HandleHolder holder { existing };
+            check(storage_delete(existing), "storage_delete");
+        } else if (rc != StatusCode::NOT_FOUND) {
+            check(rc, "storage_get");
+        }
+        check(storage_create(database.handle, name, &database.storages[i]), "storage_create");  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+    check(sequence_create(database.handle, &database.history_sequence), "sequence_create");
+}
+
+static int run(std::vector<char*> const& args) {
+    Arguments arguments{args};
+    if (arguments.flag("help")) {
+        usage(args[0]);
+        return EXIT_SUCCESS;
+    }
+    auto config = parse(arguments);
+    arguments.check_unused();
+
+    Database database{};
+    check(database_open(arguments.database(), &database.handle), "database_open");
+    HandleHolder dbh { database.handle };
+    print_implementation(std::cout);
+    create_storages(database);
+    std::vector<HandleHolder<StorageHandle>> storages{};
+    for (auto s : database.storages) {
+        storages.emplace_back(s);
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers{};
+    for (std::size_t i = 0; i < config.threads; ++i) {
+        workers.emplace_back(std::make_unique<Worker>(database, config, i));
+    }
+    {
+        auto started = Clock::now();
+        std::atomic<std::uint32_t> next_warehouse{1};
+        run_threads(config.threads, [&](std::size_t i) {
+            if (i == 0) {
+                workers[i]->load_items();
+            }
+            for (auto w = next_warehouse.fetch_add(1); w <= config.warehouses; w = next_warehouse.fetch_add(1)) {
+                workers[i]->load_warehouse(w);
+            }
+        });
+        std::cout << "load: warehouses=" << config.warehouses
+            << " elapsed_ms=" << nanos_between(started, Clock::now()) / 1'000'000 << std::endl;
+    }
+
+    std::atomic_bool stop{false};
+    std::vector<Statistics> results(config.threads);
+    auto started = Clock::now();
+    std::thread timer{[&] {
+        std::this_thread::sleep_for(std::chrono::duration<double>{config.duration});
+        stop.store(true, std::memory_order_relaxed);
+    }};
+    run_threads(config.threads, [&](std::size_t i) {
+        results[i] = workers[i]->run(stop);
+    });
+    auto elapsed = static_cast<double>(nanos_between(started, Clock::now())) / 1e9;
+    timer.join();
+
+    Statistics total{};
+    for (auto&& r : results) {
+        total.merge(r);
+    }
+    std::uint64_t committed = std::accumulate(total.committed.begin(), total.committed.end(), std::uint64_t{});
+    std::uint64_t aborted = std::accumulate(total.aborted.begin(), total.aborted.end(), std::uint64_t{});
+    auto new_orders = total.committed[static_cast<std::size_t>(Procedure::NEW_ORDER)];
+    std::cout << std::fixed << std::setprecision(3)
+        << "tpcc: warehouses=" << config.warehouses
+        << " threads=" << config.threads
+        << " transaction_type=" << (config.long_transactions ? "long" : "short") << std::endl
+        << "elapsed_s=" << elapsed << std::endl
+        << "transactions: committed=" << committed
+        << " aborted=" << aborted
+        << " abort_rate=" << (committed + aborted == 0 ? 0.0 : static_cast<double>(aborted) / static_cast<double>(committed + aborted))
+        << " throughput_tps=" << static_cast<double>(committed) / elapsed
+        << " tpmC=" << static_cast<double>(new_orders) * 60.0 / elapsed << std::endl;
+    for (std::size_t i = 0; i < procedure_count; ++i) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        auto procedure = static_cast<Procedure>(i);
+        std::cout << to_string_view(procedure) << ": committed=" << total.committed[i]
+            << " aborted=" << total.aborted[i]
+            << " rolled_back=" << total.rolled_back[i] << std::endl;
+        print_latency(std::cout, to_string_view(procedure), total.latency[i]);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+    if (arguments.database().attribute("perf").has_value()) {
+        MetricsSnapshot metrics{};
+        if (database_get_metrics(database.handle, metrics) == StatusCode::OK) {
+            std::cout << "metrics:" << std::endl << metrics;
+        }
+    }
+    std::vector<HotKey> hot_keys{};
+    if (database_get_hot_keys(database.handle, hot_keys) == StatusCode::OK && ! hot_keys.empty()) {
+        std::cout << "hot keys:" << std::endl;
+        for (auto&& k : hot_keys) {
+            std::cout << k << std::endl;
+        }
+    }
+    check(database_close(database.handle), "database_close");
+    return EXIT_SUCCESS;
+}
+
+}  // namespace sharksfin::bench
+
+extern "C" int main(int argc, char* argv[]) {
+    sharksfin::Environment env{};
+    env.initialize();
+    try {
+        return sharksfin::bench::run(std::vector<char*> { argv, argv + argc });  // NOLINT
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,473 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arguments.h"
+#include "Generators.h"
+#include "Report.h"
+#include "Support.h"
+
+#include "sharksfin/api.h"
+#include "sharksfin/HandleHolder.h"
+#include "sharksfin/Environment.h"
+
+namespace sharksfin::bench {
+
+/**
+ * @brief the kind of YCSB operations.
+ */
+enum class Operation : std::size_t {
+    READ = 0,
+    UPDATE,
+    INSERT,
+    SCAN,
+    READ_MODIFY_WRITE,
+};
+
+static constexpr std::size_t operation_count = static_cast<std::size_t>(Operation::READ_MODIFY_WRITE) + 1;
+
+static constexpr std::string_view to_string_view(Operation value) {
+    switch (value) {
+        case Operation::READ: return "READ";
+        case Operation::UPDATE: return "UPDATE";
+        case Operation::INSERT: return "INSERT";
+        case Operation::SCAN: return "SCAN";
+        case Operation::READ_MODIFY_WRITE: return "READ_MODIFY_WRITE";
+    }
+    std::abort();
+}
+
+/**
+ * @brief the operation mix of the YCSB core workloads.
+ */
+struct Workload {
+    std::string_view name;
+    std::array<double, operation_count> proportions;
+    Distribution distribution;
+};
+
+static constexpr std::array<Workload, 6> workloads {{
+    { "A", { 0.50, 0.50, 0.00, 0.00, 0.00 }, Distribution::ZIPFIAN },  // update heavy
+    { "B", { 0.95, 0.05, 0.00, 0.00, 0.00 }, Distribution::ZIPFIAN },  // read mostly
+    { "C", { 1.00, 0.00, 0.00, 0.00, 0.00 }, Distribution::ZIPFIAN },  // read only
+    { "D", { 0.95, 0.00, 0.05, 0.00, 0.00 }, Distribution::LATEST },  // read latest
+    { "E", { 0.00, 0.00, 0.05, 0.95, 0.00 }, Distribution::ZIPFIAN },  // short ranges
+    { "F", { 0.50, 0.00, 0.00, 0.00, 0.50 }, Distribution::ZIPFIAN },  // read-modify-write
+}};
+
+static constexpr std::string_view storage_name = "ycsb";
+static constexpr std::size_t load_batch_size = 1000;
+
+struct Config {
+    Workload workload{};
+    std::uint64_t records{};
+    std::size_t threads{};
+    double duration{};
+    Distribution distribution{};
+    Distribution value_distribution{};
+    std::size_t value_min{};
+    std::size_t value_max{};
+    TransactionOptions::TransactionType transaction_type{};
+    std::size_t operations{};
+    std::size_t scan_length{};
+    std::uint64_t seed{};
+};
+
+struct Statistics {
+    std::uint64_t committed{};
+    std::uint64_t aborted{};
+    std::uint64_t not_found{};
+    LatencyHistogram transaction{};
+    std::array<LatencyHistogram, operation_count> operations{};
+
+    void merge(Statistics const& other) {
+        committed += other.committed;
+        aborted += other.aborted;
+        not_found += other.not_found;
+        transaction.merge(other.transaction);
+        for (std::size_t i = 0; i < operation_count; ++i) {
+            operations[i].merge(other.operations[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+};
+
+static std::string make_key(std::uint64_t item) {
+    std::array<char, 21> buf{};
+    std::snprintf(buf.data(), buf.size(), "user%016llx", static_cast<unsigned long long>(fnv_hash(item)));  // NOLINT
+    return std::string{buf.data()};
+}
+
+static bool succeeded(StatusCode rc) noexcept {
+    return rc == StatusCode::OK || rc == StatusCode::NOT_FOUND || rc == StatusCode::ALREADY_EXISTS;
+}
+
+class Worker {
+public:
+    Worker(DatabaseHandle database, StorageHandle storage, Config const& config, std::size_t index) :
+        database_(database),
+        storage_(storage),
+        config_(config),
+        random_(config.seed + index),
+        chooser_(config.distribution, config.records),
+        sizes_(config.value_distribution, config.value_min, config.value_max),
+        options_(config.transaction_type, write_preserves(config, storage))
+    {
+        // values are taken from random offsets of this pool
+        pool_.resize(sizes_.max() * 2 + 1);
+        std::uniform_int_distribution<int> chars{'a', 'z'};
+        for (auto& c : pool_) {
+            c = static_cast<char>(chars(random_));
+        }
+    }
+
+    void load(std::uint64_t begin, std::uint64_t end) {
+        for (auto batch = begin; batch < end; batch += load_batch_size) {
+            auto last = std::min(end, batch + load_batch_size);
+            while (true) {
+                HandleHolder<TransactionControlHandle> tch{};
+                check(transaction_begin(database_, {}, &tch.get()), "transaction_begin");
+                TransactionHandle tx{};
+                check(transaction_borrow_handle(tch.get(), &tx), "transaction_borrow_handle");
+                StatusCode rc{};
+                for (auto item = batch; item < last && rc == StatusCode::OK; ++item) {
+                    rc = content_put(tx, storage_, make_key(item), value());
+                }
+                if (rc == StatusCode::OK) {
+                    rc = transaction_commit(tch.get());
+                } else {
+                    transaction_abort(tch.get());
+                }
+                if (rc == StatusCode::OK) {
+                    break;
+                }
+                if (rc != StatusCode::ERR_ABORTED && rc != StatusCode::ERR_ABORTED_RETRYABLE) {
+                    check(rc, "loading records");
+                }
+            }
+        }
+    }
+
+    Statistics run(std::atomic<std::uint64_t>& items, std::atomic_bool const& stop) {
+        Statistics stats{};
+        while (! stop.load(std::memory_order_relaxed)) {
+            auto started = Clock::now();
+            HandleHolder<TransactionControlHandle> tch{};
+            check(transaction_begin(database_, options_, &tch.get()), "transaction_begin");
+            if (config_.transaction_type == TransactionOptions::TransactionType::LONG) {
+                wait_for_start(tch.get());
+            }
+            TransactionHandle tx{};
+            check(transaction_borrow_handle(tch.get(), &tx), "transaction_borrow_handle");
+            bool ok = true;
+            for (std::size_t i = 0; i < config_.operations && ok; ++i) {
+                auto op = choose_operation();
+                auto op_started = Clock::now();
+                auto rc = execute(op, tx, items);
+                stats.operations[static_cast<std::size_t>(op)].add(nanos_between(op_started, Clock::now()));  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                if (rc == StatusCode::NOT_FOUND) {
+                    ++stats.not_found;
+                }
+                ok = succeeded(rc);
+            }
+            if (ok) {
+                ok = transaction_commit(tch.get()) == StatusCode::OK;
+            } else {
+                transaction_abort(tch.get());
+            }
+            if (ok) {
+                ++stats.committed;
+                stats.transaction.add(nanos_between(started, Clock::now()));
+            } else {
+                ++stats.aborted;
+            }
+        }
+        return stats;
+    }
+
+private:
+    DatabaseHandle database_;
+    StorageHandle storage_;
+    Config const& config_;
+    Random random_;
+    ItemChooser chooser_;
+    SizeChooser sizes_;
+    TransactionOptions options_;
+    std::string pool_{};
+    std::string buffer_{};
+
+    static TransactionOptions::WritePreserves write_preserves(Config const& config, StorageHandle storage) {
+        if (config.transaction_type != TransactionOptions::TransactionType::LONG) {
+            return {};
+        }
+        return { TableArea{storage} };
+    }
+
+    Slice value() {
+        auto size = sizes_(random_);
+        auto offset = std::uniform_int_distribution<std::size_t>{0, pool_.size() - size}(random_);
+        return Slice{pool_.data() + offset, size};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    Operation choose_operation() {
+        auto u = std::uniform_real_distribution<double>{}(random_);
+        auto&& proportions = config_.workload.proportions;
+        for (std::size_t i = 0; i < operation_count; ++i) {
+            u -= proportions[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (u < 0) {
+                return static_cast<Operation>(i);
+            }
+        }
+        // rounding errors
+        for (std::size_t i = operation_count; i > 0; --i) {
+            if (proportions[i - 1] > 0) {  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                return static_cast<Operation>(i - 1);
+            }
+        }
+        return Operation::READ;
+    }
+
+    StatusCode execute(Operation op, TransactionHandle tx, std::atomic<std::uint64_t>& items) {
+        switch (op) {
+            case Operation::READ: {
+                Slice result{};
+                return content_get(tx, storage_, make_key(chooser_(random_, items.load())), &result);
+            }
+            case Operation::UPDATE:
+                return content_put(tx, storage_, make_key(chooser_(random_, items.load())), value(), PutOperation::UPDATE);
+            case Operation::INSERT:
+                return content_put(tx, storage_, make_key(items.fetch_add(1)), value(), PutOperation::CREATE);
+            case Operation::SCAN: {
+                auto length = std::uniform_int_distribution<std::size_t>{1, config_.scan_length}(random_);
+                IteratorHandle iter{};
+                auto rc = content_scan(
+                    tx, storage_,
+                    make_key(chooser_(random_, items.load())), EndPointKind::INCLUSIVE,
+                    {}, EndPointKind::UNBOUND,
+                    &iter, length);
+                if (rc != StatusCode::OK) {
+                    return rc;
+                }
+                HandleHolder closer { iter };
+                // the limit is only a hint for the engines (e.g. memory ignores it), so that stop after the rows here
+                for (std::size_t rows = 0; rows < length; ++rows) {
+                    if (rc = iterator_next(iter); rc != StatusCode::OK) {
+                        return rc == StatusCode::NOT_FOUND ? StatusCode::OK : rc;
+                    }
+                    Slice v{};
+                    if (rc = iterator_get_value(iter, &v); ! succeeded(rc)) {
+                        return rc;
+                    }
+                }
+                return StatusCode::OK;
+            }
+            case Operation::READ_MODIFY_WRITE: {
+                auto key = make_key(chooser_(random_, items.load()));
+                Slice result{};
+                if (auto rc = content_get(tx, storage_, key, &result); rc != StatusCode::OK) {
+                    return rc;
+                }
+                return content_put(tx, storage_, key, value(), PutOperation::UPDATE);
+            }
+        }
+        std::abort();
+    }
+};
+
+static void usage(char const* program) {
+    std::cerr << "usage: " << program << " [-D<database-attribute-key>=<value>...] [--<option>=<value>...]" << std::endl
+        << "available options:" << std::endl
+        << "    --workload=a|b|c|d|e|f              YCSB core workload (default: a)" << std::endl
+        << "    --records=<n>                       number of initial records (default: 100000)" << std::endl
+        << "    --threads=<n>                       number of client threads (default: 1)" << std::endl
+        << "    --duration=<seconds>                measurement duration (default: 10)" << std::endl
+        << "    --distribution=uniform|zipfian|latest" << std::endl
+        << "                                        key distribution (default: workload specific)" << std::endl
+        << "    --value-size=<n>                    min value size in bytes (default: 100)" << std::endl
+        << "    --value-size-max=<n>                max value size in bytes (default: value-size)" << std::endl
+        << "    --value-size-distribution=uniform|zipfian" << std::endl
+        << "                                        value size distribution (default: uniform)" << std::endl
+        << "    --transaction-type=short|long|read_only" << std::endl
+        << "                                        transaction type (default: short)" << std::endl
+        << "    --operations=<n>                    operations per transaction (default: 1)" << std::endl
+        << "    --scan-length=<n>                   max scan length of workload E (default: 100)" << std::endl
+        << "    --seed=<n>                          random seed (default: 0)" << std::endl
+        << "The records are loaded into storage \"" << storage_name << "\" only if it does not exist." << std::endl;
+}
+
+static Workload parse_workload(std::string name) {
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::toupper(c); });
+    for (auto&& w : workloads) {
+        if (w.name == name) {
+            return w;
+        }
+    }
+    throw std::invalid_argument("unknown workload: " + name);
+}
+
+static TransactionOptions::TransactionType parse_transaction_type(std::string_view name) {
+    if (name == "short") {
+        return TransactionOptions::TransactionType::SHORT;
+    }
+    if (name == "long") {
+        return TransactionOptions::TransactionType::LONG;
+    }
+    if (name == "read_only") {
+        return TransactionOptions::TransactionType::READ_ONLY;
+    }
+    throw std::invalid_argument("unknown transaction type: " + std::string{name});
+}
+
+static Config parse(Arguments& arguments) {
+    Config config{};
+    config.workload = parse_workload(arguments.text("workload", "a"));
+    config.records = std::max<std::uint64_t>(arguments.integer("records", 100'000), 1);
+    config.threads = std::max<std::size_t>(arguments.integer("threads", 1), 1);
+    config.duration = arguments.real("duration", 10.0);
+    config.distribution = arguments.has("distribution")
+        ? parse_distribution(arguments.text("distribution", {}))
+        : config.workload.distribution;
+    config.value_min = arguments.integer("value-size", 100);
+    config.value_max = std::max<std::size_t>(arguments.integer("value-size-max", config.value_min), config.value_min);
+    config.value_distribution = parse_distribution(arguments.text("value-size-distribution", "uniform"));
+    config.transaction_type = parse_transaction_type(arguments.text("transaction-type", "short"));
+    config.operations = std::max<std::size_t>(arguments.integer("operations", 1), 1);
+    config.scan_length = std::max<std::size_t>(arguments.integer("scan-length", 100), 1);
+    config.seed = arguments.integer("seed", 0);
+    if (config.transaction_type == TransactionOptions::TransactionType::READ_ONLY
+            && config.workload.name != "C") {
+        throw std::invalid_argument("read_only transactions are only available for workload C");
+    }
+    return config;
+}
+
+static int run(std::vector<char*> const& args) {
+    Arguments arguments{args};
+    if (arguments.flag("help")) {
+        usage(args[0]);
+        return EXIT_SUCCESS;
+    }
+    auto config = parse(arguments);
+    arguments.check_unused();
+
+    DatabaseHandle db{};
+    check(database_open(arguments.database(), &db), "database_open");
+    HandleHolder dbh { db };
+    print_implementation(std::cout);
+
+    StorageHandle storage{};
+    bool load = false;
+    if (auto rc = storage_get(db, storage_name, &storage); rc == StatusCode::NOT_FOUND) {
+        check(storage_create(db, storage_name, &storage), "storage_create");
+        load = true;
+    } else {
+        check(rc, "storage_get");
+        std::cout << "reusing the existing storage " << storage_name << std::endl;
+    }
+    HandleHolder sth { storage };
+
+    std::vector<std::unique_ptr<Worker>> workers{};
+    for (std::size_t i = 0; i < config.threads; ++i) {
+        workers.emplace_back(std::make_unique<Worker>(db, storage, config, i));
+    }
+    if (load) {
+        auto started = Clock::now();
+        run_threads(config.threads, [&](std::size_t i) {
+            auto per_thread = (config.records + config.threads - 1) / config.threads;
+            auto begin = std::min(config.records, per_thread * i);
+            auto end = std::min(config.records, begin + per_thread);
+            workers[i]->load(begin, end);
+        });
+        std::cout << "load: records=" << config.records
+            << " elapsed_ms=" << nanos_between(started, Clock::now()) / 1'000'000 << std::endl;
+    }
+
+    std::atomic<std::uint64_t> items{config.records};
+    std::atomic_bool stop{false};
+    std::vector<Statistics> results(config.threads);
+    auto started = Clock::now();
+    std::thread timer{[&] {
+        std::this_thread::sleep_for(std::chrono::duration<double>{config.duration});
+        stop.store(true, std::memory_order_relaxed);
+    }};
+    run_threads(config.threads, [&](std::size_t i) {
+        results[i] = workers[i]->run(items, stop);
+    });
+    auto elapsed = static_cast<double>(nanos_between(started, Clock::now())) / 1e9;
+    timer.join();
+
+    Statistics total{};
+    for (auto&& r : results) {
+        total.merge(r);
+    }
+    std::uint64_t operations = 0;
+    for (auto&& h : total.operations) {
+        operations += h.count();
+    }
+    auto finished = total.committed + total.aborted;
+    std::cout << std::fixed << std::setprecision(3)
+        << "workload: " << config.workload.name
+        << " records=" << config.records
+        << " threads=" << config.threads
+        << " transaction_type=" << config.transaction_type
+        << " operations_per_transaction=" << config.operations << std::endl
+        << "elapsed_s=" << elapsed << std::endl
+        << "transactions: committed=" << total.committed
+        << " aborted=" << total.aborted
+        << " abort_rate=" << (finished == 0 ? 0.0 : static_cast<double>(total.aborted) / static_cast<double>(finished))
+        << " throughput_tps=" << static_cast<double>(total.committed) / elapsed << std::endl
+        << "operations: count=" << operations
+        << " not_found=" << total.not_found
+        << " throughput_ops=" << static_cast<double>(operations) / elapsed << std::endl;
+    print_latency(std::cout, "TRANSACTION", total.transaction);
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        if (total.operations[i].count() > 0) {  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            print_latency(std::cout, to_string_view(static_cast<Operation>(i)), total.operations[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+    if (arguments.database().attribute("perf").has_value()) {
+        MetricsSnapshot metrics{};
+        if (database_get_metrics(db, metrics) == StatusCode::OK) {
+            std::cout << "metrics:" << std::endl << metrics;
+        }
+    }
+    check(database_close(db), "database_close");
+    return EXIT_SUCCESS;
+}
+
+}  // namespace sharksfin::bench
+
+extern "C" int main(int argc, char* argv[]) {
+    sharksfin::Environment env{};
+    env.initialize();
+    try {
+        return sharksfin::bench::run(std::vector<char*> { argv, argv + argc });  // NOLINT
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
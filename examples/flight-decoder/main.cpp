@@ -0,0 +1,51 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "flight_recorder.h"
+
+namespace sharksfin::flight_decoder {
+
+static int run(std::vector<char*> const& args) {
+    if (args.size() <= 1U) {
+        std::cerr << "usage: " << args[0] << " <dump-file>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    int ret = EXIT_SUCCESS;
+    for (std::size_t i = 1, n = args.size(); i < n; ++i) {
+        std::ifstream in{args[i], std::ios::binary};
+        if (! in) {
+            std::cerr << "cannot open " << args[i] << std::endl;
+            ret = EXIT_FAILURE;
+            continue;
+        }
+        std::cout << args[i] << ":" << std::endl;
+        if (! common::flight_recorder::decode(in, std::cout)) {
+            std::cerr << "malformed flight recorder dump: " << args[i] << std::endl;
+            ret = EXIT_FAILURE;
+        }
+    }
+    return ret;
+}
+
+}  // namespace sharksfin::flight_decoder
+
+extern "C" int main(int argc, char* argv[]) {
+    return sharksfin::flight_decoder::run(std::vector<char*> { argv, argv + argc });  // NOLINT
+}
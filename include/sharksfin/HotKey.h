@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_HOT_KEY_H_
+#define SHARKSFIN_HOT_KEY_H_
+
+#include <cctype>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "ErrorCode.h"
+
+namespace sharksfin {
+
+/**
+ * @brief a key which frequently caused transaction failures.
+ */
+struct HotKey {
+
+    /**
+     * @brief the storage name where the key exists, or empty if it is not available.
+     */
+    std::string storage{};
+
+    /**
+     * @brief the failure reason.
+     */
+    ErrorCode reason{};
+
+    /**
+     * @brief the key which caused the failures, or empty if it is not available.
+     * @details long keys are truncated.
+     */
+    std::string key{};
+
+    /**
+     * @brief the estimated number of failures caused by the key.
+     * @details the estimation never underestimates, and overestimates at most by a small fraction of the total
+     * number of failures recorded for the same storage and reason.
+     */
+    std::uint64_t count{};
+};
+
+/**
+ * @brief appends the hot key into the given stream.
+ * @details non-printable bytes of the key are escaped as "\xNN".
+ * @param out the target stream
+ * @param value the source hot key
+ * @return the target stream
+ */
+inline std::ostream& operator<<(std::ostream& out, HotKey const& value) {
+    out << "storage=" << value.storage << " reason=" << value.reason << " key=";
+    std::ios init(nullptr);
+    init.copyfmt(out);
+    for (auto c : value.key) {
+        auto b = static_cast<unsigned char>(c);
+        if (std::isprint(b) != 0) {
+            out << c;
+        } else {
+            out << "\\x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<std::uint32_t>(b);
+            out.copyfmt(init);
+        }
+    }
+    return out << " count=" << value.count;
+}
+
+}  // namespace sharksfin
+
+#endif  // SHARKSFIN_HOT_KEY_H_
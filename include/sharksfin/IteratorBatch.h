@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_ITERATORBATCH_H_
+#define SHARKSFIN_ITERATORBATCH_H_
+
+#include <cstddef>
+
+#include "Slice.h"
+
+namespace sharksfin {
+
+/**
+ * @brief an entry of the rows fetched by iterator_next_batch().
+ * @details the offsets are relative to the beginning of IteratorBatch::data.
+ */
+struct IteratorBatchEntry {
+
+    /**
+     * @brief the offset of the key.
+     */
+    std::size_t key_offset;
+
+    /**
+     * @brief the length of the key.
+     */
+    std::size_t key_length;
+
+    /**
+     * @brief the offset of the value.
+     */
+    std::size_t value_offset;
+
+    /**
+     * @brief the length of the value.
+     */
+    std::size_t value_length;
+};
+
+/**
+ * @brief the caller provided buffer which receives rows from iterator_next_batch().
+ * @details the caller owns both of entries and data, and iterator_next_batch() only fills them.
+ */
+struct IteratorBatch {
+
+    /**
+     * @brief the entry buffer, which must have room for max_rows entries.
+     */
+    IteratorBatchEntry* entries;
+
+    /**
+     * @brief the data buffer, which must have room for max_bytes bytes.
+     */
+    char* data;
+
+    /**
+     * @brief [OUT] the number of rows written into entries.
+     */
+    std::size_t row_count;
+
+    /**
+     * @brief [OUT] the number of bytes written into data.
+     */
+    std::size_t data_size;
+
+    /**
+     * @brief returns the key of the row.
+     * @param index the row index, must be less than row_count
+     * @return the key
+     */
+    [[nodiscard]] Slice key(std::size_t index) const noexcept {
+        auto& e = entries[index];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return {data + e.key_offset, e.key_length};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief returns the value of the row.
+     * @param index the row index, must be less than row_count
+     * @return the value
+     */
+    [[nodiscard]] Slice value(std::size_t index) const noexcept {
+        auto& e = entries[index];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return {data + e.value_offset, e.value_length};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+};
+
+}  // namespace sharksfin
+
+#endif  // SHARKSFIN_ITERATORBATCH_H_
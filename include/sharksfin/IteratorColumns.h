@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_ITERATORCOLUMNS_H_
+#define SHARKSFIN_ITERATORCOLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Slice.h"
+
+namespace sharksfin {
+
+/**
+ * @brief the caller provided column buffers which receive rows from iterator_next_columns().
+ * @details keys and values are stored separately in the layout of Apache Arrow variable-size binary
+ * (large binary) column: the offsets array of row_count + 1 elements and the contiguous data buffer, so that the
+ * i-th element occupies [offsets[i], offsets[i + 1]) of the data buffer.
+ * The caller owns all buffers, and iterator_next_columns() only fills them.
+ */
+struct IteratorColumns {
+
+    /**
+     * @brief the key offsets, which must have room for max_rows + 1 elements.
+     */
+    std::int64_t* key_offsets;
+
+    /**
+     * @brief the key data buffer.
+     */
+    char* key_data;
+
+    /**
+     * @brief the capacity of key_data in bytes.
+     */
+    std::size_t key_data_capacity;
+
+    /**
+     * @brief the value offsets, which must have room for max_rows + 1 elements.
+     */
+    std::int64_t* value_offsets;
+
+    /**
+     * @brief the value data buffer.
+     */
+    char* value_data;
+
+    /**
+     * @brief the capacity of value_data in bytes.
+     */
+    std::size_t value_data_capacity;
+
+    /**
+     * @brief [OUT] the number of rows written into the columns.
+     */
+    std::size_t row_count;
+
+    /**
+     * @brief returns the key of the row.
+     * @param index the row index, must be less than row_count
+     * @return the key
+     */
+    [[nodiscard]] Slice key(std::size_t index) const noexcept {
+        return element(key_offsets, key_data, index);
+    }
+
+    /**
+     * @brief returns the value of the row.
+     * @param index the row index, must be less than row_count
+     * @return the value
+     */
+    [[nodiscard]] Slice value(std::size_t index) const noexcept {
+        return element(value_offsets, value_data, index);
+    }
+
+private:
+    static Slice element(std::int64_t const* offsets, char const* data, std::size_t index) noexcept {
+        auto begin = offsets[index];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto end = offsets[index + 1];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return {data + begin, static_cast<std::size_t>(end - begin)};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+};
+
+}  // namespace sharksfin
+
+#endif  // SHARKSFIN_ITERATORCOLUMNS_H_
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_METRICS_H_
+#define SHARKSFIN_METRICS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "ErrorCode.h"
+#include "TransactionInfo.h"
+
+namespace sharksfin {
+
+/**
+ * @brief represents the kind of operations tracked by the metrics.
+ */
+enum class MetricsOperation : std::size_t {
+
+    /**
+     * @brief transaction begin
+     */
+    BEGIN = 0,
+
+    /**
+     * @brief point read of an entry
+     */
+    GET,
+
+    /**
+     * @brief write of an entry
+     */
+    PUT,
+
+    /**
+     * @brief deletion of an entry
+     */
+    DELETE,
+
+    /**
+     * @brief opening a scan
+     */
+    SCAN_OPEN,
+
+    /**
+     * @brief advancing an iterator
+     */
+    NEXT,
+
+    /**
+     * @brief transaction commit
+     */
+    COMMIT,
+
+    /**
+     * @brief transaction abort requested by the client
+     */
+    ABORT,
+
+    /**
+     * @brief waiting for the committed transaction to become durable
+     */
+    DURABLE_WAIT,
+};
+
+/**
+ * @brief the number of MetricsOperation members.
+ */
+static constexpr std::size_t metrics_operation_count = static_cast<std::size_t>(MetricsOperation::DURABLE_WAIT) + 1;
+
+/**
+ * @brief returns the label of the given enum value.
+ * @param value the enum value
+ * @return the corresponded label
+ */
+inline constexpr std::string_view to_string_view(MetricsOperation value) {
+    switch (value) {
+        case MetricsOperation::BEGIN: return "BEGIN";
+        case MetricsOperation::GET: return "GET";
+        case MetricsOperation::PUT: return "PUT";
+        case MetricsOperation::DELETE: return "DELETE";
+        case MetricsOperation::SCAN_OPEN: return "SCAN_OPEN";
+        case MetricsOperation::NEXT: return "NEXT";
+        case MetricsOperation::COMMIT: return "COMMIT";
+        case MetricsOperation::ABORT: return "ABORT";
+        case MetricsOperation::DURABLE_WAIT: return "DURABLE_WAIT";
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends enum label into the given stream.
+ * @param out the target stream
+ * @param value the source enum value
+ * @return the target stream
+ */
+inline std::ostream& operator<<(std::ostream& out, MetricsOperation value) {
+    return out << to_string_view(value);
+}
+
+/**
+ * @brief a histogram of latencies in nanoseconds.
+ * @details the values are counted into log-linear buckets like HDR histogram: each power of two range is divided into
+ * sub_bucket_count buckets, so that the relative error of the reported values is at most 1/sub_bucket_count.
+ * The values larger than max_value are counted into the last bucket.
+ */
+class LatencyHistogram final {
+public:
+    /**
+     * @brief the number of bits to divide each power of two range.
+     */
+    static constexpr std::size_t sub_bucket_bits = 3;
+
+    /**
+     * @brief the number of buckets in each power of two range.
+     */
+    static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+
+    /**
+     * @brief the most significant bit position of the largest trackable value (about 39 hours in nanoseconds).
+     */
+    static constexpr std::size_t max_magnitude = 47;
+
+    /**
+     * @brief the total number of buckets.
+     */
+    static constexpr std::size_t bucket_count = sub_bucket_count * (max_magnitude - sub_bucket_bits + 2);
+
+    /**
+     * @brief the largest trackable value.
+     */
+    static constexpr std::uint64_t max_value = (std::uint64_t{1} << (max_magnitude + 1)) - 1;
+
+    /**
+     * @brief returns the bucket index for the given value.
+     * @param value the value in nanoseconds
+     * @return the bucket index
+     */
+    static constexpr std::size_t bucket_index(std::uint64_t value) noexcept {
+        value = std::min(value, max_value);
+        if (value < sub_bucket_count) {
+            return static_cast<std::size_t>(value);
+        }
+        std::size_t magnitude = 63U - static_cast<std::size_t>(__builtin_clzll(value));
+        std::size_t shift = magnitude - sub_bucket_bits;
+        auto sub = static_cast<std::size_t>(value >> shift) & (sub_bucket_count - 1);
+        return sub_bucket_count * (shift + 1) + sub;
+    }
+
+    /**
+     * @brief returns the smallest value counted into the bucket.
+     * @param index the bucket index
+     * @return the lower bound of the bucket
+     */
+    static constexpr std::uint64_t bucket_lower_bound(std::size_t index) noexcept {
+        if (index < sub_bucket_count) {
+            return index;
+        }
+        std::size_t shift = index / sub_bucket_count - 1;
+        std::uint64_t sub = index % sub_bucket_count;
+        return (sub_bucket_count + sub) << shift;
+    }
+
+    /**
+     * @brief returns the largest value counted into the bucket.
+     * @param index the bucket index
+     * @return the upper bound of the bucket
+     */
+    static constexpr std::uint64_t bucket_upper_bound(std::size_t index) noexcept {
+        if (index + 1 >= bucket_count) {
+            return max_value;
+        }
+        return bucket_lower_bound(index + 1) - 1;
+    }
+
+    /**
+     * @brief adds a value to this histogram.
+     * @param value the value in nanoseconds
+     * @param count the number of occurrences
+     */
+    void add(std::uint64_t value, std::uint64_t count = 1) noexcept {
+        add_bucket(bucket_index(value), count);
+        total_ += value * count;
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * @brief adds occurrences into the bucket.
+     * @details this does not update total() and max().
+     * @param index the bucket index
+     * @param count the number of occurrences
+     */
+    void add_bucket(std::size_t index, std::uint64_t count) noexcept {
+        buckets_[index] += count;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        count_ += count;
+    }
+
+    /**
+     * @brief adds the statistics which are not kept in buckets.
+     * @param total the sum of values
+     * @param max the max value
+     */
+    void add_summary(std::uint64_t total, std::uint64_t max) noexcept {
+        total_ += total;
+        max_ = std::max(max_, max);
+    }
+
+    /**
+     * @brief merges the other histogram into this.
+     * @param other the source histogram
+     */
+    void merge(LatencyHistogram const& other) noexcept {
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            buckets_[i] += other.buckets_[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        count_ += other.count_;
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    /**
+     * @brief returns the number of recorded values.
+     * @return the number of values
+     */
+    [[nodiscard]] std::uint64_t count() const noexcept {
+        return count_;
+    }
+
+    /**
+     * @brief returns the sum of recorded values.
+     * @return the sum in nanoseconds
+     */
+    [[nodiscard]] std::uint64_t total() const noexcept {
+        return total_;
+    }
+
+    /**
+     * @brief returns the max recorded value.
+     * @return the max value in nanoseconds, or 0 if this is empty
+     */
+    [[nodiscard]] std::uint64_t max() const noexcept {
+        return max_;
+    }
+
+    /**
+     * @brief returns the mean of recorded values.
+     * @return the mean in nanoseconds, or 0 if this is empty
+     */
+    [[nodiscard]] std::uint64_t mean() const noexcept {
+        return count_ == 0 ? 0 : total_ / count_;
+    }
+
+    /**
+     * @brief returns the number of values counted into the bucket.
+     * @param index the bucket index
+     * @return the number of values
+     */
+    [[nodiscard]] std::uint64_t bucket(std::size_t index) const noexcept {
+        return buckets_[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    /**
+     * @brief returns the value at the given percentile.
+     * @param percentile the percentile in [0, 100]
+     * @return the upper bound of the bucket which contains the percentile, or 0 if this is empty
+     */
+    [[nodiscard]] std::uint64_t percentile(double percentile) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+        auto rank = static_cast<std::uint64_t>(static_cast<double>(count_) * std::clamp(percentile, 0.0, 100.0) / 100.0);
+        rank = std::clamp(rank, std::uint64_t{1}, count_);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += buckets_[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (seen >= rank) {
+                return std::min(bucket_upper_bound(i), max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    std::array<std::uint64_t, bucket_count> buckets_{};
+    std::uint64_t count_{};
+    std::uint64_t total_{};
+    std::uint64_t max_{};
+};
+
+/**
+ * @brief the operation counters of a storage.
+ */
+struct StorageMetrics {
+
+    /**
+     * @brief the number of point reads.
+     */
+    std::uint64_t get_count{};
+
+    /**
+     * @brief the number of writes.
+     */
+    std::uint64_t put_count{};
+
+    /**
+     * @brief the number of deletions.
+     */
+    std::uint64_t delete_count{};
+
+    /**
+     * @brief the number of opened scans.
+     */
+    std::uint64_t scan_count{};
+};
+
+/**
+ * @brief a snapshot of the metrics collected by a database.
+ * @details the metrics are collected only if the database was opened with the performance tracking attribute ("perf").
+ */
+struct MetricsSnapshot {
+
+    /**
+     * @brief the operation statistics.
+     */
+    struct operation_type {
+
+        /**
+         * @brief the number of calls.
+         */
+        std::uint64_t calls{};
+
+        /**
+         * @brief the number of calls which returned an error.
+         */
+        std::uint64_t errors{};
+
+        /**
+         * @brief the latency distribution of calls.
+         */
+        LatencyHistogram latency{};
+    };
+
+    /**
+     * @brief the operation statistics, indexed by MetricsOperation.
+     */
+    std::array<operation_type, metrics_operation_count> operations{};
+
+    /**
+     * @brief the operation counters for each storage name.
+     */
+    std::map<std::string, StorageMetrics, std::less<>> storages{};
+
+    /**
+     * @brief the number of aborted transactions for each reason.
+     */
+    std::map<ErrorCode, std::uint64_t> aborts{};
+
+    /**
+     * @brief the number of transactions retried by transaction_exec().
+     */
+    std::uint64_t retries{};
+
+    /**
+     * @brief the elapsed time distribution of the transaction lifecycle phases, indexed by TransactionPhase.
+     */
+    std::array<LatencyHistogram, transaction_phase_count> phases{};
+
+    /**
+     * @brief returns the statistics of the operation.
+     * @param op the target operation
+     * @return the statistics
+     */
+    [[nodiscard]] operation_type& operation(MetricsOperation op) noexcept {
+        return operations[static_cast<std::size_t>(op)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    /// @copydoc operation(MetricsOperation)
+    [[nodiscard]] operation_type const& operation(MetricsOperation op) const noexcept {
+        return operations[static_cast<std::size_t>(op)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    /**
+     * @brief returns the elapsed time distribution of the transaction lifecycle phase.
+     * @param phase the target phase
+     * @return the elapsed time distribution
+     */
+    [[nodiscard]] LatencyHistogram& phase(TransactionPhase phase) noexcept {
+        return phases[static_cast<std::size_t>(phase)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    /// @copydoc phase(TransactionPhase)
+    [[nodiscard]] LatencyHistogram const& phase(TransactionPhase phase) const noexcept {
+        return phases[static_cast<std::size_t>(phase)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+};
+
+/**
+ * @brief appends the summary of the metrics into the given stream.
+ * @param out the target stream
+ * @param value the source metrics
+ * @return the target stream
+ */
+inline std::ostream& operator<<(std::ostream& out, MetricsSnapshot const& value) {
+    for (std::size_t i = 0; i < metrics_operation_count; ++i) {
+        auto op = static_cast<MetricsOperation>(i);
+        auto&& stat = value.operation(op);
+        if (stat.calls == 0) {
+            continue;
+        }
+        auto&& h = stat.latency;
+        out << op << ": calls=" << stat.calls << " errors=" << stat.errors;
+        if (h.count() > 0) {
+            out << " mean_ns=" << h.mean()
+                << " p50_ns=" << h.percentile(50)
+                << " p99_ns=" << h.percentile(99)
+                << " p999_ns=" << h.percentile(99.9)
+                << " max_ns=" << h.max();
+        }
+        out << std::endl;
+    }
+    for (auto&& [name, stat] : value.storages) {
+        out << "storage " << name << ": get=" << stat.get_count
+            << " put=" << stat.put_count
+            << " delete=" << stat.delete_count
+            << " scan=" << stat.scan_count << std::endl;
+    }
+    for (auto&& [code, count] : value.aborts) {
+        out << "abort " << code << ": " << count << std::endl;
+    }
+    if (value.retries > 0) {
+        out << "retries: " << value.retries << std::endl;
+    }
+    for (std::size_t i = 0; i < transaction_phase_count; ++i) {
+        auto phase = static_cast<TransactionPhase>(i);
+        auto&& h = value.phase(phase);
+        if (h.count() == 0) {
+            continue;
+        }
+        out << "phase " << phase << ": count=" << h.count()
+            << " mean_ns=" << h.mean()
+            << " p50_ns=" << h.percentile(50)
+            << " p99_ns=" << h.percentile(99)
+            << " p999_ns=" << h.percentile(99.9)
+            << " max_ns=" << h.max() << std::endl;
+    }
+    return out;
+}
+
+}  // namespace sharksfin
+
+#endif  // SHARKSFIN_METRICS_H_
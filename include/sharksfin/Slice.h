@@ -16,6 +16,7 @@
 #ifndef SHARKSFIN_SLICE_H_
 #define SHARKSFIN_SLICE_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -114,6 +115,20 @@ public:
         return *reinterpret_cast<T const*>(&data<std::byte>()[offset]);  // NOLINT
     }
 
+    /**
+     * @brief returns a part of this slice.
+     * The range is clamped into this slice, so that this returns an empty slice if offset is out of this slice.
+     * @param offset the offset (in bytes) from beginning of this slice
+     * @param length the maximum length (in bytes) of the returned slice
+     * @return the part of this slice
+     */
+    inline Slice subslice(std::size_t offset, std::size_t length = static_cast<std::size_t>(-1)) const noexcept {
+        if (offset >= size()) {
+            return {};
+        }
+        return { data<std::byte>() + offset, std::min(length, size() - offset) };  // NOLINT
+    }
+
     /**
      * @brief returns a copy of this slice as std::string.
      * @return a copy
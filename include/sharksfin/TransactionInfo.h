@@ -16,11 +16,220 @@
 #ifndef SHARKSFIN_TRANSACTIONINFO_H_
 #define SHARKSFIN_TRANSACTIONINFO_H_
 
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
 #include <string_view>
 
 namespace sharksfin {
 
+/**
+ * @brief represents the events in the transaction lifecycle.
+ */
+enum class TransactionEvent : std::size_t {
+
+    /**
+     * @brief the transaction begin was requested.
+     */
+    BEGIN_REQUESTED = 0,
+
+    /**
+     * @brief the transaction was observed to be started (e.g. long transactions left WAITING_START).
+     */
+    STARTED,
+
+    /**
+     * @brief the first data operation of the transaction was processed.
+     */
+    FIRST_OPERATION,
+
+    /**
+     * @brief the transaction commit was requested.
+     */
+    COMMIT_REQUESTED,
+
+    /**
+     * @brief the concurrency control finished committing the transaction.
+     */
+    COMMIT_DONE,
+
+    /**
+     * @brief the committed transaction became durable.
+     */
+    DURABLE,
+};
+
+/**
+ * @brief the number of TransactionEvent members.
+ */
+static constexpr std::size_t transaction_event_count = static_cast<std::size_t>(TransactionEvent::DURABLE) + 1;
+
+/**
+ * @brief returns the label of the given enum value.
+ * @param value the enum value
+ * @return the corresponded label
+ */
+inline constexpr std::string_view to_string_view(TransactionEvent value) {
+    switch (value) {
+        case TransactionEvent::BEGIN_REQUESTED: return "BEGIN_REQUESTED";
+        case TransactionEvent::STARTED: return "STARTED";
+        case TransactionEvent::FIRST_OPERATION: return "FIRST_OPERATION";
+        case TransactionEvent::COMMIT_REQUESTED: return "COMMIT_REQUESTED";
+        case TransactionEvent::COMMIT_DONE: return "COMMIT_DONE";
+        case TransactionEvent::DURABLE: return "DURABLE";
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends enum label into the given stream.
+ * @param out the target stream
+ * @param value the source enum value
+ * @return the target stream
+ */
+inline std::ostream& operator<<(std::ostream& out, TransactionEvent value) {
+    return out << to_string_view(value);
+}
+
+/**
+ * @brief represents the phases between the transaction lifecycle events.
+ */
+enum class TransactionPhase : std::size_t {
+
+    /**
+     * @brief from BEGIN_REQUESTED to STARTED.
+     */
+    QUEUEING = 0,
+
+    /**
+     * @brief from STARTED to COMMIT_REQUESTED.
+     */
+    EXECUTION,
+
+    /**
+     * @brief from COMMIT_REQUESTED to COMMIT_DONE.
+     */
+    VALIDATION,
+
+    /**
+     * @brief from COMMIT_DONE to DURABLE.
+     */
+    DURABILITY,
+};
+
+/**
+ * @brief the number of TransactionPhase members.
+ */
+static constexpr std::size_t transaction_phase_count = static_cast<std::size_t>(TransactionPhase::DURABILITY) + 1;
+
+/**
+ * @brief returns the label of the given enum value.
+ * @param value the enum value
+ * @return the corresponded label
+ */
+inline constexpr std::string_view to_string_view(TransactionPhase value) {
+    switch (value) {
+        case TransactionPhase::QUEUEING: return "QUEUEING";
+        case TransactionPhase::EXECUTION: return "EXECUTION";
+        case TransactionPhase::VALIDATION: return "VALIDATION";
+        case TransactionPhase::DURABILITY: return "DURABILITY";
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends enum label into the given stream.
+ * @param out the target stream
+ * @param value the source enum value
+ * @return the target stream
+ */
+inline std::ostream& operator<<(std::ostream& out, TransactionPhase value) {
+    return out << to_string_view(value);
+}
+
+/**
+ * @brief the monotonic timestamps of the transaction lifecycle events.
+ */
+class TransactionTimings final {
+public:
+    /**
+     * @brief the clock type.
+     */
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief the time point type.
+     */
+    using time_point = clock::time_point;
+
+    /**
+     * @brief construct empty object
+     */
+    constexpr TransactionTimings() = default;
+
+    /**
+     * @brief returns the time when the event occurred.
+     * @param event the target event
+     * @return the time point of the event
+     * @return empty if the event has not occurred yet, or the implementation does not track it
+     */
+    [[nodiscard]] std::optional<time_point> at(TransactionEvent event) const noexcept {
+        auto&& e = events_[static_cast<std::size_t>(event)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (e == time_point{}) {
+            return {};
+        }
+        return e;
+    }
+
+    /**
+     * @brief sets the time when the event occurred.
+     * @param event the target event
+     * @param at the time point of the event
+     */
+    void at(TransactionEvent event, time_point at) noexcept {
+        events_[static_cast<std::size_t>(event)] = at;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    /**
+     * @brief returns the elapsed time between the two events.
+     * @param from the start event
+     * @param to the end event
+     * @return the elapsed time
+     * @return empty if either event has not occurred yet
+     */
+    [[nodiscard]] std::optional<clock::duration> between(TransactionEvent from, TransactionEvent to) const noexcept {
+        auto f = at(from);
+        auto t = at(to);
+        if (! f || ! t) {
+            return {};
+        }
+        return *t - *f;
+    }
+
+    /**
+     * @brief returns the elapsed time of the phase.
+     * @param phase the target phase
+     * @return the elapsed time
+     * @return empty if the phase has not finished yet
+     */
+    [[nodiscard]] std::optional<clock::duration> duration(TransactionPhase phase) const noexcept {
+        switch (phase) {
+            case TransactionPhase::QUEUEING: return between(TransactionEvent::BEGIN_REQUESTED, TransactionEvent::STARTED);
+            case TransactionPhase::EXECUTION: return between(TransactionEvent::STARTED, TransactionEvent::COMMIT_REQUESTED);
+            case TransactionPhase::VALIDATION: return between(TransactionEvent::COMMIT_REQUESTED, TransactionEvent::COMMIT_DONE);
+            case TransactionPhase::DURABILITY: return between(TransactionEvent::COMMIT_DONE, TransactionEvent::DURABLE);
+        }
+        std::abort();
+    }
+
+private:
+    std::array<time_point, transaction_event_count> events_{};
+};
+
 /**
  * @brief represents transaction information.
  */
@@ -41,6 +250,19 @@ public:
         id_(id)
     {}
 
+    /**
+     * @brief construct new object
+     * @param id the transaction id
+     * @param timings the timestamps of the transaction lifecycle
+     */
+    TransactionInfo(
+        std::string_view id,
+        TransactionTimings timings
+    ) noexcept :
+        id_(id),
+        timings_(timings)
+    {}
+
     /**
      * @brief accessor for the transaction id
      */
@@ -48,8 +270,17 @@ public:
         return id_;
     }
 
+    /**
+     * @brief accessor for the timestamps of the transaction lifecycle
+     * @details this is a snapshot when the object was retrieved.
+     */
+    TransactionTimings const& timings() const noexcept {
+        return timings_;
+    }
+
 private:
     std::string id_{};
+    TransactionTimings timings_{};
 };
 
 }  // namespace sharksfin
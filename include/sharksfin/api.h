@@ -21,6 +21,7 @@
 #include <type_traits>
 #include <functional>
 #include <any>
+#include <vector>
 
 #include "DatabaseOptions.h"
 #include "Slice.h"
@@ -30,6 +31,10 @@
 #include "TransactionState.h"
 #include "TransactionInfo.h"
 #include "CallResult.h"
+#include "IteratorBatch.h"
+#include "IteratorColumns.h"
+#include "Metrics.h"
+#include "HotKey.h"
 #include "StorageOptions.h"
 
 /**
@@ -102,6 +107,16 @@ using IteratorHandle = std::add_pointer_t<IteratorStub>;
  */
 using TransactionCallback = std::add_pointer_t<TransactionOperation(TransactionHandle, void*)>;
 
+/**
+ * @brief scan filter function type.
+ * @details the function receives the key and value of each row, and the context pointer given with the filter.
+ * It returns true if the row should be provided by the iterator, or false to skip the row.
+ * The function is called on the read-ahead helper thread instead of the caller's thread if read-ahead is enabled.
+ * @see iterator_set_filter()
+ * @see iterator_set_read_ahead()
+ */
+using ScanFilter = std::add_pointer_t<bool(Slice, Slice, void*)>;
+
 /**
  * @brief durability marker type
  * @details monotonic (among durability callback invocations) marker to indicate how far durability processing completed
@@ -186,6 +201,33 @@ StatusCode database_dispose(
  */
 StatusCode database_register_durability_callback(DatabaseHandle handle, durability_callback_type cb);
 
+/**
+ * @brief retrieves the metrics collected by the database.
+ * @details the metrics are collected only if the database was opened with the performance tracking attribute
+ * ("perf" = "true"). Otherwise, the result is always empty.
+ * The counters and histograms are cumulative since the database was opened.
+ * The same metrics are also printed by print_diagnostics().
+ * @param handle the target database
+ * @param result [OUT] the snapshot of the metrics
+ * @return StatusCode::OK if the metrics were successfully retrieved
+ * @return otherwise if error occurred
+ */
+StatusCode database_get_metrics(DatabaseHandle handle, MetricsSnapshot& result);
+
+/**
+ * @brief retrieves the keys which most frequently caused transaction failures.
+ * @details the failures reported with a storage/key error locator (e.g. aborts on commit by conflicts) are counted
+ * for each storage and reason, and the top keys of each pair are kept. The number of keys kept for each pair can be
+ * configured by the database attribute "hot_keys" (default: 16, "0" disables tracking).
+ * The counts are estimations, which never underestimate but may slightly overestimate.
+ * The same hot keys are also printed by print_diagnostics().
+ * @param handle the target database
+ * @param result [OUT] the hot keys, ordered by the storage name and reason, and then by the descending count
+ * @return StatusCode::OK if the hot keys were successfully retrieved
+ * @return otherwise if error occurred
+ */
+StatusCode database_get_hot_keys(DatabaseHandle handle, std::vector<HotKey>& result);
+
 /**
  * @brief creates a new storage space onto the target database.
  * The specified slice can be disposed after this operation.
@@ -403,11 +445,21 @@ StatusCode storage_set_options(
 /**
  * @brief executes the given callback function in a new transaction process.
  * The callback function may be called twice or more.
+ * The transaction is retried at most TransactionOptions::retry_count() times, when the callback returns
+ * TransactionOperation::RETRY or the commit fails with StatusCode::ERR_ABORTED_RETRYABLE, with randomized
+ * exponential backoff between attempts. If the aborted transaction conflicted on a key, the retries conflicted on
+ * the same key back off one by one, so that their next attempts are spread out.
+ * The retries are counted in MetricsSnapshot::retries.
  * @param handle the target database
  * @param options the transaction options
  * @param callback the operation to be processed in transaction
  * @param arguments extra arguments for the callback function
  * @return the operation status
+ * @return StatusCode::ERR_ABORTED_RETRYABLE if the transaction was still aborted after the retries
+ * @attention the default TransactionOptions::retry_count() is 0, so that the transaction is never retried unless
+ * the retry count is specified. Earlier versions ignored the retry count and retried the aborted commit forever,
+ * so that callers relying on it must specify TransactionOptions::INF.
+ * @note the in-memory implementation never fails on commit, and only retries TransactionOperation::RETRY.
  */
 StatusCode transaction_exec(
         DatabaseHandle handle,
@@ -445,6 +497,9 @@ StatusCode transaction_begin(
 
 /**
  * @brief retrieve the info. object for the transaction
+ * @details this is available until the transaction is disposed, so that the timings of the finished transaction
+ * (e.g. TransactionEvent::COMMIT_DONE) can be retrieved after the commit. TransactionEvent::DURABLE is tracked only if
+ * the performance tracking ("perf" database attribute) is enabled.
  * @param handle the target transaction
  * @param result [OUT] the output transaction info object, which is available only if StatusCode::OK was returned
  * @return the operation status
@@ -486,6 +541,8 @@ StatusCode transaction_borrow_handle(
  * Use this function to run strands under the same transaction. Both strand handles acquired by this function and non-stranded
  * transaction handle borrowed by transaction_borrow_handle() can be used to call content APIs as long as only one thread uses
  * the same handle at a time.
+ * The writes through the strand handles are buffered and applied to the transaction on commit (see content_put()), and
+ * the buffered writes are kept even after the strand handle is released.
  * @param handle the transaction control handle to acquire the transaction handle
  * @param result [OUT] the output target of transaction handle
  * Any thread is allowed to pass the returned handle to call sharksfin APIs, but at most one call per transaction handle
@@ -689,6 +746,95 @@ inline std::ostream& operator<<(std::ostream& out, PutOperation value) {
     return out << to_string_view(value);
 }
 
+/**
+ * @brief obtains a part of the content on the target key.
+ * This works as same as content_get(), except that the result only contains the range of the value specified by
+ * offset and length. The range is clamped into the value, so that the result is empty if offset exceeds the value.
+ * The result is available only if the returned status was StatusCode::OK.
+ * The returned slice will be disposed after calling other API functions.
+ * @param transaction the current transaction (or strand) handle
+ * @param storage the target storage
+ * @param key the content key
+ * @param offset the offset (in bytes) of the range in the value
+ * @param length the maximum length (in bytes) of the range
+ * @param result [OUT] the slice of the obtained range
+ * @return StatusCode::OK if the target content was obtained successfully
+ * @return StatusCode::NOT_FOUND if the target content does not exist
+ * @return otherwise as same as content_get()
+ * @see content_get()
+ */
+extern "C" StatusCode content_get_partial(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        std::size_t offset,
+        std::size_t length,
+        Slice* result);
+
+/**
+ * @brief obtains contents on the multiple keys at once.
+ * This works as same as calling content_get() for each key, except that the keys are processed in the key order
+ * to improve the locality of the index traversal, and the results are kept in the per-call result area so that all
+ * of them are available at the same time.
+ * The results and statuses are stored in the same order as keys.
+ * Each result is available only if the corresponding status was StatusCode::OK.
+ * The returned slices will be disposed after calling other API functions.
+ * @param transaction the current transaction (or strand) handle
+ * @param storage the target storage
+ * @param keys the content keys, must have count elements
+ * @param count the number of keys
+ * @param results [OUT] the slices of obtained contents, must have room for count elements
+ * @param statuses [OUT] the status of each key, must have room for count elements.
+ * StatusCode::OK if the content was obtained, StatusCode::NOT_FOUND if the content does not exist, or other
+ * warnings as same as content_get() (e.g. StatusCode::CONCURRENT_OPERATION).
+ * @return StatusCode::OK if all keys were processed, even if some of them were not found
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return otherwise if error was occurred on any key. The statuses of the keys which were not processed are set to
+ * the same error.
+ * @see content_get()
+ */
+extern "C" StatusCode content_get_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        Slice* results,
+        StatusCode* statuses);
+
+/**
+ * @brief obtains a content on the target key, and keeps it available until it is released.
+ * This works as same as content_get(), except that the returned slice is not disposed by other API calls.
+ * It is available until it is released by content_release(), or the transaction is disposed.
+ * The result is available only if the returned status was StatusCode::OK.
+ * @param transaction the current transaction (or strand) handle
+ * @param storage the target storage
+ * @param key the content key
+ * @param result [OUT] the slice of obtained content
+ * @return StatusCode::OK if the target content was obtained successfully
+ * @return StatusCode::NOT_FOUND if the target content does not exist
+ * @return otherwise as same as content_get()
+ * @see content_get()
+ * @see content_release()
+ */
+extern "C" StatusCode content_get_pinned(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        Slice* result);
+
+/**
+ * @brief releases the slice obtained by content_get_pinned().
+ * The released slice must not be used after this operation.
+ * @param transaction the transaction (or strand) handle which obtained the slice
+ * @param content the slice to release
+ * @return StatusCode::OK if the slice was successfully released
+ * @return StatusCode::NOT_FOUND if the slice is not obtained by content_get_pinned() or has already been released
+ * @return otherwise if error was occurred
+ */
+extern "C" StatusCode content_release(
+        TransactionHandle transaction,
+        Slice content);
+
 /**
  * @brief puts a content onto the target key.
  * @param transaction the current transaction handle
@@ -704,9 +850,18 @@ inline std::ostream& operator<<(std::ostream& out, PutOperation value) {
  * operation complete, or doesn't exist any more.
  * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is read-only
  * @return StatusCode::ERR_INVALID_KEY_LENGTH if the key length is invalid (e.g. too long) to be handled by transaction engine
- * @return StatusCode::ERR_INVALID_ARGS if input TransactionHandle is strand handle (strand is not supported for write)
  * @return warnings if the operation is not applicable to the entry. See PutOperation.
  * @return otherwise if error was occurred
+ * @note writes through a strand handle (see transaction_acquire_handle()) are buffered in the strand, and applied to
+ * the transaction just before it is committed. Such writes always return StatusCode::OK unless the transaction is
+ * inactive or read-only. If applying a buffered write results in any status other than StatusCode::OK (including
+ * warnings, e.g. StatusCode::ALREADY_EXISTS for PutOperation::CREATE), the transaction is aborted and the commit
+ * returns StatusCode::ERR_ABORTED with the error code describing the reason (e.g. ErrorCode::KVS_KEY_ALREADY_EXISTS).
+ * The buffered deletes of missing entries are not the failure, as content_delete() treats them as successful.
+ * The buffered writes are not visible from the reads in the same transaction until commit, and
+ * the order between the writes from different strands is unspecified. The writes through the non-stranded handle to
+ * the keys which have been written through the strand handles are rejected with StatusCode::ERR_ILLEGAL_OPERATION,
+ * because they would be overwritten by the buffered writes on commit.
  */
 extern "C" StatusCode content_put(
         TransactionHandle transaction,
@@ -732,9 +887,9 @@ extern "C" StatusCode content_put(
  * operation complete, or doesn't exist any more.
  * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is read-only
  * @return StatusCode::ERR_INVALID_KEY_LENGTH if the key length is invalid (e.g. too long) to be handled by transaction engine
- * @return StatusCode::ERR_INVALID_ARGS if input TransactionHandle is strand handle (strand is not supported for write)
  * @return warnings if the operation is not applicable to the entry. See PutOperation.
  * @return otherwise if error was occurred
+ * @note writes through a strand handle are buffered until commit. See content_put().
  */
 extern "C" StatusCode content_put_with_blobs(
         TransactionHandle transaction,
@@ -745,6 +900,37 @@ extern "C" StatusCode content_put_with_blobs(
         std::size_t blobs_size,
         PutOperation operation = PutOperation::CREATE_OR_UPDATE);
 
+/**
+ * @brief puts contents onto the multiple keys at once.
+ * This works as same as calling content_put() for each row, except that the rows may be processed in the key order
+ * to improve the locality of the index traversal. The rows with the same key are processed in the given order.
+ * The statuses are stored in the same order as rows.
+ * @param transaction the current transaction handle
+ * @param storage the target storage
+ * @param keys the content keys, must have count elements
+ * @param values the content values, must have count elements
+ * @param operations the put operation of each row, must have count elements. See PutOperation.
+ * @param count the number of rows
+ * @param statuses [OUT] the status of each row, must have room for count elements.
+ * StatusCode::OK if the row was successfully put, or warnings if the operation is not applicable to the entry.
+ * @return StatusCode::OK if all rows were processed, even if some of them were not applicable
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is read-only
+ * @return otherwise if error was occurred on any row. The statuses of the rows which were not processed are set to
+ * the same error.
+ * @note writes through a strand handle are buffered until commit, and their statuses are always StatusCode::OK.
+ * See content_put().
+ * @see content_put()
+ */
+extern "C" StatusCode content_put_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        Slice const* values,
+        PutOperation const* operations,
+        std::size_t count,
+        StatusCode* statuses);
+
 /**
  * @brief removes a content on the target key.
  * @param transaction the current transaction handle
@@ -756,14 +942,41 @@ extern "C" StatusCode content_put_with_blobs(
  * @return StatusCode::PREMATURE if the transaction is not ready to accept request
  * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is read-only
  * @return StatusCode::ERR_INVALID_KEY_LENGTH if the key length is invalid (e.g. too long) to be handled by transaction engine
- * @return StatusCode::ERR_INVALID_ARGS if input TransactionHandle is strand handle (strand is not supported for write)
  * @return otherwise if error was occurred
+ * @note writes through a strand handle are buffered until commit. See content_put().
  */
 extern "C" StatusCode content_delete(
         TransactionHandle transaction,
         StorageHandle storage,
         Slice key);
 
+/**
+ * @brief removes contents on the multiple keys at once.
+ * This works as same as calling content_delete() for each key, except that the keys may be processed in the key
+ * order to improve the locality of the index traversal.
+ * The statuses are stored in the same order as keys.
+ * @param transaction the current transaction handle
+ * @param storage the target storage
+ * @param keys the content keys, must have count elements
+ * @param count the number of keys
+ * @param statuses [OUT] the status of each key, must have room for count elements.
+ * StatusCode::OK if the content was successfully deleted, or StatusCode::NOT_FOUND if it was not found.
+ * @return StatusCode::OK if all keys were processed, even if some of them were not found
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is read-only
+ * @return otherwise if error was occurred on any key. The statuses of the keys which were not processed are set to
+ * the same error.
+ * @note writes through a strand handle are buffered until commit, and their statuses are always StatusCode::OK.
+ * See content_put().
+ * @see content_delete()
+ */
+extern "C" StatusCode content_delete_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        StatusCode* statuses);
+
 /**
  * @brief obtains an iterator over the prefix key range.
  * The content of prefix key must not be changed while using the returned iterator.
@@ -868,6 +1081,33 @@ inline std::ostream& operator<<(std::ostream& out, EndPointKind value) {
     return out << to_string_view(value);
 }
 
+/**
+ * @brief a key range of scan.
+ * @see content_scan_multi()
+ */
+struct ScanRange {
+
+    /**
+     * @brief the content key of beginning position.
+     */
+    Slice begin_key;
+
+    /**
+     * @brief end-point kind of the beginning position.
+     */
+    EndPointKind begin_kind;
+
+    /**
+     * @brief the content key of ending position.
+     */
+    Slice end_key;
+
+    /**
+     * @brief end-point kind of the ending position.
+     */
+    EndPointKind end_kind;
+};
+
 /**
  * @brief obtains iterator between begin and end keys range.
  * The content of begin/end keys must not be changed while using the returned iterator.
@@ -898,6 +1138,126 @@ extern "C" StatusCode content_scan(
         std::size_t limit = 0,
         bool reverse = false);
 
+/**
+ * @brief obtains key only iterator between begin and end keys range.
+ * This works as same as content_scan(), except that the returned iterator never reads values from the storage.
+ * iterator_get_value() on the returned iterator returns StatusCode::ERR_ILLEGAL_OPERATION, and the batch fetch
+ * operations (e.g. iterator_next_batch()) return empty values.
+ * This is suitable for index only scans or existence checks.
+ * @param transaction the current transaction (or strand) handle
+ * @param storage the target storage
+ * @param begin_key the content key of beginning position
+ * @param begin_kind end-point kind of the beginning position
+ * @param end_key the content key of ending position
+ * @param end_kind end-point kind of the ending position
+ * @param result [OUT] an iterator handle over the key range
+ * @param limit the max number of entries to be fetched. 0 indicates no limit.
+ * @param reverse whether or not the iterator scans in reverse order (from end to begin)
+ * @return StatusCode::OK if the iterator was successfully prepared
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return StatusCode::ERR_INVALID_KEY_LENGTH if the key length is invalid (e.g. too long) to be handled by transaction engine
+ * @return otherwise if error was occurred
+ * @see content_scan()
+ */
+extern "C" StatusCode content_scan_keys(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        IteratorHandle* result,
+        std::size_t limit = 0,
+        bool reverse = false);
+
+/**
+ * @brief obtains iterator over the multiple key ranges.
+ * The returned iterator walks the given ranges in order, as if the iterators created by content_scan() for the
+ * individual ranges were concatenated. This is cheaper than creating an iterator for each range, because the
+ * iterator and its buffers are reused between the ranges.
+ * The ranges must be sorted in ascending order and must not overlap each other.
+ * Contrary to content_scan(), the returned iterator refers the given ranges instead of copying them, so that the
+ * ranges array and the content of their keys must be kept while using the returned iterator.
+ * The created handle must be disposed by iterator_dispose().
+ * The returned iterator does not support iterator_seek(), but iterator_rebind() replaces all ranges with the given one.
+ * @param transaction the current transaction (or strand) handle
+ * @param storage the target storage
+ * @param ranges the key ranges, must have count elements
+ * @param count the number of ranges. The returned iterator is empty if this is 0.
+ * @param result [OUT] an iterator handle over the key ranges
+ * @return StatusCode::OK if the iterator was successfully prepared
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return otherwise if error was occurred
+ * @see content_scan()
+ */
+extern "C" StatusCode content_scan_multi(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        ScanRange const* ranges,
+        std::size_t count,
+        IteratorHandle* result);
+
+/**
+ * @brief estimates the keys which split the key range into roughly equal-sized partitions.
+ * The i-th partition starts at the (i-1)-th split key (inclusive) and ends at the i-th split key (exclusive), except
+ * that the first partition starts at the beginning of the range and the last partition ends at the end of the range.
+ * Use content_scan_partitioned() to open iterators over the individual partitions.
+ * The split keys are only estimation: the memory implementation computes them from the current index entries,
+ * and other implementations may compute them from the sampled keys in the range.
+ * Fewer split keys may be returned if the range does not contain enough entries.
+ * Note that estimating the split keys may read the keys in the range through the transaction, and the keys read are
+ * added to the read set of the transaction. The shirakami implementation reads at most a fixed number of keys for
+ * each partition (1024 keys in current implementation) from the beginning of the range; if the range contains more
+ * keys, it instead reads only one key at each of the positions interpolated between the first and the last key of
+ * the range, so that the estimation can be less accurate if the keys are not distributed uniformly.
+ * @param transaction the current transaction (or strand) handle
+ * @param storage the target storage
+ * @param begin_key the content key of beginning position
+ * @param begin_kind end-point kind of the beginning position
+ * @param end_key the content key of ending position
+ * @param end_kind end-point kind of the ending position
+ * @param partitions the desired number of partitions
+ * @param out [OUT] the distinct split keys in ascending order, at most (partitions - 1) elements
+ * @return StatusCode::OK if the split keys were successfully estimated
+ * @return StatusCode::ERR_INVALID_ARGUMENT if partitions is 0
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return otherwise if error was occurred
+ */
+StatusCode storage_estimate_split_points(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::size_t partitions,
+        std::vector<std::string>& out);
+
+/**
+ * @brief obtains iterators over the partitions of the key range.
+ * The key range is split by the given split keys (typically computed by storage_estimate_split_points()), and
+ * the iterator over the i-th partition is created with transactions[i] as if by content_scan().
+ * This is intended to scan the partitions in parallel with the individual strand handles.
+ * The content of begin/end keys and split keys must not be changed while using the returned iterators.
+ * The created handles must be disposed by iterator_dispose().
+ * @param transactions the transaction (or strand) handles for the individual partitions,
+ * must have (split_points.size() + 1) elements
+ * @param storage the target storage
+ * @param begin_key the content key of beginning position
+ * @param begin_kind end-point kind of the beginning position
+ * @param end_key the content key of ending position
+ * @param end_kind end-point kind of the ending position
+ * @param split_points the distinct split keys in ascending order, which must be in the key range
+ * @param results [OUT] the iterator handles over the individual partitions,
+ * must have room for (split_points.size() + 1) elements
+ * @return StatusCode::OK if all iterators were successfully prepared
+ * @return otherwise if error was occurred. No iterators are left open in this case.
+ * @see content_scan()
+ */
+StatusCode content_scan_partitioned(
+        TransactionHandle const* transactions,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::vector<std::string> const& split_points,
+        IteratorHandle* results);
+
 /**
  * @brief advances the given iterator.
  * This will change the iterator state.
@@ -944,6 +1304,7 @@ extern "C" StatusCode iterator_get_key(
  * @return StatusCode::CONCURRENT_OPERATION if other concurrent operation is observed and the request is rejected.
  * The transaction is still active (i.e. not aborted). Retrying the request might be successful if the concurrent
  * operation complete, or doesn't exist any more.
+ * @return StatusCode::ERR_ILLEGAL_OPERATION if the iterator was created by content_scan_keys()
  * @return otherwise if error was occurred
  * @return undefined if the iterator position is not valid
  */
@@ -951,6 +1312,165 @@ extern "C" StatusCode iterator_get_value(
         IteratorHandle handle,
         Slice* result);
 
+/**
+ * @brief advances the given iterator and fetches multiple rows at once.
+ * This will change the iterator state.
+ * This copies keys and values of at most max_rows subsequent entries into the caller provided buffer, as long as
+ * their total size does not exceed max_bytes.
+ * The entry which could not be fetched due to max_bytes is kept, and it will be fetched by the next call of
+ * iterator_next_batch() or iterator_next().
+ * Entries removed concurrently after the iterator reached them are skipped.
+ * After this operation, the iterator position is not valid, so that use iterator_next() or iterator_next_batch()
+ * before retrieving the key or value from the iterator.
+ * @param handle the target iterator
+ * @param max_rows the maximum number of rows to fetch, must be greater than 0
+ * @param max_bytes the maximum number of total bytes of keys and values to fetch
+ * @param out [OUT] the buffer to receive the rows. The entries and data must have room for max_rows and
+ * max_bytes respectively. The row_count and data_size are set by this operation.
+ * @return StatusCode::OK if one or more rows were fetched
+ * @return StatusCode::NOT_FOUND if the next content does not exist
+ * @return StatusCode::ERR_INVALID_ARGUMENT if max_rows is 0
+ * @return StatusCode::ERR_RESOURCE_LIMIT_REACHED if the next entry is larger than max_bytes.
+ * Retrying with larger buffer can fetch the entry.
+ * @return StatusCode::CONCURRENT_OPERATION if other concurrent operation is observed on the next entry and the
+ * request is rejected. Retrying the request might be successful.
+ * @return otherwise if error was occurred. The out contains the rows fetched before the error.
+ */
+extern "C" StatusCode iterator_next_batch(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        std::size_t max_bytes,
+        IteratorBatch* out);
+
+/**
+ * @brief advances the given iterator and fetches multiple rows at once in columnar layout.
+ * This will change the iterator state.
+ * This works as same as iterator_next_batch(), except that keys and values are stored into separate column buffers
+ * compatible with Apache Arrow large binary layout (see IteratorColumns), so that the fetched rows can be processed
+ * in vectorized manner without per-row decoding.
+ * The entry which could not be fetched due to the capacity of either data buffer is kept, and it will be fetched
+ * by the next call of iterator_next_columns() or iterator_next().
+ * After this operation, the iterator position is not valid, so that use iterator_next() or iterator_next_columns()
+ * before retrieving the key or value from the iterator.
+ * @param handle the target iterator
+ * @param max_rows the maximum number of rows to fetch, must be greater than 0
+ * @param out [OUT] the column buffers to receive the rows. The offsets arrays must have room for max_rows + 1
+ * elements. The row_count and offsets are set by this operation.
+ * @return StatusCode::OK if one or more rows were fetched
+ * @return StatusCode::NOT_FOUND if the next content does not exist
+ * @return StatusCode::ERR_INVALID_ARGUMENT if max_rows is 0
+ * @return StatusCode::ERR_RESOURCE_LIMIT_REACHED if the next entry is larger than the data buffers.
+ * Retrying with larger buffers can fetch the entry.
+ * @return StatusCode::CONCURRENT_OPERATION if other concurrent operation is observed on the next entry and the
+ * request is rejected. Retrying the request might be successful.
+ * @return otherwise if error was occurred. The out contains the rows fetched before the error.
+ */
+extern "C" StatusCode iterator_next_columns(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        IteratorColumns* out);
+
+/**
+ * @brief restricts the values provided by the given iterator into the range.
+ * After this operation, iterator_get_value() and the batch fetch operations (e.g. iterator_next_batch()) only provide
+ * the range of each value specified by offset and length. The range is clamped into each value.
+ * This never changes the iterator position.
+ * @param handle the target iterator handle
+ * @param offset the offset (in bytes) of the range in each value
+ * @param length the maximum length (in bytes) of the range
+ * @return StatusCode::OK if the window was successfully set
+ * @return otherwise if error was occurred
+ */
+extern "C" StatusCode iterator_set_value_window(
+        IteratorHandle handle,
+        std::size_t offset,
+        std::size_t length);
+
+/**
+ * @brief enables read-ahead of the given iterator.
+ * After this operation, the subsequent rows are fetched ahead of the consumer in the batches of the given rows, so
+ * that fetching rows from the transaction engine overlaps with processing the fetched rows.
+ * This must be called before the first iterator_next() (or the batch fetch operations) of the iterator, and is only
+ * available for the iterators of read-only transactions (TransactionOptions::TransactionType::READ_ONLY).
+ * The errors occurred while fetching rows ahead are reported by iterator_next() after the rows fetched before.
+ * The rows are fetched on a helper thread, which also evaluates the filter set by iterator_set_filter().
+ * The helper thread is stopped when the transaction is committed or aborted, and then iterator_next() returns
+ * StatusCode::ERR_INACTIVE_TRANSACTION.
+ * Implementations which have no benefit from read-ahead (e.g. the in-memory implementation) may never fetch rows
+ * ahead, but they still validate the request as described below.
+ * @param handle the target iterator handle
+ * @param rows the number of rows fetched ahead at once
+ * @return StatusCode::OK if read-ahead was successfully enabled
+ * @return StatusCode::ERR_INVALID_ARGUMENT if rows is 0
+ * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is not read-only, or the iterator was already advanced
+ * @return otherwise if error was occurred
+ */
+extern "C" StatusCode iterator_set_read_ahead(
+        IteratorHandle handle,
+        std::size_t rows);
+
+/**
+ * @brief sets the filter of the rows provided by the given iterator.
+ * After this operation, the iterator evaluates the filter for each row inside the iterator, and the rows for which
+ * the filter returns false are skipped by iterator_next() and the batch fetch operations (e.g. iterator_next_batch()).
+ * This avoids the API calls and copies for the rows which do not qualify.
+ * The filter receives the whole value even if the value window is set, and an empty value if the iterator was created
+ * by content_scan_keys(). The slices passed to the filter are only available during the call.
+ * The filter may be called from the other thread if read-ahead is enabled, so that it must not depend on the calling
+ * thread, and this must be called before iterator_set_read_ahead().
+ * @param handle the target iterator handle
+ * @param filter the filter function, or nullptr to clear the filter
+ * @param context the context pointer passed to the filter
+ * @return StatusCode::OK if the filter was successfully set
+ * @return StatusCode::ERR_ILLEGAL_OPERATION if read-ahead is already enabled for the iterator
+ * @return otherwise if error was occurred
+ */
+extern "C" StatusCode iterator_set_filter(
+        IteratorHandle handle,
+        ScanFilter filter,
+        void* context);
+
+/**
+ * @brief moves the beginning position of the given iterator.
+ * This keeps the ending position of the iterator, and the next iterator_next() moves to the first entry from the
+ * new beginning position, as if the iterator was created by content_scan() with the new beginning position.
+ * This is cheaper than disposing the iterator and creating a new one, because it reuses the iterator and its buffers.
+ * The other settings of the iterator (e.g. limit, value window and read-ahead) are kept.
+ * The content of key may point to the current entry of the iterator (e.g. the result of iterator_get_key()).
+ * @param handle the target iterator handle
+ * @param key the content key of the new beginning position
+ * @param kind end-point kind of the new beginning position
+ * @return StatusCode::OK if the iterator was successfully moved
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return StatusCode::ERR_ILLEGAL_OPERATION if the iterator was created by content_scan_multi()
+ * @return otherwise if error was occurred
+ */
+extern "C" StatusCode iterator_seek(
+        IteratorHandle handle,
+        Slice key,
+        EndPointKind kind);
+
+/**
+ * @brief replaces the key range of the given iterator.
+ * The next iterator_next() moves to the first entry in the new range, as if the iterator was created by
+ * content_scan() with the new range.
+ * This is cheaper than disposing the iterator and creating a new one, because it reuses the iterator and its buffers.
+ * The other settings of the iterator (e.g. limit, value window and read-ahead) are kept.
+ * The content of begin/end keys must not be changed while using the iterator.
+ * @param handle the target iterator handle
+ * @param begin_key the content key of beginning position
+ * @param begin_kind end-point kind of the beginning position
+ * @param end_key the content key of ending position
+ * @param end_kind end-point kind of the ending position
+ * @return StatusCode::OK if the key range was successfully replaced
+ * @return StatusCode::ERR_INACTIVE_TRANSACTION if the transaction is inactive and the request is rejected
+ * @return otherwise if error was occurred
+ */
+extern "C" StatusCode iterator_rebind(
+        IteratorHandle handle,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind);
+
 /**
  * @brief disposes the iterator handle.
  * This will change the iterator state.
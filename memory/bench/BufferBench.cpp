@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Buffer.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace sharksfin::memory {
+
+static void Buffer_construct(benchmark::State& state) {
+    std::string source(static_cast<std::size_t>(state.range(0)), 'v');
+    Slice slice { source };
+    for (auto _ : state) {
+        Buffer buffer { slice };
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(Buffer_construct)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+static void Buffer_copy_construct(benchmark::State& state) {
+    Buffer source { std::string(static_cast<std::size_t>(state.range(0)), 'v') };
+    for (auto _ : state) {
+        Buffer buffer { source };
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(Buffer_copy_construct)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+// the same size assignment reuses the current storage
+static void Buffer_assign_same_size(benchmark::State& state) {
+    std::string source(static_cast<std::size_t>(state.range(0)), 'v');
+    Slice slice { source };
+    Buffer buffer { slice };
+    for (auto _ : state) {
+        buffer = slice;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(Buffer_assign_same_size)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+// the different size assignment always re-allocates the storage
+static void Buffer_assign_resize(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    std::string a(size, 'a');
+    std::string b(size + 1, 'b');
+    Slice slices[] = { Slice { a }, Slice { b } };  // NOLINT(*-avoid-c-arrays)
+    Buffer buffer { slices[0] };
+    std::size_t index = 0;
+    for (auto _ : state) {
+        index ^= 1U;
+        buffer = slices[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(Buffer_assign_resize)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+static void Buffer_move_assign(benchmark::State& state) {
+    Buffer a { std::string(static_cast<std::size_t>(state.range(0)), 'v') };
+    Buffer b {};
+    for (auto _ : state) {
+        b = std::move(a);
+        a = std::move(b);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(Buffer_move_assign)->Arg(64);
+
+}  // namespace sharksfin::memory
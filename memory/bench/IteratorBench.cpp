@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Iterator.h"
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Database.h"
+#include "Storage.h"
+
+namespace sharksfin::memory {
+
+class IteratorFixture : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State const& state) override {
+        database_ = std::make_unique<Database>();
+        storage_ = database_->create_storage("bench");
+        std::string value(static_cast<std::size_t>(state.range(1)), 'v');
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            storage_->create(key(i), value);
+        }
+    }
+
+    void TearDown(benchmark::State const&) override {
+        storage_.reset();
+        database_.reset();
+    }
+
+    static std::string key(std::int64_t index) {
+        std::array<char, 32> buffer{};
+        auto length = std::snprintf(buffer.data(), buffer.size(), "k%012lld", static_cast<long long>(index));  // NOLINT
+        return std::string(buffer.data(), static_cast<std::size_t>(length));
+    }
+
+protected:
+    std::unique_ptr<Database> database_{};
+    std::shared_ptr<Storage> storage_{};
+};
+
+// a full scan, which measures the cost of each next() including the key lookup of the successor
+BENCHMARK_DEFINE_F(IteratorFixture, next)(benchmark::State& state) {
+    for (auto _ : state) {
+        Iterator it { storage_.get(), {}, EndPointKind::UNBOUND, {}, EndPointKind::UNBOUND };
+        while (it.next()) {
+            benchmark::DoNotOptimize(it.key());
+            benchmark::DoNotOptimize(it.payload());
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_REGISTER_F(IteratorFixture, next)->Args({ 1000, 16 })->Args({ 10000, 16 })->Args({ 10000, 1024 });
+
+// short prefix scans, which are dominated by the cost of starting the scan
+BENCHMARK_DEFINE_F(IteratorFixture, next_prefix)(benchmark::State& state) {
+    std::int64_t index = 0;
+    for (auto _ : state) {
+        auto prefix = key(index).substr(0, 12);
+        Iterator it { storage_.get(), prefix, EndPointKind::PREFIXED_INCLUSIVE, prefix, EndPointKind::PREFIXED_INCLUSIVE };
+        while (it.next()) {
+            benchmark::DoNotOptimize(it.key());
+        }
+        index = (index + 10) % state.range(0);
+    }
+}
+BENCHMARK_REGISTER_F(IteratorFixture, next_prefix)->Args({ 10000, 16 });
+
+}  // namespace sharksfin::memory
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "RwMutex.h"
+
+#include <benchmark/benchmark.h>
+
+namespace sharksfin::memory {
+
+// shared by all benchmark threads, so that they contend on the same lock word
+static RwMutex mutex {};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void RwMutex_lock_unlock(benchmark::State& state) {
+    for (auto _ : state) {
+        mutex.lock();
+        benchmark::DoNotOptimize(mutex.unlock());
+    }
+}
+BENCHMARK(RwMutex_lock_unlock)->ThreadRange(1, 8)->UseRealTime();
+
+static void RwMutex_lock_shared_unlock(benchmark::State& state) {
+    for (auto _ : state) {
+        mutex.lock_shared();
+        benchmark::DoNotOptimize(mutex.unlock_shared());
+    }
+}
+BENCHMARK(RwMutex_lock_shared_unlock)->ThreadRange(1, 8)->UseRealTime();
+
+// thread 0 is the only writer, and the others are readers
+static void RwMutex_mixed(benchmark::State& state) {
+    bool writer = state.thread_index() == 0;
+    for (auto _ : state) {
+        if (writer) {
+            mutex.lock();
+            benchmark::DoNotOptimize(mutex.unlock());
+        } else {
+            mutex.lock_shared();
+            benchmark::DoNotOptimize(mutex.unlock_shared());
+        }
+    }
+}
+BENCHMARK(RwMutex_mixed)->ThreadRange(2, 8)->UseRealTime();
+
+}  // namespace sharksfin::memory
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "SequenceMap.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sharksfin::memory {
+
+static std::vector<SequenceId> create_sequences(SequenceMap& map, std::size_t count) {
+    std::vector<SequenceId> ret{};
+    ret.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ret.emplace_back(map.create());
+    }
+    return ret;
+}
+
+static void SequenceMap_put(benchmark::State& state) {
+    SequenceMap map{};
+    auto ids = create_sequences(map, static_cast<std::size_t>(state.range(0)));
+    SequenceVersion version = 0;
+    std::size_t index = 0;
+    for (auto _ : state) {
+        ++version;
+        benchmark::DoNotOptimize(map.put(ids[index], version, static_cast<SequenceValue>(version)));
+        if (++index == ids.size()) {
+            index = 0;
+        }
+    }
+}
+BENCHMARK(SequenceMap_put)->RangeMultiplier(16)->Range(1, 4096);
+
+static void SequenceMap_get(benchmark::State& state) {
+    SequenceMap map{};
+    auto ids = create_sequences(map, static_cast<std::size_t>(state.range(0)));
+    for (auto id : ids) {
+        map.put(id, 1, 1);
+    }
+    std::size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.get(ids[index]));
+        if (++index == ids.size()) {
+            index = 0;
+        }
+    }
+}
+BENCHMARK(SequenceMap_get)->RangeMultiplier(16)->Range(1, 4096);
+
+// all threads access the same map, as the transactions of a database do
+static void SequenceMap_get_contended(benchmark::State& state) {
+    static SequenceMap map{};
+    static std::vector<SequenceId> ids{};
+    // the benchmark threads start the measurement together after the setup of thread 0
+    if (state.thread_index() == 0) {
+        ids = create_sequences(map, 64);
+        for (auto id : ids) {
+            map.put(id, 1, 1);
+        }
+    }
+    std::size_t index = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.get(ids[index % ids.size()]));
+        ++index;
+    }
+}
+BENCHMARK(SequenceMap_get_contended)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace sharksfin::memory
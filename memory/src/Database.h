@@ -26,6 +26,9 @@
 #include "Buffer.h"
 #include "SequenceMap.h"
 #include "RwMutex.h"
+#include "flight_recorder.h"
+#include "hot_key_tracker.h"
+#include "metrics.h"
 
 namespace sharksfin::memory {
 
@@ -119,6 +122,31 @@ public:
         return sequences_;
     }
 
+    /**
+     * @brief returns the metrics of this database.
+     * @return the metrics
+     */
+    common::metrics& metrics() noexcept {
+        return metrics_;
+    }
+
+    /**
+     * @brief returns the tracker of the keys which frequently caused transaction failures.
+     * @details this database never fails transactions by conflicts, so that the tracker is always empty.
+     * @return the hot key tracker
+     */
+    common::hot_key_tracker& hot_keys() noexcept {
+        return hot_keys_;
+    }
+
+    /**
+     * @brief returns the flight recorder of this database.
+     * @return the flight recorder
+     */
+    common::flight_recorder& flight_recorder() noexcept {
+        return flight_recorder_;
+    }
+
 private:
     bool alive_ { true };
     std::map<Buffer, std::shared_ptr<Storage>> storages_ {};
@@ -128,6 +156,9 @@ private:
 
     bool enable_transaction_lock_ { true };
     SequenceMap sequences_{};
+    common::metrics metrics_{};
+    common::hot_key_tracker hot_keys_{};
+    common::flight_recorder flight_recorder_{};
 
     void check_alive() const;
 };
@@ -48,37 +48,145 @@ public:
      * @param end_kind end-point kind of the ending position
      * @param limit the max number of entries to be fetched. 0 indicates no limit.
      * @param reverse whether or not the iterator scans in reverse order (from end to begin)
+     * @param key_only whether or not the iterator never provides values
      */
     Iterator(
             Storage* owner,
             Slice begin_key, EndPointKind begin_kind,
-            Slice end_key, EndPointKind end_kind, std::size_t limit = 0, bool reverse = false)
+            Slice end_key, EndPointKind end_kind, std::size_t limit = 0, bool reverse = false, bool key_only = false)
         : owner_(owner)
+        , database_(owner->owner())
         , next_key_(begin_kind == EndPointKind::UNBOUND ? std::string_view {} : begin_key.to_string_view())
         , end_key_(end_kind == EndPointKind::UNBOUND ? Slice {} : end_key)
         , end_type_(interpret_end_kind(end_kind))
         , state_(interpret_begin_kind(begin_kind))
         , limit_(limit)
         , reverse_(reverse)
+        , key_only_(key_only)
     {
         (void) limit_;
         (void) reverse_;
     }
 
+    /**
+     * @brief creates a new instance which iterates over the multiple key ranges.
+     * @param owner the target storage
+     * @param ranges the sorted and disjoint key ranges, which must be kept while using this iterator
+     * @param count the number of ranges
+     */
+    Iterator(Storage* owner, ScanRange const* ranges, std::size_t count)
+        : owner_(owner)
+        , database_(owner->owner())
+        , end_type_(End::END)
+        , state_(State::END)
+        , limit_(0)
+        , reverse_(false)
+        , key_only_(false)
+        , ranges_(ranges)
+        , range_count_(count)
+    {
+        if (count > 0) {
+            bind(ranges_[0]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    /**
+     * @brief returns the storage which this iterator scans.
+     * @return the owner storage
+     */
+    Storage* owner() const noexcept {
+        return owner_;
+    }
+
+    /**
+     * @brief returns the database which this iterator belongs to.
+     * @details this is available even if the owner storage has been already dropped.
+     * @return the owner database
+     */
+    Database* database() const noexcept {
+        return database_;
+    }
+
     bool next() {
-        switch (state_) {
-            case State::INIT_INCLUSIVE:
-                return advance(false);
-            case State::INIT_EXCLUSIVE:
-                return advance(true);
-            case State::INIT_PREFIXED_EXCLUSIVE:
-                return advance_to_next_neighbor();
-            case State::CONTINUE:
-                return advance(true);
-            case State::END:
-                return false;
+        advanced_ = true;
+        if (hold_) {
+            hold_ = false;
+            return true;
+        }
+        while (true) {
+            if (! next_in_range()) {
+                if (range_index_ + 1 >= range_count_) {
+                    return false;
+                }
+                ++range_index_;
+                bind(ranges_[range_index_]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                continue;
+            }
+            if (filter_ == nullptr || filter_(next_key_, key_only_ ? Slice {} : payload_, filter_context_)) {
+                return true;
+            }
         }
-        std::abort();
+    }
+
+    /**
+     * @brief sets the filter of the entries.
+     * @param filter the filter function, or nullptr to clear the filter
+     * @param context the context pointer passed to the filter
+     * @return StatusCode::OK if the filter was successfully set
+     * @return StatusCode::ERR_ILLEGAL_OPERATION if read-ahead is enabled
+     */
+    inline StatusCode filter(ScanFilter filter, void* context) noexcept {
+        if (read_ahead_) {
+            return StatusCode::ERR_ILLEGAL_OPERATION;
+        }
+        filter_ = filter;
+        filter_context_ = context;
+        return StatusCode::OK;
+    }
+
+    /**
+     * @brief sets whether or not this iterator belongs to a read-only transaction.
+     * @param enabled true if the owner transaction is read-only
+     */
+    inline void readonly(bool enabled) noexcept {
+        readonly_ = enabled;
+    }
+
+    /**
+     * @brief enables read-ahead of this iterator.
+     * @details this only validates the request as same as the other implementations, because this iterator directly
+     * reads the in-memory index and there is nothing to fetch ahead.
+     * @param rows the number of rows in each batch
+     * @return StatusCode::OK if read-ahead is successfully enabled
+     * @return StatusCode::ERR_INVALID_ARGUMENT if rows is 0
+     * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is not read-only, this iterator was already
+     * advanced, or read-ahead is already enabled
+     */
+    inline StatusCode read_ahead(std::size_t rows) noexcept {
+        if (rows == 0) {
+            return StatusCode::ERR_INVALID_ARGUMENT;
+        }
+        if (! readonly_ || advanced_ || read_ahead_) {
+            return StatusCode::ERR_ILLEGAL_OPERATION;
+        }
+        read_ahead_ = true;
+        return StatusCode::OK;
+    }
+
+    /**
+     * @brief returns whether or not this iterator walks the multiple key ranges.
+     * @return true if this iterator was created with the multiple key ranges
+     * @return false otherwise
+     */
+    inline bool multi_range() const noexcept {
+        return ranges_ != nullptr;
+    }
+
+    /**
+     * @brief keeps the current entry so that the next call of next() does not advance this iterator.
+     */
+    inline void hold() noexcept {
+        hold_ = true;
     }
 
     /**
@@ -90,6 +198,15 @@ public:
         return state_ != State::END;
     }
 
+    /**
+     * @brief returns whether or not this iterator never provides values.
+     * @return true if this iterator is key only
+     * @return false otherwise
+     */
+    inline bool key_only() const noexcept {
+        return key_only_;
+    }
+
     /**
      * @brief returns the key on the current entry.
      * @return the key
@@ -100,22 +217,98 @@ public:
 
     /**
      * @brief returns the payload on the current entry.
+     * @details if the value window is set, this only returns the range of the payload.
      * @return the value
      */
     inline Slice payload() const {
-        return payload_;
+        return payload_.subslice(window_offset_, window_length_);
+    }
+
+    /**
+     * @brief restricts the payload into the range.
+     * @param offset the offset (in bytes) of the range in each payload
+     * @param length the maximum length (in bytes) of the range
+     */
+    inline void value_window(std::size_t offset, std::size_t length) noexcept {
+        window_offset_ = offset;
+        window_length_ = length;
+    }
+
+    /**
+     * @brief moves the beginning position of this iterator.
+     * @details this keeps the ending position, and the next call of next() returns the first entry from the new
+     * beginning position.
+     * @param key the content key of the new beginning position
+     * @param kind end-point kind of the new beginning position
+     */
+    void seek(Slice key, EndPointKind kind) {
+        // the key may point to the current entry, so that assign() must handle the overlap
+        next_key_.assign(kind == EndPointKind::UNBOUND ? std::string_view {} : key.to_string_view());
+        state_ = interpret_begin_kind(kind);
+        payload_ = {};
+        hold_ = false;
+    }
+
+    /**
+     * @brief replaces the key range of this iterator.
+     * @details the next call of next() returns the first entry in the new range.
+     * @param begin_key the content key of beginning position
+     * @param begin_kind end-point kind of the beginning position
+     * @param end_key the content key of ending position
+     * @param end_kind end-point kind of the ending position
+     */
+    void rebind(Slice begin_key, EndPointKind begin_kind, Slice end_key, EndPointKind end_kind) {
+        ranges_ = nullptr;
+        range_count_ = 0;
+        range_index_ = 0;
+        bind({ begin_key, begin_kind, end_key, end_kind });
     }
 
 private:
     Storage* owner_;
+    Database* database_;
     std::string next_key_;
     Buffer end_key_;
     End end_type_;
     State state_;
     std::size_t limit_;  //NOLINT
     bool reverse_;  //NOLINT
+    bool key_only_;
 
     Slice payload_ {};
+    std::size_t window_offset_ {};
+    std::size_t window_length_ { static_cast<std::size_t>(-1) };
+    bool hold_ {};
+    ScanRange const* ranges_ {};
+    std::size_t range_count_ {};
+    std::size_t range_index_ {};
+    ScanFilter filter_ {};
+    void* filter_context_ {};
+    bool readonly_ {};
+    bool advanced_ {};
+    bool read_ahead_ {};
+
+    bool next_in_range() {
+        switch (state_) {
+            case State::INIT_INCLUSIVE:
+                return advance(false);
+            case State::INIT_EXCLUSIVE:
+                return advance(true);
+            case State::INIT_PREFIXED_EXCLUSIVE:
+                return advance_to_next_neighbor();
+            case State::CONTINUE:
+                return advance(true);
+            case State::END:
+                return false;
+        }
+        std::abort();
+    }
+
+    void bind(ScanRange const& range) {
+        end_key_ = range.end_kind == EndPointKind::UNBOUND ? Slice {} : range.end_key;
+        end_type_ = interpret_end_kind(range.end_kind);
+        seek(range.begin_key, range.begin_kind);
+    }
 
     bool advance(bool exclusive) {
         auto [key, value] = owner_->next(next_key_, exclusive);
@@ -20,6 +20,8 @@
 #include <shared_mutex>
 
 #include "Database.h"
+#include "pinned_buffers.h"
+#include "transaction_timer.h"
 
 namespace sharksfin::memory {
 
@@ -152,11 +154,29 @@ public:
     inline bool readonly() const noexcept {
         return shared_lock_.mutex() != nullptr;
     }
+
+    /**
+     * @brief returns the buffers for the pinned reads.
+     * @return the pinned buffers, which are released when this transaction is destroyed
+     */
+    inline common::pinned_buffers& pinned_buffers() noexcept {
+        return pinned_buffers_;
+    }
+
+    /**
+     * @brief returns the timestamps of the transaction lifecycle.
+     * @return the transaction timer
+     */
+    inline common::transaction_timer& timer() noexcept {
+        return timer_;
+    }
 private:
     Database* owner_;
     Database::transaction_id_type id_;
     std::unique_lock<Database::transaction_mutex_type> lock_;
     std::shared_lock<Database::transaction_mutex_type> shared_lock_;
+    common::pinned_buffers pinned_buffers_ {};
+    common::transaction_timer timer_ {};
 
     bool enable_lock() const noexcept {
         return lock_.mutex() != nullptr || shared_lock_.mutex() != nullptr;
@@ -71,6 +71,22 @@ StatusCode database_register_durability_callback(DatabaseHandle handle, durabili
     return rc;
 }
 
+StatusCode database_get_metrics(DatabaseHandle handle, MetricsSnapshot& result) {
+    log_entry << fn_name << " handle:" << handle;
+    auto rc = impl::database_get_metrics(handle, result);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode database_get_hot_keys(DatabaseHandle handle, std::vector<HotKey>& result) {
+    log_entry << fn_name << " handle:" << handle;
+    auto rc = impl::database_get_hot_keys(handle, result);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc << " result.size():" << result.size();
+    return rc;
+}
+
 StatusCode storage_create(DatabaseHandle handle, Slice key, StorageHandle *result) {
     log_entry << fn_name << " handle:" << handle << binstring(key);
     auto rc = impl::storage_create(handle, key, result);
@@ -365,6 +381,57 @@ StatusCode content_get(
     return rc;
 }
 
+StatusCode content_get_partial(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        std::size_t offset,
+        std::size_t length,
+        Slice* result) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage << binstring(key) <<
+        " offset:" << offset << " length:" << length;
+    auto rc = impl::content_get_partial(transaction, storage, key, offset, length, result);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode content_get_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        Slice* results,
+        StatusCode* statuses) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage << " count:" << count;
+    auto rc = impl::content_get_batch(transaction, storage, keys, count, results, statuses);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode content_get_pinned(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        Slice* result) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage << binstring(key);
+    auto rc = impl::content_get_pinned(transaction, storage, key, result);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode content_release(
+        TransactionHandle transaction,
+        Slice content) {
+    log_entry << fn_name << " transaction:" << transaction << binstring(content);
+    auto rc = impl::content_release(transaction, content);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
 StatusCode content_put(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -378,6 +445,21 @@ StatusCode content_put(
     return rc;
 }
 
+StatusCode content_put_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        Slice const* values,
+        PutOperation const* operations,
+        std::size_t count,
+        StatusCode* statuses) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage << " count:" << count;
+    auto rc = impl::content_put_batch(transaction, storage, keys, values, operations, count, statuses);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
 StatusCode content_put_with_blobs(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -407,6 +489,19 @@ StatusCode content_delete(
     return rc;
 }
 
+StatusCode content_delete_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        StatusCode* statuses) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage << " count:" << count;
+    auto rc = impl::content_delete_batch(transaction, storage, keys, count, statuses);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
 StatusCode content_scan_prefix(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -460,6 +555,86 @@ StatusCode content_scan(
     return rc;
 }
 
+StatusCode content_scan_keys(
+    TransactionHandle transaction,
+    StorageHandle storage,
+    Slice begin_key, EndPointKind begin_kind,
+    Slice end_key, EndPointKind end_kind,
+    IteratorHandle* result,
+    std::size_t limit,
+    bool reverse) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage <<
+        binstring(begin_key) << " begin_kind:" << begin_kind <<
+        binstring(end_key) << " end_kind:" << end_kind <<
+        " limit:" << limit << " reverse:" << reverse;
+    auto rc = impl::content_scan_keys(
+        transaction,
+        storage,
+        begin_key, begin_kind,
+        end_key, end_kind,
+        result, limit, reverse);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc << " result:" << *result;
+    return rc;
+}
+
+StatusCode content_scan_multi(
+    TransactionHandle transaction,
+    StorageHandle storage,
+    ScanRange const* ranges,
+    std::size_t count,
+    IteratorHandle* result) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage << " count:" << count;
+    auto rc = impl::content_scan_multi(transaction, storage, ranges, count, result);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc << " result:" << *result;
+    return rc;
+}
+
+StatusCode storage_estimate_split_points(
+    TransactionHandle transaction,
+    StorageHandle storage,
+    Slice begin_key, EndPointKind begin_kind,
+    Slice end_key, EndPointKind end_kind,
+    std::size_t partitions,
+    std::vector<std::string>& out) {
+    log_entry << fn_name << " transaction:" << transaction << " storage:" << storage <<
+        binstring(begin_key) << " begin_kind:" << begin_kind <<
+        binstring(end_key) << " end_kind:" << end_kind <<
+        " partitions:" << partitions;
+    auto rc = impl::storage_estimate_split_points(
+        transaction,
+        storage,
+        begin_key, begin_kind,
+        end_key, end_kind,
+        partitions, out);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc << " #out:" << out.size();
+    return rc;
+}
+
+StatusCode content_scan_partitioned(
+    TransactionHandle const* transactions,
+    StorageHandle storage,
+    Slice begin_key, EndPointKind begin_kind,
+    Slice end_key, EndPointKind end_kind,
+    std::vector<std::string> const& split_points,
+    IteratorHandle* results) {
+    log_entry << fn_name << " storage:" << storage <<
+        binstring(begin_key) << " begin_kind:" << begin_kind <<
+        binstring(end_key) << " end_kind:" << end_kind <<
+        " #split_points:" << split_points.size();
+    auto rc = impl::content_scan_partitioned(
+        transactions,
+        storage,
+        begin_key, begin_kind,
+        end_key, end_kind,
+        split_points, results);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
 StatusCode iterator_next(IteratorHandle handle) {
     log_entry << fn_name << " handle:" << handle;
     auto rc = impl::iterator_next(handle);
@@ -468,6 +643,29 @@ StatusCode iterator_next(IteratorHandle handle) {
     return rc;
 }
 
+StatusCode iterator_next_batch(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        std::size_t max_bytes,
+        IteratorBatch* out) {
+    log_entry << fn_name << " handle:" << handle << " max_rows:" << max_rows << " max_bytes:" << max_bytes;
+    auto rc = impl::iterator_next_batch(handle, max_rows, max_bytes, out);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc << " row_count:" << out->row_count << " data_size:" << out->data_size;
+    return rc;
+}
+
+StatusCode iterator_next_columns(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        IteratorColumns* out) {
+    log_entry << fn_name << " handle:" << handle << " max_rows:" << max_rows;
+    auto rc = impl::iterator_next_columns(handle, max_rows, out);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc << " row_count:" << out->row_count;
+    return rc;
+}
+
 StatusCode iterator_get_key(IteratorHandle handle, Slice* result) {
     log_entry << fn_name << " handle:" << handle;
     auto rc = impl::iterator_get_key(handle, result);
@@ -484,6 +682,51 @@ StatusCode iterator_get_value(IteratorHandle handle, Slice* result) {
     return rc;
 }
 
+StatusCode iterator_set_value_window(IteratorHandle handle, std::size_t offset, std::size_t length) {
+    log_entry << fn_name << " handle:" << handle << " offset:" << offset << " length:" << length;
+    auto rc = impl::iterator_set_value_window(handle, offset, length);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode iterator_set_read_ahead(IteratorHandle handle, std::size_t rows) {
+    log_entry << fn_name << " handle:" << handle << " rows:" << rows;
+    auto rc = impl::iterator_set_read_ahead(handle, rows);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode iterator_set_filter(IteratorHandle handle, ScanFilter filter, void* context) {
+    log_entry << fn_name << " handle:" << handle << " filter:" << reinterpret_cast<void*>(filter) << " context:" << context;  //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto rc = impl::iterator_set_filter(handle, filter, context);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode iterator_seek(IteratorHandle handle, Slice key, EndPointKind kind) {
+    log_entry << fn_name << " handle:" << handle << binstring(key) << " kind:" << kind;
+    auto rc = impl::iterator_seek(handle, key, kind);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
+StatusCode iterator_rebind(
+    IteratorHandle handle,
+    Slice begin_key, EndPointKind begin_kind,
+    Slice end_key, EndPointKind end_kind) {
+    log_entry << fn_name << " handle:" << handle <<
+        binstring(begin_key) << " begin_kind:" << begin_kind <<
+        binstring(end_key) << " end_kind:" << end_kind;
+    auto rc = impl::iterator_rebind(handle, begin_key, begin_kind, end_key, end_kind);
+    log_rc(rc, fn_name);
+    log_exit << fn_name << " rc:" << rc;
+    return rc;
+}
+
 StatusCode iterator_dispose(IteratorHandle handle) {
     log_entry << fn_name << " handle:" << handle;
     auto rc = impl::iterator_dispose(handle);
@@ -22,11 +22,17 @@
 #include "Iterator.h"
 #include "Storage.h"
 #include "TransactionContext.h"
+#include "batch_writer.h"
+#include "api_trace.h"
+#include "flight_recorder.h"
+#include "hot_key_tracker.h"
+#include "metrics.h"
 
 namespace sharksfin {
 
 static inline constexpr std::string_view KEY_TRANSACTION_LOCK { "lock" };  // NOLINT
 static inline constexpr bool DEFAULT_TRANSACTION_LOCK = true;
+static inline constexpr std::string_view KEY_PERFORMANCE_TRACKING { "perf" };  // NOLINT
 
 static inline DatabaseHandle wrap(memory::Database* object) {
     return reinterpret_cast<DatabaseHandle>(object);  // NOLINT
@@ -83,6 +89,24 @@ static inline StatusCode parse_option(std::optional<std::string> const& option,
     return StatusCode::OK;
 }
 
+// runs the operation and records its latency into the metrics
+template<class Operation>
+static StatusCode tracked(common::metrics& metrics, MetricsOperation kind, Operation&& operation) {
+    auto started = metrics.start();
+    auto rc = operation();
+    metrics.record(kind, started, rc);
+    return rc;
+}
+
+// marks the transaction committed - sharksfin-memory doesn't support durability, so it is durable at the same time
+static void finish_commit(memory::TransactionContext& tx, common::metrics& metrics) {
+    auto& timer = tx.timer();
+    auto now = common::transaction_timer::clock::now();
+    timer.mark(TransactionEvent::COMMIT_DONE, now);
+    timer.mark(TransactionEvent::DURABLE, now);
+    metrics.record_phases(timer.timings());
+}
+
 namespace impl {
 
 StatusCode database_open([[maybe_unused]] DatabaseOptions const& options, DatabaseHandle* result) {
@@ -91,8 +115,19 @@ StatusCode database_open([[maybe_unused]] DatabaseOptions const& options, Databa
         return s;
     }
 
+    bool tracking = false;
+    if (auto s = parse_option(options.attribute(KEY_PERFORMANCE_TRACKING), tracking); s != StatusCode::OK) {
+        return s;
+    }
     auto db = std::make_unique<memory::Database>();
+    if (auto s = db->flight_recorder().configure(options); s != StatusCode::OK) {
+        return s;
+    }
+    if (auto s = db->hot_keys().configure(options); s != StatusCode::OK) {
+        return s;
+    }
     db->enable_transaction_lock(transaction_lock);
+    db->metrics().enabled(tracking);
     *result = wrap(db.release());
     return StatusCode::OK;
 }
@@ -118,6 +153,18 @@ StatusCode database_register_durability_callback(DatabaseHandle handle, durabili
     return StatusCode::OK;
 }
 
+StatusCode database_get_metrics(DatabaseHandle handle, MetricsSnapshot& result) {
+    auto db = unwrap(handle);
+    db->metrics().snapshot(result);
+    return StatusCode::OK;
+}
+
+StatusCode database_get_hot_keys(DatabaseHandle handle, std::vector<HotKey>& result) {
+    auto db = unwrap(handle);
+    db->hot_keys().snapshot(result);
+    return StatusCode::OK;
+}
+
 StatusCode storage_create(DatabaseHandle handle, Slice key, StorageHandle *result) {
     return impl::storage_create(handle, key, {}, result);
 }
@@ -259,17 +306,26 @@ StatusCode transaction_exec(
     bool readonly =
         options.transaction_type() == TransactionOptions::TransactionType::READ_ONLY;
     auto database = unwrap(handle);
-    auto tx = database->create_transaction(readonly);
-    tx->acquire();
-    auto status = callback(wrap(tx.get()), arguments);
-    if (status == TransactionOperation::COMMIT) {
-        return StatusCode::OK;
-    }
-    // NOTE: may be broken because rollback operations are not supported
-    if (status == TransactionOperation::ROLLBACK) {
-        return StatusCode::USER_ROLLBACK;
+    // commit never fails in this implementation, so that only TransactionOperation::RETRY is retried
+    for (std::size_t retry = 0; ; ++retry) {
+        auto tx = database->create_transaction(readonly);
+        tx->acquire();
+        auto status = callback(wrap(tx.get()), arguments);
+        if (status == TransactionOperation::COMMIT) {
+            return StatusCode::OK;
+        }
+        // NOTE: may be broken because rollback operations are not supported
+        if (status == TransactionOperation::ROLLBACK) {
+            return StatusCode::USER_ROLLBACK;
+        }
+        if (status != TransactionOperation::RETRY) {
+            return StatusCode::ERR_USER_ERROR;
+        }
+        if (retry >= options.retry_count()) {
+            return StatusCode::ERR_ABORTED_RETRYABLE;
+        }
+        database->metrics().record_retry();
     }
-    return StatusCode::ERR_USER_ERROR;
 }
 
 StatusCode transaction_borrow_owner(TransactionHandle handle, DatabaseHandle* result) {
@@ -288,18 +344,24 @@ StatusCode transaction_begin(
     bool readonly =
         options.transaction_type() == TransactionOptions::TransactionType::READ_ONLY;
     auto database = unwrap(handle);
-    auto tx = database->create_transaction(readonly);
-    tx->acquire();
-    *result = wrap_as_control_handle(tx.release());
-    return StatusCode::OK;
+    return tracked(database->metrics(), MetricsOperation::BEGIN, [&]() {
+        auto requested = common::transaction_timer::clock::now();
+        auto tx = database->create_transaction(readonly);
+        tx->timer().mark(TransactionEvent::BEGIN_REQUESTED, requested);
+        tx->acquire();
+        tx->timer().mark(TransactionEvent::STARTED);
+        database->flight_recorder().record(
+            common::flight_event_kind::transaction_begin, tx.get(), options.transaction_type(), StatusCode::OK);
+        *result = wrap_as_control_handle(tx.release());
+        return StatusCode::OK;
+    });
 }
 
 StatusCode transaction_get_info(
     TransactionControlHandle handle,
     std::shared_ptr<TransactionInfo>& result) {
     auto tx = unwrap(handle);
-    if (! tx->is_alive()) return StatusCode::ERR_INACTIVE_TRANSACTION;
-    result = std::make_shared<TransactionInfo>(std::to_string(tx->id()));
+    result = std::make_shared<TransactionInfo>(std::to_string(tx->id()), tx->timer().timings());
     return StatusCode::OK;
 }
 
@@ -326,11 +388,19 @@ StatusCode transaction_commit(
         [[maybe_unused]] bool async) { // async not supported
     auto tx = unwrap(handle);
     if (! tx->is_alive()) return StatusCode::ERR_INACTIVE_TRANSACTION;
-    if (tx->release()) {
-        return StatusCode::OK;
-    }
-    // transaction is already finished
-    return StatusCode::ERR_INVALID_STATE;
+    tx->timer().mark(TransactionEvent::COMMIT_REQUESTED);
+    auto* db = tx->owner();
+    auto& metrics = db->metrics();
+    auto rc = tracked(metrics, MetricsOperation::COMMIT, [&]() {
+        if (tx->release()) {
+            finish_commit(*tx, metrics);
+            return StatusCode::OK;
+        }
+        // transaction is already finished
+        return StatusCode::ERR_INVALID_STATE;
+    });
+    db->flight_recorder().record(common::flight_event_kind::transaction_commit, tx, rc, ErrorCode::OK);
+    return rc;
 }
 
 bool transaction_commit_with_callback(
@@ -341,11 +411,21 @@ bool transaction_commit_with_callback(
         callback(StatusCode::ERR_INACTIVE_TRANSACTION, ErrorCode::ERROR, zero_marker);
         return true;
     }
+    tx->timer().mark(TransactionEvent::COMMIT_REQUESTED);
+    auto* db = tx->owner();
+    auto& metrics = db->metrics();
+    auto started = metrics.start();
     if (tx->release()) {
+        finish_commit(*tx, metrics);
+        metrics.record(MetricsOperation::COMMIT, started, StatusCode::OK);
+        db->flight_recorder().record(
+            common::flight_event_kind::transaction_commit, tx, StatusCode::OK, ErrorCode::OK);
         callback(StatusCode::OK, ErrorCode::OK, zero_marker);
         return true;
     }
     // transaction is already finished
+    db->flight_recorder().record(
+        common::flight_event_kind::transaction_commit, tx, StatusCode::ERR_INVALID_STATE, ErrorCode::ERROR);
     callback(StatusCode::ERR_INVALID_STATE, ErrorCode::ERROR, zero_marker);
     return true;
 }
@@ -354,6 +434,13 @@ StatusCode transaction_abort(
         TransactionControlHandle handle,
         [[maybe_unused]] bool rollback) {
     auto tx = unwrap(handle);
+    if (auto db = tx->owner()) {
+        db->flight_recorder().record(common::flight_event_kind::transaction_abort, tx, StatusCode::OK);
+        auto started = db->metrics().start();
+        tx->release();
+        db->metrics().record(MetricsOperation::ABORT, started, StatusCode::OK);
+        return StatusCode::OK;
+    }
     tx->release();
     // No need to check the return value.
     // Abort is allowed even for finished transactions.
@@ -388,6 +475,7 @@ StatusCode content_check_exist(
     StorageHandle storage,
     Slice key) {
     auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
     auto st = unwrap(storage);
     if (!tx->is_alive()) {
         return StatusCode::ERR_INACTIVE_TRANSACTION;
@@ -405,16 +493,99 @@ StatusCode content_get(
         Slice key,
         Slice* result) {
     auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
+    auto st = unwrap(storage);
+    auto& metrics = st->owner()->metrics();
+    metrics.record_storage(st->key().to_string_view(), MetricsOperation::GET);
+    return tracked(metrics, MetricsOperation::GET, [&]() {
+        if (!tx->is_alive()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        auto buffer = st->get(key);
+        if (buffer) {
+            *result = buffer->to_slice();
+            return StatusCode::OK;
+        }
+        return StatusCode::NOT_FOUND;
+    });
+}
+
+StatusCode content_get_partial(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        std::size_t offset,
+        std::size_t length,
+        Slice* result) {
+    auto rc = impl::content_get(transaction, storage, key, result);
+    if (rc == StatusCode::OK) {
+        *result = result->subslice(offset, length);
+    }
+    return rc;
+}
+
+StatusCode content_get_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        Slice* results,
+        StatusCode* statuses) {
+    auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
     auto st = unwrap(storage);
     if (!tx->is_alive()) {
         return StatusCode::ERR_INACTIVE_TRANSACTION;
     }
-    auto buffer = st->get(key);
-    if (buffer) {
-        *result = buffer->to_slice();
+    auto& metrics = st->owner()->metrics();
+    for (std::size_t i = 0; i < count; ++i) {
+        metrics.record_storage(st->key().to_string_view(), MetricsOperation::GET);
+        statuses[i] = tracked(metrics, MetricsOperation::GET, [&]() {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto buffer = st->get(keys[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (buffer) {
+                results[i] = buffer->to_slice();  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                return StatusCode::OK;
+            }
+            return StatusCode::NOT_FOUND;
+        });
+    }
+    return StatusCode::OK;
+}
+
+StatusCode content_get_pinned(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        Slice* result) {
+    auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
+    auto st = unwrap(storage);
+    auto& metrics = st->owner()->metrics();
+    metrics.record_storage(st->key().to_string_view(), MetricsOperation::GET);
+    return tracked(metrics, MetricsOperation::GET, [&]() {
+        if (!tx->is_alive()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        auto buffer = st->get(key);
+        if (! buffer) {
+            return StatusCode::NOT_FOUND;
+        }
+        // the stored value may be overwritten by the later operations, so that keep a copy
+        auto& pinned = tx->pinned_buffers().acquire();
+        buffer->to_slice().assign_to(pinned);
+        *result = pinned;
         return StatusCode::OK;
+    });
+}
+
+StatusCode content_release(
+        TransactionHandle transaction,
+        Slice content) {
+    auto tx = unwrap(transaction);
+    if (! tx->pinned_buffers().release(content.data())) {
+        return StatusCode::NOT_FOUND;
     }
-    return StatusCode::NOT_FOUND;
+    return StatusCode::OK;
 }
 
 StatusCode content_put(
@@ -424,31 +595,61 @@ StatusCode content_put(
         Slice value,
         PutOperation operation) {
     auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
     auto st = unwrap(storage);
-    if (!tx->is_alive()) {
-        return StatusCode::ERR_INACTIVE_TRANSACTION;
-    }
-    if (tx->readonly()) {
-        return StatusCode::ERR_ILLEGAL_OPERATION;
-    }
-    switch (operation) {
-        case PutOperation::CREATE:
-            if (st->create(key, value)) {
-                return StatusCode::OK;
-            }
-            return StatusCode::ALREADY_EXISTS;
-        case PutOperation::UPDATE:
-            if (st->update(key, value)) {
-                return StatusCode::OK;
-            }
-            return StatusCode::NOT_FOUND;
-        case PutOperation::CREATE_OR_UPDATE:
-            if (st->create(key, value) || st->update(key, value)) {
-                return StatusCode::OK;
+    auto& metrics = st->owner()->metrics();
+    metrics.record_storage(st->key().to_string_view(), MetricsOperation::PUT);
+    return tracked(metrics, MetricsOperation::PUT, [&]() {
+        if (!tx->is_alive()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        if (tx->readonly()) {
+            return StatusCode::ERR_ILLEGAL_OPERATION;
+        }
+        switch (operation) {
+            case PutOperation::CREATE:
+                if (st->create(key, value)) {
+                    return StatusCode::OK;
+                }
+                return StatusCode::ALREADY_EXISTS;
+            case PutOperation::UPDATE:
+                if (st->update(key, value)) {
+                    return StatusCode::OK;
+                }
+                return StatusCode::NOT_FOUND;
+            case PutOperation::CREATE_OR_UPDATE:
+                if (st->create(key, value) || st->update(key, value)) {
+                    return StatusCode::OK;
+                }
+                return StatusCode::ERR_INVALID_STATE;
+        }
+        std::abort();
+    });
+}
+
+static bool is_error(StatusCode rc) noexcept {
+    return static_cast<std::int64_t>(rc) < 0;
+}
+
+StatusCode content_put_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        Slice const* values,
+        PutOperation const* operations,
+        std::size_t count,
+        StatusCode* statuses) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto rc = impl::content_put(transaction, storage, keys[i], values[i], operations[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        statuses[i] = rc;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (is_error(rc)) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                statuses[j] = rc;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
             }
-            return StatusCode::ERR_INVALID_STATE;
+            return rc;
+        }
     }
-    std::abort();
+    return StatusCode::OK;
 }
 
 StatusCode content_delete(
@@ -456,17 +657,41 @@ StatusCode content_delete(
         StorageHandle storage,
         Slice key) {
     auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
     auto st = unwrap(storage);
-    if (!tx->is_alive()) {
-        return StatusCode::ERR_INACTIVE_TRANSACTION;
-    }
-    if (tx->readonly()) {
-        return StatusCode::ERR_ILLEGAL_OPERATION;
-    }
-    if (st->remove(key)) {
-        return StatusCode::OK;
+    auto& metrics = st->owner()->metrics();
+    metrics.record_storage(st->key().to_string_view(), MetricsOperation::DELETE);
+    return tracked(metrics, MetricsOperation::DELETE, [&]() {
+        if (!tx->is_alive()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        if (tx->readonly()) {
+            return StatusCode::ERR_ILLEGAL_OPERATION;
+        }
+        if (st->remove(key)) {
+            return StatusCode::OK;
+        }
+        return StatusCode::NOT_FOUND;
+    });
+}
+
+StatusCode content_delete_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        StatusCode* statuses) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto rc = impl::content_delete(transaction, storage, keys[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        statuses[i] = rc;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (is_error(rc)) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                statuses[j] = rc;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            return rc;
+        }
     }
-    return StatusCode::NOT_FOUND;
+    return StatusCode::OK;
 }
 
 StatusCode content_scan_prefix(
@@ -475,6 +700,7 @@ StatusCode content_scan_prefix(
         Slice prefix_key,
         IteratorHandle* result) {
     auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
     auto st = unwrap(storage);
     if (!tx->is_alive()) {
         return StatusCode::ERR_INACTIVE_TRANSACTION;
@@ -483,6 +709,7 @@ StatusCode content_scan_prefix(
             st,
             prefix_key, EndPointKind::PREFIXED_INCLUSIVE,
             prefix_key, EndPointKind::PREFIXED_INCLUSIVE, false); // this api is deprecated and reverse is not supported
+    iterator->readonly(tx->readonly());
     *result = wrap(iterator.release());
     return StatusCode::OK;
 }
@@ -494,6 +721,7 @@ StatusCode content_scan_range(
         Slice end_key, bool end_exclusive,
         IteratorHandle* result) {
     auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
     auto st = unwrap(storage);
     if (!tx->is_alive()) {
         return StatusCode::ERR_INACTIVE_TRANSACTION;
@@ -506,10 +734,40 @@ StatusCode content_scan_range(
         end_key.empty() ? EndPointKind::UNBOUND
                         : (end_exclusive ? EndPointKind::EXCLUSIVE : EndPointKind::INCLUSIVE), //NOLINT(readability-avoid-nested-conditional-operator)
         false); // this api is deprecated and reverse is not supported
+    iterator->readonly(tx->readonly());
     *result = wrap(iterator.release());
     return StatusCode::OK;
 }
 
+static StatusCode scan(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        IteratorHandle* result,
+        std::size_t limit,
+        bool reverse,
+        bool key_only) {
+    auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
+    auto st = unwrap(storage);
+    auto& metrics = st->owner()->metrics();
+    metrics.record_storage(st->key().to_string_view(), MetricsOperation::SCAN_OPEN);
+    return tracked(metrics, MetricsOperation::SCAN_OPEN, [&]() {
+        if (!tx->is_alive()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        auto iterator = std::make_unique<memory::Iterator>(
+                st,
+                begin_key, begin_kind,
+                end_key, end_kind, limit, reverse, key_only);
+        iterator->readonly(tx->readonly());
+        st->owner()->flight_recorder().record(common::flight_event_kind::scan_open, tx, iterator.get());
+        *result = wrap(iterator.release());
+        return StatusCode::OK;
+    });
+}
+
 StatusCode content_scan(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -518,25 +776,165 @@ StatusCode content_scan(
         IteratorHandle* result,
         std::size_t limit,
         bool reverse) {
+    return scan(transaction, storage, begin_key, begin_kind, end_key, end_kind, result, limit, reverse, false);
+}
+
+StatusCode content_scan_keys(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        IteratorHandle* result,
+        std::size_t limit,
+        bool reverse) {
+    return scan(transaction, storage, begin_key, begin_kind, end_key, end_kind, result, limit, reverse, true);
+}
+
+StatusCode content_scan_multi(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        ScanRange const* ranges,
+        std::size_t count,
+        IteratorHandle* result) {
+    auto tx = unwrap(transaction);
+    tx->timer().mark(TransactionEvent::FIRST_OPERATION);
+    auto st = unwrap(storage);
+    auto& metrics = st->owner()->metrics();
+    metrics.record_storage(st->key().to_string_view(), MetricsOperation::SCAN_OPEN);
+    return tracked(metrics, MetricsOperation::SCAN_OPEN, [&]() {
+        if (!tx->is_alive()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        auto iterator = std::make_unique<memory::Iterator>(st, ranges, count);
+        iterator->readonly(tx->readonly());
+        st->owner()->flight_recorder().record(common::flight_event_kind::scan_open, tx, iterator.get());
+        *result = wrap(iterator.release());
+        return StatusCode::OK;
+    });
+}
+
+StatusCode storage_estimate_split_points(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::size_t partitions,
+        std::vector<std::string>& out) {
     auto tx = unwrap(transaction);
     auto st = unwrap(storage);
     if (!tx->is_alive()) {
         return StatusCode::ERR_INACTIVE_TRANSACTION;
     }
-    auto iterator = std::make_unique<memory::Iterator>(
-            st,
-            begin_key, begin_kind,
-            end_key, end_kind, limit, reverse);
-    *result = wrap(iterator.release());
+    if (partitions == 0) {
+        return StatusCode::ERR_INVALID_ARGUMENT;
+    }
+    out.clear();
+    // count the entries in the range, and then pick the keys at the partition boundaries
+    std::size_t count = 0;
+    {
+        memory::Iterator iterator{st, begin_key, begin_kind, end_key, end_kind, 0, false, true};
+        while (iterator.next()) {
+            ++count;
+        }
+    }
+    memory::Iterator iterator{st, begin_key, begin_kind, end_key, end_kind, 0, false, true};
+    std::size_t position = 0;
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < partitions; ++i) {
+        auto index = i * count / partitions;
+        if (index == last) {
+            continue;
+        }
+        while (position <= index) {
+            iterator.next();
+            ++position;
+        }
+        out.emplace_back(iterator.key().to_string_view());
+        last = index;
+    }
+    return StatusCode::OK;
+}
+
+StatusCode content_scan_partitioned(
+        TransactionHandle const* transactions,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::vector<std::string> const& split_points,
+        IteratorHandle* results) {
+    auto partitions = split_points.size() + 1;
+    for (std::size_t i = 0; i < partitions; ++i) {
+        auto first = i == 0;
+        auto last = i == partitions - 1;
+        auto rc = impl::content_scan(
+            transactions[i],  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            storage,
+            first ? begin_key : Slice{split_points[i - 1]},
+            first ? begin_kind : EndPointKind::INCLUSIVE,
+            last ? end_key : Slice{split_points[i]},
+            last ? end_kind : EndPointKind::EXCLUSIVE,
+            &results[i],  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            0,
+            false);
+        if (rc != StatusCode::OK) {
+            for (std::size_t j = 0; j < i; ++j) {
+                impl::iterator_dispose(results[j]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            return rc;
+        }
+    }
     return StatusCode::OK;
 }
 
 StatusCode iterator_next(IteratorHandle handle) {
     auto iterator = unwrap(handle);
-    if (iterator->next()) {
-        return StatusCode::OK;
+    return tracked(iterator->owner()->owner()->metrics(), MetricsOperation::NEXT, [&]() {
+        if (iterator->next()) {
+            return StatusCode::OK;
+        }
+        return StatusCode::NOT_FOUND;
+    });
+}
+
+// advances the iterator and appends the subsequent entries into the writer
+template<class Writer>
+static StatusCode fetch_rows(memory::Iterator& iterator, std::size_t max_rows, Writer& writer) {
+    if (max_rows == 0) {
+        return StatusCode::ERR_INVALID_ARGUMENT;
     }
-    return StatusCode::NOT_FOUND;
+    while (writer.size() < max_rows) {
+        if (! iterator.next()) {
+            return writer.size() > 0 ? StatusCode::OK : StatusCode::NOT_FOUND;
+        }
+        if (! writer.append(iterator.key(), iterator.key_only() ? Slice{} : iterator.payload())) {
+            iterator.hold();
+            return writer.size() > 0 ? StatusCode::OK : StatusCode::ERR_RESOURCE_LIMIT_REACHED;
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode iterator_next_batch(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        std::size_t max_bytes,
+        IteratorBatch* out) {
+    auto iterator = unwrap(handle);
+    common::row_batch_writer writer{*out, max_bytes};
+    return tracked(iterator->owner()->owner()->metrics(), MetricsOperation::NEXT, [&]() {
+        return fetch_rows(*iterator, max_rows, writer);
+    });
+}
+
+StatusCode iterator_next_columns(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        IteratorColumns* out) {
+    auto iterator = unwrap(handle);
+    common::column_batch_writer writer{*out};
+    return tracked(iterator->owner()->owner()->metrics(), MetricsOperation::NEXT, [&]() {
+        return fetch_rows(*iterator, max_rows, writer);
+    });
 }
 
 StatusCode iterator_get_key(IteratorHandle handle, Slice* result) {
@@ -550,6 +948,9 @@ StatusCode iterator_get_key(IteratorHandle handle, Slice* result) {
 
 StatusCode iterator_get_value(IteratorHandle handle, Slice* result) {
     auto iterator = unwrap(handle);
+    if (iterator->key_only()) {
+        return StatusCode::ERR_ILLEGAL_OPERATION;
+    }
     if (!iterator->is_valid()) {
         return StatusCode::ERR_INVALID_STATE;
     }
@@ -557,8 +958,43 @@ StatusCode iterator_get_value(IteratorHandle handle, Slice* result) {
     return StatusCode::OK;
 }
 
+StatusCode iterator_set_value_window(IteratorHandle handle, std::size_t offset, std::size_t length) {
+    auto iterator = unwrap(handle);
+    iterator->value_window(offset, length);
+    return StatusCode::OK;
+}
+
+StatusCode iterator_set_read_ahead(IteratorHandle handle, std::size_t rows) {
+    auto iterator = unwrap(handle);
+    return iterator->read_ahead(rows);
+}
+
+StatusCode iterator_set_filter(IteratorHandle handle, ScanFilter filter, void* context) {
+    auto iterator = unwrap(handle);
+    return iterator->filter(filter, context);
+}
+
+StatusCode iterator_seek(IteratorHandle handle, Slice key, EndPointKind kind) {
+    auto iterator = unwrap(handle);
+    if (iterator->multi_range()) {
+        return StatusCode::ERR_ILLEGAL_OPERATION;
+    }
+    iterator->seek(key, kind);
+    return StatusCode::OK;
+}
+
+StatusCode iterator_rebind(
+        IteratorHandle handle,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind) {
+    auto iterator = unwrap(handle);
+    iterator->rebind(begin_key, begin_kind, end_key, end_kind);
+    return StatusCode::OK;
+}
+
 StatusCode iterator_dispose(IteratorHandle handle) {
     auto iterator = unwrap(handle);
+    iterator->database()->flight_recorder().record(common::flight_event_kind::scan_close, iterator);
     delete iterator;  // NOLINT
     return StatusCode::OK;
 }
@@ -631,8 +1067,11 @@ StatusCode implementation_get_datastore(
     return StatusCode::ERR_UNSUPPORTED;
 }
 
-void print_diagnostics(std::ostream&) {
-    // memory bridge has no diag to print
+void print_diagnostics(std::ostream& os) {
+    common::metrics::print_diagnostics(os);
+    common::hot_key_tracker::print_diagnostics(os);
+    common::print_api_trace(os);
+    common::flight_recorder::print(os);
 }
 
 }  // namespace impl
@@ -34,6 +34,10 @@ StatusCode database_dispose(DatabaseHandle handle);
 
 StatusCode database_register_durability_callback(DatabaseHandle handle, durability_callback_type cb);
 
+StatusCode database_get_metrics(DatabaseHandle handle, MetricsSnapshot& result);
+
+StatusCode database_get_hot_keys(DatabaseHandle handle, std::vector<HotKey>& result);
+
 StatusCode storage_create(DatabaseHandle handle, Slice key, StorageHandle *result);
 
 StatusCode storage_create(
@@ -155,6 +159,32 @@ StatusCode content_get(
         Slice key,
         Slice* result);
 
+StatusCode content_get_partial(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        std::size_t offset,
+        std::size_t length,
+        Slice* result);
+
+StatusCode content_get_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        Slice* results,
+        StatusCode* statuses);
+
+StatusCode content_get_pinned(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        Slice* result);
+
+StatusCode content_release(
+        TransactionHandle transaction,
+        Slice content);
+
 StatusCode content_put(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -162,11 +192,27 @@ StatusCode content_put(
         Slice value,
         PutOperation operation);
 
+StatusCode content_put_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        Slice const* values,
+        PutOperation const* operations,
+        std::size_t count,
+        StatusCode* statuses);
+
 StatusCode content_delete(
         TransactionHandle transaction,
         StorageHandle storage,
         Slice key);
 
+StatusCode content_delete_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        StatusCode* statuses);
+
 StatusCode content_scan_prefix(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -189,12 +235,68 @@ StatusCode content_scan(
         std::size_t limit,
         bool reverse);
 
+StatusCode content_scan_keys(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        IteratorHandle* result,
+        std::size_t limit,
+        bool reverse);
+
+StatusCode content_scan_multi(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        ScanRange const* ranges,
+        std::size_t count,
+        IteratorHandle* result);
+
+StatusCode storage_estimate_split_points(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::size_t partitions,
+        std::vector<std::string>& out);
+
+StatusCode content_scan_partitioned(
+        TransactionHandle const* transactions,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::vector<std::string> const& split_points,
+        IteratorHandle* results);
+
 StatusCode iterator_next(IteratorHandle handle);
 
+StatusCode iterator_next_batch(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        std::size_t max_bytes,
+        IteratorBatch* out);
+
+StatusCode iterator_next_columns(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        IteratorColumns* out);
+
 StatusCode iterator_get_key(IteratorHandle handle, Slice* result);
 
 StatusCode iterator_get_value(IteratorHandle handle, Slice* result);
 
+StatusCode iterator_set_value_window(IteratorHandle handle, std::size_t offset, std::size_t length);
+
+StatusCode iterator_set_read_ahead(IteratorHandle handle, std::size_t rows);
+
+StatusCode iterator_set_filter(IteratorHandle handle, ScanFilter filter, void* context);
+
+StatusCode iterator_seek(IteratorHandle handle, Slice key, EndPointKind kind);
+
+StatusCode iterator_rebind(
+        IteratorHandle handle,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind);
+
 StatusCode iterator_dispose(IteratorHandle handle);
 
 StatusCode sequence_create(
@@ -18,12 +18,33 @@
 #include <cstdint>
 
 #define fn_name __func__ /* NOLINT */
+
+#ifdef SHARKSFIN_API_TRACE
+
+#include "api_trace.h"
+
+// record compact binary events into the per-thread trace buffers instead of formatting messages
+#define log_entry ::sharksfin::common::api_trace_writer{::sharksfin::common::api_trace_kind::entry, __func__}  //NOLINT
+#define log_exit ::sharksfin::common::api_trace_writer{::sharksfin::common::api_trace_kind::exit, __func__}  //NOLINT
+#define log_rc(rc, fname) do { /*NOLINT*/  \
+    if((rc) != StatusCode::OK) { \
+        ::sharksfin::common::api_trace_writer{::sharksfin::common::api_trace_kind::status, __func__} << (rc); /*NOLINT*/ \
+    } \
+} while(0);
+
+#define binstring(arg) (arg).size()  //NOLINT
+
+#else
+
+// DVLOG compiles to nothing in release builds
 #define log_entry DVLOG(log_trace) << std::boolalpha << "--> "  //NOLINT
 #define log_exit DVLOG(log_trace) << std::boolalpha << "<-- "  //NOLINT
 #define log_rc(rc, fname) do { /*NOLINT*/  \
     if((rc) != StatusCode::OK) { \
-        VLOG(log_trace) << "--- " << (fname) << " rc:" << (rc); /*NOLINT*/ \
+        DVLOG(log_trace) << "--- " << (fname) << " rc:" << (rc); /*NOLINT*/ \
     } \
 } while(0);
 
-#define binstring(arg) " " #arg "(len=" << (arg).size() << "):\"" << common::binary_printer((arg).to_string_view()) << "\"" //NOLINT
\ No newline at end of file
+#define binstring(arg) " " #arg "(len=" << (arg).size() << "):\"" << common::binary_printer((arg).to_string_view()) << "\"" //NOLINT
+
+#endif
@@ -15,13 +15,16 @@
  */
 #include "sharksfin/api.h"
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <future>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -371,6 +374,39 @@ TEST_F(ApiTest, transaction_failed) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ApiTest, transaction_retry_count) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation f(TransactionHandle, void* args) {
+            auto s = reinterpret_cast<S*>(args);
+            ++s->count;
+            return s->count < s->success_at ? TransactionOperation::RETRY : TransactionOperation::COMMIT;
+        }
+        std::size_t count;
+        std::size_t success_at;
+    };
+    {
+        S s{0, 10};
+        EXPECT_EQ(transaction_exec(db, {}, &S::f, &s), StatusCode::ERR_ABORTED_RETRYABLE);
+        EXPECT_EQ(s.count, 1);
+    }
+    {
+        S s{0, 10};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(3), &S::f, &s), StatusCode::ERR_ABORTED_RETRYABLE);
+        EXPECT_EQ(s.count, 4);
+    }
+    {
+        S s{0, 3};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(3), &S::f, &s), StatusCode::OK);
+        EXPECT_EQ(s.count, 3);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 TEST_F(ApiTest, transaction_borrow_owner) {
     DatabaseOptions options;
     DatabaseHandle db;
@@ -512,6 +548,122 @@ TEST_F(ApiTest, contents) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ApiTest, get_batch) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "c", "C") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            std::array<Slice, 4> keys{ "c", "x", "a", "b" };
+            std::array<Slice, 4> results{};
+            std::array<StatusCode, 4> statuses{};
+            if (content_get_batch(tx, st, keys.data(), keys.size(), results.data(), statuses.data()) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[0] != StatusCode::OK || results[0] != "C") {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[1] != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[2] != StatusCode::OK || results[2] != "A") {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[3] != StatusCode::OK || results[3] != "B") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, get_pinned) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice a;
+            if (content_get_pinned(tx, st, "a", &a) != StatusCode::OK || a != "A") {
+                return TransactionOperation::ERROR;
+            }
+            Slice b;
+            if (content_get_pinned(tx, st, "b", &b) != StatusCode::OK || b != "B") {
+                return TransactionOperation::ERROR;
+            }
+            Slice s;
+            if (content_get_pinned(tx, st, "x", &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            // pinned results are not disposed by other operations
+            if (content_put(tx, st, "a", "AA") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get(tx, st, "b", &s) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (a != "A" || b != "B") {
+                return TransactionOperation::ERROR;
+            }
+            if (content_release(tx, a) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_release(tx, a) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (b != "B") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 TEST_F(ApiTest, put_operations) {
     DatabaseOptions options;
     DatabaseHandle db;
@@ -611,6 +763,83 @@ TEST_F(ApiTest, put_operations) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ApiTest, put_delete_batch) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "b", "B0") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation put(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            std::array<Slice, 4> keys{ "c", "b", "a", "b" };
+            std::array<Slice, 4> values{ "C", "B1", "A", "B2" };
+            std::array<PutOperation, 4> operations{
+                PutOperation::CREATE,
+                PutOperation::CREATE,
+                PutOperation::CREATE_OR_UPDATE,
+                PutOperation::UPDATE,
+            };
+            std::array<StatusCode, 4> statuses{};
+            if (content_put_batch(tx, st, keys.data(), values.data(), operations.data(), keys.size(), statuses.data()) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[0] != StatusCode::OK || statuses[1] != StatusCode::ALREADY_EXISTS ||
+                statuses[2] != StatusCode::OK || statuses[3] != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation remove(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice s;
+            if (content_get(tx, st, "b", &s) != StatusCode::OK || s != "B2") {
+                return TransactionOperation::ERROR;
+            }
+            std::array<Slice, 2> keys{ "c", "a" };
+            std::array<StatusCode, 2> statuses{};
+            if (content_delete_batch(tx, st, keys.data(), keys.size(), statuses.data()) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[0] != StatusCode::OK || statuses[1] != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation validate(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice s;
+            if (content_get(tx, st, "a", &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get(tx, st, "c", &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get(tx, st, "b", &s) != StatusCode::OK || s != "B2") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::put, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::remove, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::validate, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 TEST_F(ApiTest, scan_prefix) {
     DatabaseOptions options;
     DatabaseHandle db;
@@ -778,48 +1007,346 @@ TEST_F(ApiTest, scan) {
         }
         static TransactionOperation test(TransactionHandle tx, void* args) {
             auto st = extract<S>(args);
-            IteratorHandle iter;
-            if (content_scan(
-                    tx, st,
-                    "a", EndPointKind::PREFIXED_EXCLUSIVE,
-                    "c", EndPointKind::PREFIXED_INCLUSIVE,
-                    &iter) != StatusCode::OK) {
-                return TransactionOperation::ERROR;
-            }
-            HandleHolder closer { iter };
-
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "a", EndPointKind::PREFIXED_EXCLUSIVE,
+                    "c", EndPointKind::PREFIXED_INCLUSIVE,
+                    &iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+
+            Slice s;
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "b") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "B") {
+                return TransactionOperation::ERROR;
+            }
+
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "c") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "C") {
+                return TransactionOperation::ERROR;
+            }
+
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "c1") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "C1") {
+                return TransactionOperation::ERROR;
+            }
+
+            if (iterator_next(iter) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, scan_batch) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            for (std::string_view k : { "a", "b", "c", "d", "e" }) {
+                std::string v{k};
+                v[0] = static_cast<char>(v[0] - 'a' + 'A');
+                if (content_put(tx, st, k, v) != StatusCode::OK) {
+                    return TransactionOperation::ERROR;
+                }
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "", EndPointKind::UNBOUND,
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+
+            std::array<IteratorBatchEntry, 10> entries{};
+            std::array<char, 100> data{};
+            IteratorBatch batch{entries.data(), data.data(), 0, 0};
+            if (iterator_next_batch(iter, 2, data.size(), &batch) != StatusCode::OK || batch.row_count != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (batch.key(0) != "a" || batch.value(0) != "A" || batch.key(1) != "b" || batch.value(1) != "B") {
+                return TransactionOperation::ERROR;
+            }
+            // "d" does not fit into the rest of buffer, and is kept for the next call
+            if (iterator_next_batch(iter, entries.size(), 3, &batch) != StatusCode::OK || batch.row_count != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (batch.key(0) != "c" || batch.value(0) != "C" || batch.data_size != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_batch(iter, entries.size(), 1, &batch) != StatusCode::ERR_RESOURCE_LIMIT_REACHED) {
+                return TransactionOperation::ERROR;
+            }
+            Slice s;
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "d") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::OK || batch.row_count != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (batch.key(0) != "e" || batch.value(0) != "E") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::NOT_FOUND || batch.row_count != 0) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, scan_columns) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "c", "CCC") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "", EndPointKind::UNBOUND,
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+
+            std::array<std::int64_t, 11> key_offsets{};
+            std::array<char, 100> key_data{};
+            std::array<std::int64_t, 11> value_offsets{};
+            std::array<char, 2> value_data{};
+            IteratorColumns columns{
+                key_offsets.data(), key_data.data(), key_data.size(),
+                value_offsets.data(), value_data.data(), value_data.size(),
+                0,
+            };
+            // "CCC" does not fit into the value buffer
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::OK || columns.row_count != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (key_offsets[0] != 0 || key_offsets[1] != 1 || key_offsets[2] != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (value_offsets[0] != 0 || value_offsets[1] != 1 || value_offsets[2] != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (columns.key(0) != "a" || columns.value(0) != "A" || columns.key(1) != "b" || columns.value(1) != "") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::ERR_RESOURCE_LIMIT_REACHED) {
+                return TransactionOperation::ERROR;
+            }
+            std::array<char, 10> large_value_data{};
+            columns.value_data = large_value_data.data();
+            columns.value_data_capacity = large_value_data.size();
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::OK || columns.row_count != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (columns.key(0) != "c" || columns.value(0) != "CCC") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, scan_keys) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            IteratorHandle iter;
+            if (content_scan_keys(
+                    tx, st,
+                    "", EndPointKind::UNBOUND,
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+
+            Slice s;
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "a") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::ERR_ILLEGAL_OPERATION) {
+                return TransactionOperation::ERROR;
+            }
+
+            std::array<IteratorBatchEntry, 10> entries{};
+            std::array<char, 100> data{};
+            IteratorBatch batch{entries.data(), data.data(), 0, 0};
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::OK || batch.row_count != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (batch.key(0) != "b" || ! batch.value(0).empty()) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next(iter) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, partial_value) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "0123456789") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "ab") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
             Slice s;
-            if (iterator_next(iter) != StatusCode::OK) {
+            if (content_get_partial(tx, st, "a", 2, 3, &s) != StatusCode::OK || s != "234") {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "b") {
+            if (content_get_partial(tx, st, "a", 8, 10, &s) != StatusCode::OK || s != "89") {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "B") {
+            if (content_get_partial(tx, st, "a", 20, 10, &s) != StatusCode::OK || ! s.empty()) {
                 return TransactionOperation::ERROR;
             }
-
-            if (iterator_next(iter) != StatusCode::OK) {
+            if (content_get_partial(tx, st, "x", 0, 1, &s) != StatusCode::NOT_FOUND) {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "c") {
+
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "", EndPointKind::UNBOUND,
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "C") {
+            HandleHolder closer { iter };
+            if (iterator_set_value_window(iter, 1, 2) != StatusCode::OK) {
                 return TransactionOperation::ERROR;
             }
-
             if (iterator_next(iter) != StatusCode::OK) {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "c1") {
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "12") {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "C1") {
+            std::array<IteratorBatchEntry, 10> entries{};
+            std::array<char, 100> data{};
+            IteratorBatch batch{entries.data(), data.data(), 0, 0};
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::OK || batch.row_count != 1) {
                 return TransactionOperation::ERROR;
             }
-
-            if (iterator_next(iter) != StatusCode::NOT_FOUND) {
+            if (batch.key(0) != "b" || batch.value(0) != "b") {
                 return TransactionOperation::ERROR;
             }
             return TransactionOperation::COMMIT;
@@ -1669,4 +2196,594 @@ TEST_F(ApiTest, rtx_strand) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ApiTest, split_points) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        for (std::size_t i = 0; i < 100; ++i) {
+            std::string key{"k00"};
+            key[1] = static_cast<char>('0' + i / 10);
+            key[2] = static_cast<char>('0' + i % 10);
+            ASSERT_EQ(content_put(tx, st, key, "v"), StatusCode::OK);
+        }
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+
+    std::vector<std::string> keys{};
+    EXPECT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, 0, keys),
+        StatusCode::ERR_INVALID_ARGUMENT);
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "k1", EndPointKind::INCLUSIVE, "k3", EndPointKind::EXCLUSIVE, 4, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k15", "k20", "k25"}));
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "k00", EndPointKind::INCLUSIVE, "k01", EndPointKind::INCLUSIVE, 4, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k01"}));
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, 4, keys),
+        StatusCode::OK);
+    ASSERT_EQ(keys, (std::vector<std::string>{"k25", "k50", "k75"}));
+
+    std::array<TransactionHandle, 4> txs{tx, tx, tx, tx};
+    std::array<IteratorHandle, 4> iters{};
+    ASSERT_EQ(content_scan_partitioned(
+        txs.data(), st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, keys, iters.data()), StatusCode::OK);
+    for (std::size_t i = 0; i < iters.size(); ++i) {
+        HandleHolder closer { iters[i] };
+        std::size_t count = 0;
+        Slice first{};
+        while (iterator_next(iters[i]) == StatusCode::OK) {
+            if (count == 0) {
+                ASSERT_EQ(iterator_get_key(iters[i], &first), StatusCode::OK);
+                EXPECT_EQ(first, i == 0 ? "k00" : keys[i - 1]);
+            }
+            ++count;
+        }
+        EXPECT_EQ(count, 25);
+    }
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, scan_read_ahead) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "a", "A"), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "b", "B"), StatusCode::OK);
+
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        // not a read-only transaction
+        EXPECT_EQ(iterator_set_read_ahead(iter, 1), StatusCode::ERR_ILLEGAL_OPERATION);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    HandleHolder<TransactionControlHandle> tch{};
+    TransactionOptions txopts{};
+    txopts.transaction_type(TransactionOptions::TransactionType::READ_ONLY);
+    ASSERT_EQ(transaction_begin(db, txopts, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        EXPECT_EQ(iterator_set_read_ahead(iter, 0), StatusCode::ERR_INVALID_ARGUMENT);
+        ASSERT_EQ(iterator_set_read_ahead(iter, 1), StatusCode::OK);
+        EXPECT_EQ(iterator_set_read_ahead(iter, 1), StatusCode::ERR_ILLEGAL_OPERATION);
+        EXPECT_EQ(iterator_set_filter(iter, nullptr, nullptr), StatusCode::ERR_ILLEGAL_OPERATION);
+
+        Slice s{};
+        ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+        ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+        EXPECT_EQ(s, "a");
+        ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+        ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+        EXPECT_EQ(s, "b");
+        EXPECT_EQ(iterator_next(iter), StatusCode::NOT_FOUND);
+    }
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+        // already advanced
+        EXPECT_EQ(iterator_set_read_ahead(iter, 1), StatusCode::ERR_ILLEGAL_OPERATION);
+    }
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, iterator_seek) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    for (std::string_view k : { "a", "b", "b/1", "c", "d", "e" }) {
+        ASSERT_EQ(content_put(tx, st, k, k), StatusCode::OK);
+    }
+    auto next_key = [](IteratorHandle iter) {
+        if (iterator_next(iter) != StatusCode::OK) {
+            return std::string{"<EOF>"};
+        }
+        Slice s{};
+        if (iterator_get_key(iter, &s) != StatusCode::OK) {
+            return std::string{"<ERROR>"};
+        }
+        return s.to_string();
+    };
+
+    IteratorHandle iter{};
+    ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "b", EndPointKind::PREFIXED_INCLUSIVE, &iter), StatusCode::OK);
+    HandleHolder closer { iter };
+    EXPECT_EQ(next_key(iter), "a");
+    EXPECT_EQ(next_key(iter), "b");
+
+    // seek from the current key
+    Slice current{};
+    ASSERT_EQ(iterator_get_key(iter, &current), StatusCode::OK);
+    ASSERT_EQ(iterator_seek(iter, current, EndPointKind::EXCLUSIVE), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "b/1");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    // seek backward
+    ASSERT_EQ(iterator_seek(iter, "", EndPointKind::UNBOUND), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "a");
+
+    ASSERT_EQ(iterator_rebind(iter, "b", EndPointKind::PREFIXED_EXCLUSIVE, "d", EndPointKind::INCLUSIVE), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "c");
+    EXPECT_EQ(next_key(iter), "d");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    ASSERT_EQ(iterator_seek(iter, "d", EndPointKind::INCLUSIVE), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "d");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    ASSERT_EQ(iterator_rebind(iter, "d", EndPointKind::EXCLUSIVE, "", EndPointKind::UNBOUND), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "e");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, scan_multi) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    for (std::string_view k : { "a", "b", "c", "d", "e", "f", "g" }) {
+        ASSERT_EQ(content_put(tx, st, k, k), StatusCode::OK);
+    }
+    auto next_key = [](IteratorHandle iter) {
+        if (iterator_next(iter) != StatusCode::OK) {
+            return std::string{"<EOF>"};
+        }
+        Slice s{};
+        if (iterator_get_key(iter, &s) != StatusCode::OK) {
+            return std::string{"<ERROR>"};
+        }
+        return s.to_string();
+    };
+    {
+        std::array<ScanRange, 4> ranges{
+            ScanRange{"a", EndPointKind::INCLUSIVE, "a", EndPointKind::INCLUSIVE},
+            ScanRange{"aa", EndPointKind::INCLUSIVE, "ab", EndPointKind::INCLUSIVE},
+            ScanRange{"c", EndPointKind::EXCLUSIVE, "f", EndPointKind::EXCLUSIVE},
+            ScanRange{"g", EndPointKind::PREFIXED_INCLUSIVE, "g", EndPointKind::PREFIXED_INCLUSIVE},
+        };
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan_multi(tx, st, ranges.data(), ranges.size(), &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        EXPECT_EQ(next_key(iter), "a");
+        EXPECT_EQ(next_key(iter), "d");
+        EXPECT_EQ(next_key(iter), "e");
+        EXPECT_EQ(next_key(iter), "g");
+        EXPECT_EQ(next_key(iter), "<EOF>");
+
+        EXPECT_EQ(iterator_seek(iter, "b", EndPointKind::INCLUSIVE), StatusCode::ERR_ILLEGAL_OPERATION);
+        ASSERT_EQ(iterator_rebind(iter, "f", EndPointKind::INCLUSIVE, "", EndPointKind::UNBOUND), StatusCode::OK);
+        EXPECT_EQ(next_key(iter), "f");
+        EXPECT_EQ(next_key(iter), "g");
+        EXPECT_EQ(next_key(iter), "<EOF>");
+    }
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan_multi(tx, st, nullptr, 0, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        EXPECT_EQ(next_key(iter), "<EOF>");
+    }
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, scan_filter) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "b", "2"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "d", "4"), StatusCode::OK);
+
+    struct S {
+        static bool even(Slice, Slice value, void* context) {
+            ++*static_cast<std::size_t*>(context);
+            return (value.at<char>(0) - '0') % 2 == 0;
+        }
+    };
+    std::size_t calls = 0;
+    IteratorHandle iter{};
+    ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+    HandleHolder closer { iter };
+    ASSERT_EQ(iterator_set_filter(iter, &S::even, &calls), StatusCode::OK);
+
+    Slice s{};
+    ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+    ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "b");
+    ASSERT_EQ(iterator_get_value(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "2");
+
+    std::array<IteratorBatchEntry, 10> entries{};
+    std::array<char, 100> data{};
+    IteratorBatch batch{entries.data(), data.data(), 0, 0};
+    ASSERT_EQ(iterator_next_batch(iter, entries.size(), data.size(), &batch), StatusCode::OK);
+    ASSERT_EQ(batch.row_count, 1);
+    EXPECT_EQ(batch.key(0), "d");
+    EXPECT_EQ(iterator_next(iter), StatusCode::NOT_FOUND);
+    EXPECT_EQ(calls, 4);
+
+    // clear the filter
+    ASSERT_EQ(iterator_set_filter(iter, nullptr, nullptr), StatusCode::OK);
+    ASSERT_EQ(iterator_seek(iter, "c", EndPointKind::INCLUSIVE), StatusCode::OK);
+    ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+    ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "c");
+
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, metrics) {
+    DatabaseOptions options;
+    options.attribute("perf", "true");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "b", "2"), StatusCode::OK);
+    Slice s{};
+    ASSERT_EQ(content_get(tx, st, "a", &s), StatusCode::OK);
+    ASSERT_EQ(content_get(tx, st, "x", &s), StatusCode::NOT_FOUND);
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        while (iterator_next(iter) == StatusCode::OK) {}
+    }
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.operation(MetricsOperation::BEGIN).calls, 1);
+    EXPECT_EQ(metrics.operation(MetricsOperation::PUT).calls, 2);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).calls, 2);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).errors, 0);
+    EXPECT_EQ(metrics.operation(MetricsOperation::SCAN_OPEN).calls, 1);
+    EXPECT_EQ(metrics.operation(MetricsOperation::NEXT).calls, 3);
+    EXPECT_EQ(metrics.operation(MetricsOperation::COMMIT).calls, 1);
+    EXPECT_EQ(metrics.operation(MetricsOperation::PUT).latency.count(), 2);
+
+    auto&& storage = metrics.storages["s"];
+    EXPECT_EQ(storage.put_count, 2);
+    EXPECT_EQ(storage.get_count, 2);
+    EXPECT_EQ(storage.scan_count, 1);
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    EXPECT_NE(ss.str().find("PUT: calls=2"), std::string::npos);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, metrics_retry) {
+    DatabaseOptions options;
+    options.attribute("perf", "true");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation f(TransactionHandle, void* args) {
+            auto s = reinterpret_cast<std::size_t*>(args);
+            return ++*s < 3 ? TransactionOperation::RETRY : TransactionOperation::COMMIT;
+        }
+    };
+    std::size_t count = 0;
+    ASSERT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(5), &S::f, &count), StatusCode::OK);
+    EXPECT_EQ(count, 3);
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.retries, 2);
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    EXPECT_NE(ss.str().find("retries: 2"), std::string::npos);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, metrics_batch) {
+    // verify the batch and pinned operations are also recorded
+    DatabaseOptions options;
+    options.attribute("perf", "true");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "b", "2"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+
+    std::array<Slice, 3> keys{"a", "b", "x"};
+    std::array<Slice, 3> results{};
+    std::array<StatusCode, 3> statuses{};
+    ASSERT_EQ(content_get_batch(tx, st, keys.data(), keys.size(), results.data(), statuses.data()), StatusCode::OK);
+    Slice pinned{};
+    ASSERT_EQ(content_get_pinned(tx, st, "a", &pinned), StatusCode::OK);
+    ASSERT_EQ(content_release(tx, pinned), StatusCode::OK);
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        std::array<IteratorBatchEntry, 10> entries{};
+        std::array<char, 100> data{};
+        IteratorBatch batch{entries.data(), data.data(), 0, 0};
+        ASSERT_EQ(iterator_next_batch(iter, 2, data.size(), &batch), StatusCode::OK);
+
+        std::array<std::int64_t, 11> key_offsets{};
+        std::array<char, 100> key_data{};
+        std::array<std::int64_t, 11> value_offsets{};
+        std::array<char, 100> value_data{};
+        IteratorColumns columns{
+            key_offsets.data(), key_data.data(), key_data.size(),
+            value_offsets.data(), value_data.data(), value_data.size(),
+            0,
+        };
+        ASSERT_EQ(iterator_next_columns(iter, 10, &columns), StatusCode::OK);
+        ASSERT_EQ(iterator_next_batch(iter, 2, data.size(), &batch), StatusCode::NOT_FOUND);
+    }
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).calls, 4);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).latency.count(), 4);
+    EXPECT_EQ(metrics.operation(MetricsOperation::NEXT).calls, 3);
+    EXPECT_EQ(metrics.operation(MetricsOperation::NEXT).latency.count(), 3);
+    EXPECT_EQ(metrics.storages["s"].get_count, 4);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, metrics_disabled) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.operation(MetricsOperation::BEGIN).calls, 0);
+    EXPECT_EQ(metrics.operation(MetricsOperation::COMMIT).calls, 0);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, transaction_timings) {
+    DatabaseOptions options;
+    options.attribute("perf", "true");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    {
+        std::shared_ptr<TransactionInfo> info{};
+        ASSERT_EQ(transaction_get_info(tch.get(), info), StatusCode::OK);
+        auto&& t = info->timings();
+        EXPECT_TRUE(t.at(TransactionEvent::STARTED));
+        EXPECT_FALSE(t.at(TransactionEvent::FIRST_OPERATION));
+        EXPECT_TRUE(t.duration(TransactionPhase::QUEUEING));
+    }
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    std::shared_ptr<TransactionInfo> info{};
+    ASSERT_EQ(transaction_get_info(tch.get(), info), StatusCode::OK);
+    auto&& t = info->timings();
+    for (std::size_t i = 0; i < transaction_event_count; ++i) {
+        EXPECT_TRUE(t.at(static_cast<TransactionEvent>(i))) << static_cast<TransactionEvent>(i);
+    }
+    EXPECT_LE(*t.at(TransactionEvent::BEGIN_REQUESTED), *t.at(TransactionEvent::STARTED));
+    EXPECT_LE(*t.at(TransactionEvent::STARTED), *t.at(TransactionEvent::FIRST_OPERATION));
+    EXPECT_LE(*t.at(TransactionEvent::FIRST_OPERATION), *t.at(TransactionEvent::COMMIT_REQUESTED));
+    EXPECT_LE(*t.at(TransactionEvent::COMMIT_REQUESTED), *t.at(TransactionEvent::COMMIT_DONE));
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.phase(TransactionPhase::EXECUTION).count(), 1);
+    EXPECT_EQ(metrics.phase(TransactionPhase::VALIDATION).count(), 1);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, flight_recorder) {
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+    }
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    auto text = ss.str();
+    EXPECT_NE(text.find("flight recorder"), std::string::npos);
+    EXPECT_NE(text.find(" begin tx:"), std::string::npos);
+    EXPECT_NE(text.find(" scan_open tx:"), std::string::npos);
+    EXPECT_NE(text.find(" scan_close iterator:"), std::string::npos);
+    EXPECT_NE(text.find(" commit tx:"), std::string::npos);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, flight_recorder_per_database) {
+    // disabling the flight recorder of a database does not affect the other databases
+    DatabaseOptions options;
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    DatabaseOptions disabled_options;
+    disabled_options.attribute("flight_recorder", "false");
+    DatabaseHandle disabled;
+    ASSERT_EQ(database_open(disabled_options, &disabled), StatusCode::OK);
+    HandleHolder disabledh { disabled };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    std::stringstream expected{};
+    expected << " begin tx:" << static_cast<void const*>(tx);
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    EXPECT_NE(ss.str().find(expected.str()), std::string::npos);
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(disabled), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, flight_recorder_invalid_option) {
+    DatabaseOptions options;
+    options.attribute("flight_recorder", "maybe");
+    DatabaseHandle db;
+    EXPECT_EQ(database_open(options, &db), StatusCode::ERR_INVALID_ARGUMENT);
+}
+
+TEST_F(ApiTest, hot_keys) {
+    DatabaseOptions options;
+    options.attribute("hot_keys", "4");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    // memory implementation never fails by conflicts
+    std::vector<HotKey> keys{};
+    ASSERT_EQ(database_get_hot_keys(db, keys), StatusCode::OK);
+    EXPECT_TRUE(keys.empty());
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ApiTest, hot_keys_invalid_option) {
+    DatabaseOptions options;
+    options.attribute("hot_keys", "many");
+    DatabaseHandle db;
+    EXPECT_EQ(database_open(options, &db), StatusCode::ERR_INVALID_ARGUMENT);
+}
+
 }  // namespace sharksfin
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "BenchRoot.h"
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief measures the content APIs through the shirakami bridge.
+ * @details the transactions are restarted out of the measurement every transaction_size operations, so that the
+ * results are not dominated by the growing read sets.
+ */
+class ApiBench : public BenchRoot {
+public:
+    static constexpr std::size_t transaction_size = 100;
+
+    void begin() {
+        check(transaction_begin(database_, {}, &tch_), "transaction_begin");
+        check(transaction_borrow_handle(tch_, &tx_), "transaction_borrow_handle");
+    }
+
+    void end() {
+        check(transaction_commit(tch_), "transaction_commit");
+        transaction_dispose(tch_);
+        tch_ = nullptr;
+        tx_ = nullptr;
+    }
+
+    void restart(benchmark::State& state) {
+        state.PauseTiming();
+        end();
+        begin();
+        state.ResumeTiming();
+    }
+
+protected:
+    TransactionControlHandle tch_{};  // NOLINT(*-non-private-member-variables-in-classes)
+    TransactionHandle tx_{};  // NOLINT(*-non-private-member-variables-in-classes)
+};
+
+BENCHMARK_DEFINE_F(ApiBench, content_get)(benchmark::State& state) {
+    auto records = static_cast<std::size_t>(state.range(0));
+    std::size_t index = 0;
+    std::size_t count = 0;
+    begin();
+    for (auto _ : state) {
+        Slice value{};
+        benchmark::DoNotOptimize(content_get(tx_, storage_, key(index), &value));
+        benchmark::DoNotOptimize(value);
+        index = (index + 7919) % records;
+        if (++count == transaction_size) {
+            count = 0;
+            restart(state);
+        }
+    }
+    end();
+}
+BENCHMARK_REGISTER_F(ApiBench, content_get)->Args({ 10000, 16 })->Args({ 10000, 1024 });
+
+BENCHMARK_DEFINE_F(ApiBench, content_get_not_found)(benchmark::State& state) {
+    std::size_t count = 0;
+    auto missing = key(static_cast<std::size_t>(state.range(0)));
+    begin();
+    for (auto _ : state) {
+        Slice value{};
+        benchmark::DoNotOptimize(content_get(tx_, storage_, missing, &value));
+        if (++count == transaction_size) {
+            count = 0;
+            restart(state);
+        }
+    }
+    end();
+}
+BENCHMARK_REGISTER_F(ApiBench, content_get_not_found)->Args({ 10000, 16 });
+
+// a full scan, which measures the cost of each iterator_next() and reading its entry
+BENCHMARK_DEFINE_F(ApiBench, iterator_next)(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        begin();
+        state.ResumeTiming();
+        IteratorHandle iter{};
+        check(content_scan(tx_, storage_, {}, EndPointKind::UNBOUND, {}, EndPointKind::UNBOUND, &iter), "content_scan");
+        while (iterator_next(iter) == StatusCode::OK) {
+            Slice k{};
+            Slice v{};
+            benchmark::DoNotOptimize(iterator_get_key(iter, &k));
+            benchmark::DoNotOptimize(iterator_get_value(iter, &v));
+        }
+        iterator_dispose(iter);
+        state.PauseTiming();
+        end();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_REGISTER_F(ApiBench, iterator_next)->Args({ 10000, 16 })->Args({ 10000, 1024 });
+
+// short scans, which are dominated by the cost of opening and closing the iterator
+BENCHMARK_DEFINE_F(ApiBench, content_scan_short)(benchmark::State& state) {
+    auto records = static_cast<std::size_t>(state.range(0));
+    std::size_t index = 0;
+    std::size_t count = 0;
+    begin();
+    for (auto _ : state) {
+        auto prefix = key(index).substr(0, 12);
+        IteratorHandle iter{};
+        check(content_scan(tx_, storage_,
+            prefix, EndPointKind::PREFIXED_INCLUSIVE,
+            prefix, EndPointKind::PREFIXED_INCLUSIVE,
+            &iter), "content_scan");
+        while (iterator_next(iter) == StatusCode::OK) {
+            Slice k{};
+            benchmark::DoNotOptimize(iterator_get_key(iter, &k));
+        }
+        iterator_dispose(iter);
+        index = (index + 10) % records;
+        if (++count == transaction_size) {
+            count = 0;
+            restart(state);
+        }
+    }
+    end();
+}
+BENCHMARK_REGISTER_F(ApiBench, content_scan_short)->Args({ 10000, 16 });
+
+// resolving the storage by name, which is served by the storage cache after the first call
+BENCHMARK_DEFINE_F(ApiBench, storage_get)(benchmark::State& state) {
+    for (auto _ : state) {
+        StorageHandle handle{};
+        check(storage_get(database_, storage_name, &handle), "storage_get");
+        storage_dispose(handle);
+    }
+}
+BENCHMARK_REGISTER_F(ApiBench, storage_get)->Args({ 0, 0 });
+
+}  // namespace sharksfin::shirakami
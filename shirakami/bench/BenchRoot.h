@@ -0,0 +1,146 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_SHIRAKAMI_BENCH_BENCHROOT_H_
+#define SHARKSFIN_SHIRAKAMI_BENCH_BENCHROOT_H_
+
+#include <array>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "boost/filesystem.hpp"
+
+#include "sharksfin/api.h"
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief a benchmark fixture which opens a database on a temporary folder and populates a storage.
+ * @details the first benchmark argument is the number of records, and the second one is the value size.
+ * The database is opened for each benchmark run, so that the runs never share the record versions.
+ * This must not be used from the multi-threaded benchmarks.
+ */
+class BenchRoot : public benchmark::Fixture {
+public:
+    /**
+     * @brief the name of the populated storage.
+     */
+    static constexpr std::string_view storage_name { "bench" };
+
+    void SetUp(benchmark::State const& state) override {
+        prepare();
+        open();
+        check(storage_create(database_, storage_name, &storage_), "storage_create");
+        populate(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    }
+
+    void TearDown(benchmark::State const&) override {
+        if (storage_ != nullptr) {
+            storage_dispose(storage_);
+            storage_ = nullptr;
+        }
+        close();
+        if (! path_.empty()) {
+            boost::filesystem::remove_all(path_);
+            path_.clear();
+        }
+    }
+
+    /**
+     * @brief returns the key of the record.
+     * @param index the record index
+     * @return the key, which is ordered as the index
+     */
+    static std::string key(std::size_t index) {
+        std::array<char, 32> buffer{};
+        auto length = std::snprintf(buffer.data(), buffer.size(), "k%012zu", index);  // NOLINT
+        return std::string(buffer.data(), static_cast<std::size_t>(length));
+    }
+
+    /**
+     * @brief throws an exception if the status is not OK.
+     * @param rc the status code
+     * @param what the operation name
+     */
+    static void check(StatusCode rc, std::string_view what) {
+        if (rc != StatusCode::OK) {
+            throw std::runtime_error(std::string{what} + " failed: " + std::string{to_string_view(rc)});
+        }
+    }
+
+protected:
+    /**
+     * @brief creates an empty temporary folder for the database.
+     */
+    void prepare() {
+        auto pattern = boost::filesystem::temp_directory_path();
+        pattern /= "sharksfin-bench-%%%%%%%%";
+        path_ = boost::filesystem::unique_path(pattern);
+        boost::filesystem::create_directories(path_);
+    }
+
+    /**
+     * @brief opens the database on the temporary folder.
+     * @param options the database options, the location is overwritten
+     */
+    void open(DatabaseOptions options = {}) {
+        options.attribute("location", path_.string());
+        check(database_open(options, &database_), "database_open");
+    }
+
+    /**
+     * @brief closes and disposes the database.
+     */
+    void close() {
+        if (database_ != nullptr) {
+            database_close(database_);
+            database_dispose(database_);
+            database_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief puts the records into the storage.
+     * @param records the number of records
+     * @param value_size the byte size of each value
+     */
+    void populate(std::size_t records, std::size_t value_size) {
+        static constexpr std::size_t batch_size = 1000;
+        std::string value(value_size, 'v');
+        for (std::size_t i = 0; i < records; i += batch_size) {
+            TransactionControlHandle tch{};
+            check(transaction_begin(database_, {}, &tch), "transaction_begin");
+            TransactionHandle tx{};
+            check(transaction_borrow_handle(tch, &tx), "transaction_borrow_handle");
+            for (std::size_t j = i; j < records && j < i + batch_size; ++j) {
+                check(content_put(tx, storage_, key(j), value), "content_put");
+            }
+            check(transaction_commit(tch), "transaction_commit");
+            transaction_dispose(tch);
+        }
+    }
+
+    boost::filesystem::path path_{};  // NOLINT(*-non-private-member-variables-in-classes)
+    DatabaseHandle database_{};  // NOLINT(*-non-private-member-variables-in-classes)
+    StorageHandle storage_{};  // NOLINT(*-non-private-member-variables-in-classes)
+};
+
+}  // namespace sharksfin::shirakami
+
+#endif  // SHARKSFIN_SHIRAKAMI_BENCH_BENCHROOT_H_
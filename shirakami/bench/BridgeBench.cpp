@@ -0,0 +1,228 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "shirakami/interface.h"
+#include "shirakami/scheme.h"
+
+#include "BenchRoot.h"
+
+namespace sharksfin::shirakami {
+
+using ::shirakami::Status;
+using ::shirakami::scan_endpoint;
+using ::shirakami::transaction_options;
+
+/**
+ * @brief compares the content operations through the bridge with the same operations issued directly to shirakami.
+ * @details each iteration runs a batch of operations through the bridge and then the same batch directly on a raw
+ * shirakami session, both in their own short transactions over the same storage. Only the operations are timed, and
+ * the transactions are restarted between the batches. The results are reported as the following counters:
+ * - bridge_ns: the mean time of an operation through sharksfin API
+ * - raw_ns: the mean time of an operation through shirakami API
+ * - overhead_ns: the difference between them, that is the cost added by the bridge for each operation
+ * - overhead_ratio: overhead_ns / raw_ns
+ */
+class BridgeBench : public BenchRoot {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t batch_size = 100;
+
+    void SetUp(benchmark::State const& state) override {
+        BenchRoot::SetUp(state);
+        if (::shirakami::get_storage(storage_name, raw_storage_) != Status::OK) {
+            throw std::runtime_error("get_storage failed");
+        }
+        if (::shirakami::enter(token_) != Status::OK) {
+            throw std::runtime_error("enter failed");
+        }
+    }
+
+    void TearDown(benchmark::State const& state) override {
+        if (token_ != nullptr) {
+            ::shirakami::leave(token_);
+            token_ = nullptr;
+        }
+        BenchRoot::TearDown(state);
+    }
+
+    /**
+     * @brief runs the both sides of the batch and accumulates their elapsed time.
+     * @param bridge the bridge side, which accepts the transaction handle and the operation index
+     * @param raw the raw side, which accepts the shirakami token and the operation index
+     */
+    template<class Bridge, class Raw>
+    void run(Bridge&& bridge, Raw&& raw) {
+        TransactionControlHandle tch{};
+        check(transaction_begin(database_, {}, &tch), "transaction_begin");
+        TransactionHandle tx{};
+        check(transaction_borrow_handle(tch, &tx), "transaction_borrow_handle");
+        auto started = clock::now();
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            bridge(tx, next_ + i);
+        }
+        bridge_ += clock::now() - started;
+        check(transaction_commit(tch), "transaction_commit");
+        transaction_dispose(tch);
+
+        if (::shirakami::tx_begin(transaction_options{token_, transaction_options::transaction_type::SHORT, {}, {}})
+                != Status::OK) {
+            throw std::runtime_error("tx_begin failed");
+        }
+        started = clock::now();
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            raw(token_, next_ + i);
+        }
+        raw_ += clock::now() - started;
+        std::atomic_bool done{false};
+        ::shirakami::commit(token_, [&done](auto, auto, auto) { done.store(true); });
+        while (! done.load()) {
+            std::this_thread::yield();
+        }
+        next_ += batch_size;
+    }
+
+    /**
+     * @brief reports the elapsed time of the both sides.
+     * @param state the benchmark state
+     */
+    void report(benchmark::State& state) const {
+        auto operations = static_cast<double>(state.iterations() * batch_size);
+        if (operations == 0) {
+            return;
+        }
+        auto bridge = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(bridge_).count()) / operations;
+        auto raw = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(raw_).count()) / operations;
+        state.counters["bridge_ns"] = bridge;
+        state.counters["raw_ns"] = raw;
+        state.counters["overhead_ns"] = bridge - raw;
+        state.counters["overhead_ratio"] = raw == 0 ? 0.0 : (bridge - raw) / raw;
+        state.SetItemsProcessed(static_cast<std::int64_t>(operations));
+    }
+
+    /**
+     * @brief returns the index of the record used by the operation.
+     * @param state the benchmark state
+     * @param operation the operation index
+     * @return the record index
+     */
+    static std::size_t record(benchmark::State const& state, std::size_t operation) {
+        // visit the records in a scattered order
+        return (operation * 7919U) % static_cast<std::size_t>(state.range(0));
+    }
+
+protected:
+    ::shirakami::Storage raw_storage_{};  // NOLINT(*-non-private-member-variables-in-classes)
+    ::shirakami::Token token_{};  // NOLINT(*-non-private-member-variables-in-classes)
+
+private:
+    clock::duration bridge_{};
+    clock::duration raw_{};
+    std::size_t next_{};
+};
+
+BENCHMARK_DEFINE_F(BridgeBench, content_get)(benchmark::State& state) {
+    for (auto _ : state) {
+        run(
+            [&](TransactionHandle tx, std::size_t i) {
+                Slice value{};
+                benchmark::DoNotOptimize(content_get(tx, storage_, key(record(state, i)), &value));
+                benchmark::DoNotOptimize(value);
+            },
+            [&](::shirakami::Token token, std::size_t i) {
+                std::string value{};
+                benchmark::DoNotOptimize(::shirakami::search_key(token, raw_storage_, key(record(state, i)), value));
+                benchmark::DoNotOptimize(value);
+            });
+    }
+    report(state);
+}
+BENCHMARK_REGISTER_F(BridgeBench, content_get)->Args({ 10000, 16 })->Args({ 10000, 1024 });
+
+BENCHMARK_DEFINE_F(BridgeBench, content_get_not_found)(benchmark::State& state) {
+    auto missing = key(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        run(
+            [&](TransactionHandle tx, std::size_t) {
+                Slice value{};
+                benchmark::DoNotOptimize(content_get(tx, storage_, missing, &value));
+            },
+            [&](::shirakami::Token token, std::size_t) {
+                std::string value{};
+                benchmark::DoNotOptimize(::shirakami::search_key(token, raw_storage_, missing, value));
+            });
+    }
+    report(state);
+}
+BENCHMARK_REGISTER_F(BridgeBench, content_get_not_found)->Args({ 10000, 16 });
+
+// opens a scan over range(2) records, reads all of them, and closes the scan
+BENCHMARK_DEFINE_F(BridgeBench, content_scan)(benchmark::State& state) {
+    auto records = static_cast<std::size_t>(state.range(0));
+    auto length = static_cast<std::size_t>(state.range(2));
+    for (auto _ : state) {
+        run(
+            [&](TransactionHandle tx, std::size_t i) {
+                auto first = record(state, i) % (records - length);
+                IteratorHandle iter{};
+                check(content_scan(tx, storage_,
+                    key(first), EndPointKind::INCLUSIVE,
+                    key(first + length), EndPointKind::EXCLUSIVE,
+                    &iter), "content_scan");
+                while (iterator_next(iter) == StatusCode::OK) {
+                    Slice k{};
+                    Slice v{};
+                    benchmark::DoNotOptimize(iterator_get_key(iter, &k));
+                    benchmark::DoNotOptimize(iterator_get_value(iter, &v));
+                }
+                iterator_dispose(iter);
+            },
+            [&](::shirakami::Token token, std::size_t i) {
+                auto first = record(state, i) % (records - length);
+                ::shirakami::ScanHandle handle{};
+                auto rc = ::shirakami::open_scan(token, raw_storage_,
+                    key(first), scan_endpoint::INCLUSIVE,
+                    key(first + length), scan_endpoint::EXCLUSIVE,
+                    handle);
+                if (rc != Status::OK) {
+                    return;
+                }
+                do {
+                    std::string k{};
+                    std::string v{};
+                    benchmark::DoNotOptimize(::shirakami::read_key_from_scan(token, handle, k));
+                    benchmark::DoNotOptimize(::shirakami::read_value_from_scan(token, handle, v));
+                } while (::shirakami::next(token, handle) == Status::OK);
+                ::shirakami::close_scan(token, handle);
+            });
+    }
+    report(state);
+}
+BENCHMARK_REGISTER_F(BridgeBench, content_scan)
+    ->Args({ 10000, 16, 1 })
+    ->Args({ 10000, 16, 10 })
+    ->Args({ 10000, 16, 100 })
+    ->Args({ 10000, 1024, 10 });
+
+}  // namespace sharksfin::shirakami
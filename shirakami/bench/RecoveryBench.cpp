@@ -0,0 +1,224 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "boost/filesystem.hpp"
+
+#include "BenchRoot.h"
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief measures the time to restart the database, and to serve the first query after that.
+ * @details the benchmark arguments are:
+ * 0. the number of storages
+ * 1. the total number of rows, which are distributed to the storages in round-robin
+ * 2. recover_max_parallelism, or 0 to leave it default
+ * 3. index_restore_threads, or 0 to leave it default
+ * 4. 1 to open with startup_mode=maintenance, or 0 to open normally
+ * The database is populated and closed once for each benchmark run, and then each iteration opens and closes it.
+ * The iteration time is from database_open() until the first query is completed, and each phase is also reported
+ * as a counter (in milliseconds, the mean of iterations):
+ * - open_ms: database_open(), which includes the log recovery and the index restoration
+ * - storage_get_cold_ms: the first storage_get(), which resolves the storage and fills the storage cache
+ * - storage_get_warm_ms: the second storage_get(), which is served by the storage cache
+ * - first_get_ms: the first transaction, which reads a row with content_get()
+ * - warm_get_ms: the second transaction, which reads the same row
+ * - close_ms: database_close(), which is excluded from the iteration time
+ */
+class RecoveryBench : public BenchRoot {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t value_size = 64;
+
+    void SetUp(benchmark::State const& state) override {
+        prepare();
+        open();
+        auto storages = static_cast<std::size_t>(state.range(0));
+        auto rows = static_cast<std::size_t>(state.range(1));
+        std::vector<StorageHandle> handles{};
+        for (std::size_t i = 0; i < storages; ++i) {
+            StorageHandle handle{};
+            check(storage_create(database_, name(i), &handle), "storage_create");
+            handles.emplace_back(handle);
+        }
+        static constexpr std::size_t batch_size = 1000;
+        std::string value(value_size, 'v');
+        for (std::size_t i = 0; i < rows; i += batch_size) {
+            TransactionControlHandle tch{};
+            check(transaction_begin(database_, {}, &tch), "transaction_begin");
+            TransactionHandle tx{};
+            check(transaction_borrow_handle(tch, &tx), "transaction_borrow_handle");
+            for (std::size_t j = i; j < rows && j < i + batch_size; ++j) {
+                check(content_put(tx, handles[j % storages], key(j / storages), value), "content_put");
+            }
+            check(transaction_commit(tch), "transaction_commit");
+            transaction_dispose(tch);
+        }
+        for (auto h : handles) {
+            storage_dispose(h);
+        }
+        close();
+    }
+
+    /**
+     * @brief returns the name of the storage.
+     * @param index the storage index
+     * @return the storage name
+     */
+    static std::string name(std::size_t index) {
+        std::array<char, 32> buffer{};
+        auto length = std::snprintf(buffer.data(), buffer.size(), "bench_%06zu", index);  // NOLINT
+        return std::string(buffer.data(), static_cast<std::size_t>(length));
+    }
+
+    /**
+     * @brief returns the database options of the benchmark run.
+     * @param state the benchmark state
+     * @return the database options, without the location
+     */
+    static DatabaseOptions options(benchmark::State const& state) {
+        DatabaseOptions ret{};
+        ret.open_mode(DatabaseOptions::OpenMode::RESTORE);
+        if (state.range(2) != 0) {
+            ret.attribute("recover_max_parallelism", std::to_string(state.range(2)));
+        }
+        if (state.range(3) != 0) {
+            ret.attribute("index_restore_threads", std::to_string(state.range(3)));
+        }
+        if (state.range(4) != 0) {
+            ret.attribute("startup_mode", "maintenance");
+        }
+        return ret;
+    }
+
+    /**
+     * @brief returns the total byte size of the files in the database location.
+     * @return the byte size
+     */
+    std::uintmax_t location_size() const {
+        std::uintmax_t ret = 0;
+        for (auto&& e : boost::filesystem::recursive_directory_iterator(path_)) {
+            if (boost::filesystem::is_regular_file(e.path())) {
+                ret += boost::filesystem::file_size(e.path());
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief runs a transaction which reads a row.
+     * @param storage the target storage
+     * @return the status code
+     */
+    StatusCode get_row(StorageHandle storage) {
+        TransactionControlHandle tch{};
+        if (auto rc = transaction_begin(database_, {}, &tch); rc != StatusCode::OK) {
+            return rc;
+        }
+        TransactionHandle tx{};
+        auto rc = transaction_borrow_handle(tch, &tx);
+        if (rc == StatusCode::OK) {
+            Slice value{};
+            rc = content_get(tx, storage, key(0), &value);
+        }
+        if (rc == StatusCode::OK) {
+            rc = transaction_commit(tch);
+        } else {
+            transaction_abort(tch);
+        }
+        transaction_dispose(tch);
+        return rc;
+    }
+};
+
+BENCHMARK_DEFINE_F(RecoveryBench, restart)(benchmark::State& state) {
+    auto opts = options(state);
+    std::array<double, 6> phases{};
+    auto elapsed = [](clock::time_point from, clock::time_point to) {
+        return std::chrono::duration<double>(to - from).count();
+    };
+    state.counters["location_bytes"] = static_cast<double>(location_size());
+    for (auto _ : state) {
+        auto t0 = clock::now();
+        open(opts);
+        auto t1 = clock::now();
+        StorageHandle storage{};
+        if (auto rc = storage_get(database_, name(0), &storage); rc != StatusCode::OK) {
+            close();
+            state.SkipWithError(("storage_get failed: " + std::string{to_string_view(rc)}).c_str());
+            break;
+        }
+        auto t2 = clock::now();
+        StorageHandle again{};
+        check(storage_get(database_, name(0), &again), "storage_get");
+        auto t3 = clock::now();
+        auto first = get_row(storage);
+        auto t4 = clock::now();
+        auto second = get_row(storage);
+        auto t5 = clock::now();
+        storage_dispose(again);
+        storage_dispose(storage);
+        close();
+        auto t6 = clock::now();
+        if (first != StatusCode::OK || second != StatusCode::OK) {
+            state.SkipWithError(("content_get failed: " + std::string{to_string_view(first)}).c_str());
+            break;
+        }
+        state.SetIterationTime(elapsed(t0, t4));
+        phases[0] += elapsed(t0, t1);
+        phases[1] += elapsed(t1, t2);
+        phases[2] += elapsed(t2, t3);
+        phases[3] += elapsed(t3, t4);
+        phases[4] += elapsed(t4, t5);
+        phases[5] += elapsed(t5, t6);
+    }
+    static constexpr std::array<char const*, 6> labels {
+        "open_ms",
+        "storage_get_cold_ms",
+        "storage_get_warm_ms",
+        "first_get_ms",
+        "warm_get_ms",
+        "close_ms",
+    };
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        state.counters[labels[i]] = benchmark::Counter(phases[i] * 1000.0, benchmark::Counter::kAvgIterations);
+    }
+}
+BENCHMARK_REGISTER_F(RecoveryBench, restart)
+    ->ArgNames({ "storages", "rows", "recover_max_parallelism", "index_restore_threads", "maintenance" })
+    ->Args({ 1, 100'000, 0, 0, 0 })
+    ->Args({ 16, 100'000, 0, 0, 0 })
+    ->Args({ 256, 100'000, 0, 0, 0 })
+    ->Args({ 16, 1'000'000, 0, 0, 0 })
+    ->Args({ 16, 1'000'000, 1, 1, 0 })
+    ->Args({ 16, 1'000'000, 4, 4, 0 })
+    ->Args({ 16, 1'000'000, 8, 8, 0 })
+    ->Args({ 16, 1'000'000, 0, 0, 1 })
+    ->Iterations(3)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace sharksfin::shirakami
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "StorageCache.h"
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sharksfin::shirakami {
+
+static std::vector<std::string> storage_names(std::size_t count) {
+    std::vector<std::string> ret{};
+    ret.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::array<char, 64> buffer{};
+        auto length = std::snprintf(buffer.data(), buffer.size(), "schema.table_%06zu", i);  // NOLINT
+        ret.emplace_back(buffer.data(), static_cast<std::size_t>(length));
+    }
+    return ret;
+}
+
+static void fill(StorageCache& cache, std::vector<std::string> const& names) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        cache.add(names[i], static_cast<::shirakami::Storage>(i + 1));
+    }
+}
+
+static void StorageCache_get(benchmark::State& state) {
+    StorageCache cache{};
+    auto names = storage_names(static_cast<std::size_t>(state.range(0)));
+    fill(cache, names);
+    std::size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.get(names[index]));
+        if (++index == names.size()) {
+            index = 0;
+        }
+    }
+}
+BENCHMARK(StorageCache_get)->RangeMultiplier(16)->Range(1, 4096);
+
+static void StorageCache_get_not_found(benchmark::State& state) {
+    StorageCache cache{};
+    fill(cache, storage_names(static_cast<std::size_t>(state.range(0))));
+    std::string missing { "schema.missing" };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.get(missing));
+    }
+}
+BENCHMARK(StorageCache_get_not_found)->RangeMultiplier(16)->Range(1, 4096);
+
+// all threads look up the same cache, as the sessions of a database do
+static void StorageCache_get_contended(benchmark::State& state) {
+    static StorageCache cache{};
+    static std::vector<std::string> names{};
+    // the benchmark threads start the measurement together after the setup of thread 0
+    if (state.thread_index() == 0 && names.empty()) {
+        names = storage_names(64);
+        fill(cache, names);
+    }
+    auto index = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.get(names[index % names.size()]));
+        ++index;
+    }
+}
+BENCHMARK(StorageCache_get_contended)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace sharksfin::shirakami
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_SHIRAKAMI_CONTENTION_GATE_H_
+#define SHARKSFIN_SHIRAKAMI_CONTENTION_GATE_H_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief serializes retries of transactions which conflicted on the same storage/key.
+ * @details transaction_exec() retries a transaction after it aborted on commit. When the abort is caused
+ * by a hot key, every retrying transaction is likely to conflict on the same key again.
+ * This object maps the conflicting storage/key pair into a fixed number of stripes, and the retrying
+ * transaction holds the stripe lock only while it backs off, so that retries on the same key pass the stripe
+ * one by one and their next attempts are spread out instead of aborting each other again.
+ * The stripe is released before the next attempt runs the user callback, so that the stripes never cause
+ * deadlock, and unrelated keys sharing a stripe only wait for the backoff of each other.
+ */
+class ContentionGate {
+public:
+    /**
+     * @brief the number of stripes.
+     */
+    static constexpr std::size_t stripe_count = 64;
+
+    /**
+     * @brief the lock type for the stripe.
+     */
+    using lock_type = std::unique_lock<std::mutex>;
+
+    /**
+     * @brief acquires the stripe lock for the given storage/key pair.
+     * @param storage the storage name where the conflict occurred
+     * @param key the key which caused the conflict
+     * @return the acquired lock, which must be released before the next attempt starts
+     */
+    lock_type acquire(std::string_view storage, std::string_view key) {
+        return lock_type{stripes_.at(index(storage, key))};  //NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+private:
+    std::array<std::mutex, stripe_count> stripes_{};
+
+    static std::size_t index(std::string_view storage, std::string_view key) noexcept {
+        std::hash<std::string_view> hash{};
+        auto h = hash(storage);
+        h ^= hash(key) + 0x9e3779b97f4a7c15ULL + (h << 6U) + (h >> 2U);
+        return h % stripe_count;
+    }
+};
+
+}  // namespace sharksfin::shirakami
+
+#endif  // SHARKSFIN_SHIRAKAMI_CONTENTION_GATE_H_
@@ -71,10 +71,9 @@ StatusCode Database::open(DatabaseOptions const& options, void* datastore, std::
 
 StatusCode Database::close() {
     if (enable_tracking()) {
-        std::cout << "transaction count: " << transaction_count() << std::endl;
-        std::cout << "retry count: " << retry_count() << std::endl;
-        std::cout << "transaction process time: " << transaction_process_time().load().count() << std::endl;
-        std::cout << "transaction wait time: "  << transaction_wait_time().load().count() << std::endl;
+        MetricsSnapshot snapshot{};
+        metrics_.snapshot(snapshot);
+        std::cout << snapshot;
     }
     api::fin(false);
     active_ = false;
@@ -26,7 +26,11 @@
 #include "sharksfin/api.h"
 #include "sharksfin/Slice.h"
 #include "Error.h"
+#include "ContentionGate.h"
 #include "StorageCache.h"
+#include "flight_recorder.h"
+#include "hot_key_tracker.h"
+#include "metrics.h"
 
 namespace sharksfin::shirakami {
 
@@ -46,11 +50,6 @@ class Database {
 public:
     using clock = std::chrono::steady_clock;
 
-    /**
-     * @brief the tracking time period.
-     */
-    using tracking_time_period = std::chrono::microseconds;
-
     /**
      * @brief setup shirakami engine and return Database.
      * @deprecated kept for compatibility. Use open(DatabaseOptions, void*, std::unique_ptr<Database>*) instead.
@@ -120,7 +119,7 @@ public:
      * @return false otherwise
      */
     bool enable_tracking() const {
-        return enable_tracking_;
+        return metrics_.enabled();
     }
 
     /**
@@ -128,39 +127,39 @@ public:
      * @param on true to enable, false to disable
      */
     void enable_tracking(bool on) {
-        enable_tracking_ = on;
+        metrics_.enabled(on);
     }
 
     /**
-     * @brief returns the transaction count.
-     * @return the transaction count (not include retry count)
+     * @brief returns the metrics of this database.
+     * @return the metrics, which collects nothing unless performance tracking feature is enabled
      */
-    std::atomic_size_t& transaction_count() {
-        return transaction_count_;
+    common::metrics& metrics() noexcept {
+        return metrics_;
     }
 
     /**
-     * @brief returns the transaction retry count.
-     * @return the transaction retry count
+     * @brief returns the tracker of the keys which frequently caused transaction failures.
+     * @return the hot key tracker
      */
-    std::atomic_size_t& retry_count() {
-        return retry_count_;
+    common::hot_key_tracker& hot_keys() noexcept {
+        return hot_keys_;
     }
 
     /**
-     * @brief return the transaction process time.
-     * @return the duration of user operation in transaction process
+     * @brief returns the flight recorder of this database.
+     * @return the flight recorder
      */
-    std::atomic<tracking_time_period>& transaction_process_time() {
-        return transaction_process_time_;
+    common::flight_recorder& flight_recorder() noexcept {
+        return flight_recorder_;
     }
 
     /**
-     * @brief return the transaction wait time.
-     * @return the duration of system operation in transaction process
+     * @brief returns the gate to serialize retries of transactions conflicting on the same key.
+     * @return the contention gate
      */
-    std::atomic<tracking_time_period>& transaction_wait_time() {
-        return transaction_wait_time_;
+    ContentionGate& contention_gate() noexcept {
+        return contention_gate_;
     }
 
     /**
@@ -200,13 +199,12 @@ public:
 private:
     std::mutex mutex_for_storage_metadata_{};
     StorageCache storage_cache_{};
+    ContentionGate contention_gate_{};
     std::unique_ptr<Storage> default_storage_;
 
-    bool enable_tracking_ { false };
-    std::atomic_size_t transaction_count_ {};
-    std::atomic_size_t retry_count_ {};
-    std::atomic<tracking_time_period> transaction_process_time_ {};
-    std::atomic<tracking_time_period> transaction_wait_time_ {};
+    common::metrics metrics_{};
+    common::hot_key_tracker hot_keys_{};
+    common::flight_recorder flight_recorder_{};
 
     bool waits_for_commit_ { true };
     bool active_{ true };
@@ -15,6 +15,8 @@
  */
 #include "Iterator.h"
 
+#include <utility>
+
 #include "glog/logging.h"
 #include "sharksfin/api.h"
 #include "Database.h"
@@ -26,6 +28,7 @@
 #include "logging.h"
 #include "logging_helper.h"
 #include "correct_transaction.h"
+#include "batch_writer.h"
 
 namespace sharksfin::shirakami {
 
@@ -37,7 +40,8 @@ Iterator::Iterator(
     Slice end_key,
     EndPointKind end_kind,
     std::size_t limit,
-    bool reverse) :
+    bool reverse,
+    bool key_only) :
     owner_(owner),
     state_(State::INIT),
     tx_(tx),
@@ -46,23 +50,85 @@ Iterator::Iterator(
     end_key_(end_kind == EndPointKind::UNBOUND ? std::string_view{} : end_key.to_string_view()),
     end_kind_(end_kind),
     limit_(limit),
-    reverse_(reverse) {}
+    reverse_(reverse),
+    key_only_(key_only) {}
 
 Iterator::~Iterator() {
-    if(need_scan_close_) {
-        auto rc = api::close_scan(tx_->native_handle(), handle_);
-        tx_->last_call_status(rc);
-        if(rc == Status::WARN_INVALID_HANDLE || rc == Status::WARN_NOT_BEGIN) {
-            // the handle was already invalidated due to some error (e.g. ERR_ILLEGAL_STATE) and tx aborted on shirakami
-            // we can safely ignore this error since the handle is already released on shirakami side
-        } else if (rc != Status::OK) {
-            // internal error, fix if this actually happens
-            LOG_LP(ERROR) << "closing scan failed:" << rc;
-        }
+    if (read_ahead_) {
+        // stop the helper thread before closing scan
+        read_ahead_.reset();
+        tx_->detach(this);
     }
+    close_cursor();
 }
 
 StatusCode Iterator::next() {
+    if (hold_) {
+        hold_ = false;
+        return StatusCode::OK;
+    }
+    if (read_ahead_) {
+        if (! tx_->active()) {
+            return StatusCode::ERR_INACTIVE_TRANSACTION;
+        }
+        auto rc = read_ahead_->next();
+        if (rc == StatusCode::OK) {
+            tx_->last_call_status(Status::OK);
+        } else {
+            apply_deferred_status();
+        }
+        return rc;
+    }
+    return next_direct();
+}
+
+StatusCode Iterator::next_direct() {
+    while (true) {
+        auto rc = next_in_ranges();
+        if (rc != StatusCode::OK || filter_ == nullptr) {
+            return rc;
+        }
+        bool accepted = false;
+        rc = test_filter(accepted);
+        if (rc != StatusCode::OK) {
+            return rc;
+        }
+        if (accepted) {
+            return StatusCode::OK;
+        }
+    }
+}
+
+StatusCode Iterator::test_filter(bool& accepted) {
+    Slice k{};
+    Slice v{};
+    auto rc = key_direct(k);
+    if (rc == StatusCode::OK && ! key_only_) {
+        rc = value_direct(v);
+    }
+    if (rc == StatusCode::NOT_FOUND) {
+        // the entry was removed concurrently - skip it
+        accepted = false;
+        return StatusCode::OK;
+    }
+    if (rc != StatusCode::OK) {
+        return rc;
+    }
+    accepted = filter_(k, v, filter_context_);
+    return StatusCode::OK;
+}
+
+StatusCode Iterator::next_in_ranges() {
+    auto rc = next_in_range();
+    while (rc == StatusCode::NOT_FOUND && range_index_ + 1 < range_count_) {
+        ++range_index_;
+        bind(ranges_[range_index_]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        rc = next_in_range();
+    }
+    return rc;
+}
+
+StatusCode Iterator::next_in_range() {
     if (state_ == State::END) {
         return StatusCode::NOT_FOUND;
     }
@@ -92,32 +158,262 @@ StatusCode Iterator::resolve_scan_errors(Status res) {
 }
 
 StatusCode Iterator::key(Slice& s) {
+    if (read_ahead_) {
+        return read_ahead_->key(s);
+    }
+    return key_direct(s);
+}
+
+StatusCode Iterator::key_direct(Slice& s) {
     if (! key_value_readable_) {
         return StatusCode::ERR_INVALID_STATE;
     }
+    if (key_cached_) {
+        s = buffer_key_;
+        return StatusCode::OK;
+    }
     auto res = api::read_key_from_scan(*tx_, handle_, buffer_key_);
-    tx_->last_call_status(res);
+    report(res);
     s = buffer_key_;
-    correct_transaction_state(*tx_, res);
+    key_cached_ = res == Status::OK;
     return resolve_scan_errors(res);
 }
 
 StatusCode Iterator::value(Slice& s) {
+    if (key_only_) {
+        return StatusCode::ERR_ILLEGAL_OPERATION;
+    }
+    Slice whole{};
+    auto rc = read_ahead_ ? read_ahead_->value(whole) : value_direct(whole);
+    s = whole.subslice(window_offset_, window_length_);
+    return rc;
+}
+
+StatusCode Iterator::value_direct(Slice& s) {
     if (! key_value_readable_) {
         return StatusCode::ERR_INVALID_STATE;
     }
+    if (value_cached_) {
+        s = buffer_value_;
+        return StatusCode::OK;
+    }
     auto res = api::read_value_from_scan(*tx_, handle_, buffer_value_);
-    tx_->last_call_status(res);
+    report(res);
     s = buffer_value_;
-    correct_transaction_state(*tx_, res);
+    value_cached_ = res == Status::OK;
     return resolve_scan_errors(res);
 }
 
+StatusCode Iterator::read_ahead(std::size_t rows) {
+    if (rows == 0) {
+        return StatusCode::ERR_INVALID_ARGUMENT;
+    }
+    if (! tx_->readonly() || state_ != State::INIT || read_ahead_) {
+        return StatusCode::ERR_ILLEGAL_OPERATION;
+    }
+    read_ahead_ = std::make_unique<ReadAhead>(
+        [this](std::string& key, std::string& value) { return fetch_row(key, value); },
+        rows);
+    read_ahead_rows_ = rows;
+    tx_->attach(this);
+    return StatusCode::OK;
+}
+
+void Iterator::stop_read_ahead() {
+    if (read_ahead_) {
+        read_ahead_->stop();
+    }
+}
+
+void Iterator::ranges(ScanRange const* ranges, std::size_t count) {
+    ranges_ = ranges;
+    range_count_ = count;
+    range_index_ = 0;
+    if (count == 0) {
+        state_ = State::END;
+        return;
+    }
+    bind(ranges_[0]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+StatusCode Iterator::filter(ScanFilter filter, void* context) {
+    if (read_ahead_) {
+        // the helper thread may be evaluating the current filter
+        return StatusCode::ERR_ILLEGAL_OPERATION;
+    }
+    filter_ = filter;
+    filter_context_ = context;
+    return StatusCode::OK;
+}
+
+StatusCode Iterator::seek(Slice key, EndPointKind kind) {
+    if (! tx_->active()) {
+        return StatusCode::ERR_INACTIVE_TRANSACTION;
+    }
+    if (ranges_ != nullptr) {
+        return StatusCode::ERR_ILLEGAL_OPERATION;
+    }
+    if (read_ahead_) {
+        // keep the read-ahead buffers alive because the key may point to them
+        read_ahead_->stop();
+    }
+    begin_key_.assign(kind == EndPointKind::UNBOUND ? std::string_view{} : key.to_string_view());
+    begin_kind_ = kind;
+    restart();
+    return StatusCode::OK;
+}
+
+StatusCode Iterator::rebind(Slice begin_key, EndPointKind begin_kind, Slice end_key, EndPointKind end_kind) {
+    if (! tx_->active()) {
+        return StatusCode::ERR_INACTIVE_TRANSACTION;
+    }
+    if (read_ahead_) {
+        read_ahead_->stop();
+    }
+    begin_key_.assign(begin_kind == EndPointKind::UNBOUND ? std::string_view{} : begin_key.to_string_view());
+    begin_kind_ = begin_kind;
+    end_key_.assign(end_kind == EndPointKind::UNBOUND ? std::string_view{} : end_key.to_string_view());
+    end_kind_ = end_kind;
+    ranges_ = nullptr;
+    range_count_ = 0;
+    range_index_ = 0;
+    restart();
+    return StatusCode::OK;
+}
+
+void Iterator::bind(ScanRange const& range) {
+    begin_key_.assign(range.begin_kind == EndPointKind::UNBOUND ? std::string_view{} : range.begin_key.to_string_view());
+    begin_kind_ = range.begin_kind;
+    end_key_.assign(range.end_kind == EndPointKind::UNBOUND ? std::string_view{} : range.end_key.to_string_view());
+    end_kind_ = range.end_kind;
+    reset_cursor();
+}
+
+void Iterator::reset_cursor() {
+    close_cursor();
+    state_ = State::INIT;
+    key_value_readable_ = false;
+    hold_ = false;
+    key_cached_ = false;
+    value_cached_ = false;
+}
+
+void Iterator::restart() {
+    auto read_ahead = static_cast<bool>(read_ahead_);
+    read_ahead_.reset();
+    if (read_ahead) {
+        // the helper thread has stopped, and its status is not delivered to the consumer anymore
+        apply_deferred_status();
+    }
+    reset_cursor();
+    if (read_ahead) {
+        read_ahead_ = std::make_unique<ReadAhead>(
+            [this](std::string& key, std::string& value) { return fetch_row(key, value); },
+            read_ahead_rows_);
+    }
+}
+
+StatusCode Iterator::fetch_row(std::string& key, std::string& value) {
+    // this runs on the helper thread, so that the transaction state is left to the consumer thread
+    deferred_ = true;
+    StatusCode rc{};
+    while (true) {
+        if (rc = next_direct(); rc != StatusCode::OK) {
+            break;
+        }
+        Slice k{};
+        Slice v{};
+        rc = key_direct(k);
+        if (rc == StatusCode::OK && ! key_only_) {
+            rc = value_direct(v);
+        }
+        if (rc == StatusCode::NOT_FOUND) {
+            // the entry was removed concurrently - skip it
+            continue;
+        }
+        if (rc == StatusCode::OK) {
+            key.assign(k.to_string_view());
+            value.assign(v.to_string_view());
+        }
+        break;
+    }
+    deferred_ = false;
+    return rc;
+}
+
+template<class Writer>
+StatusCode Iterator::fetch_rows(std::size_t max_rows, Writer& writer) {
+    if (max_rows == 0) {
+        return StatusCode::ERR_INVALID_ARGUMENT;
+    }
+    while (writer.size() < max_rows) {
+        if (auto rc = next(); rc != StatusCode::OK) {
+            if (rc == StatusCode::NOT_FOUND && writer.size() > 0) {
+                return StatusCode::OK;
+            }
+            return rc;
+        }
+        Slice k{};
+        Slice v{};
+        auto rc = key(k);
+        if (rc == StatusCode::OK && ! key_only_) {
+            rc = value(v);
+        }
+        if (rc == StatusCode::NOT_FOUND) {
+            // the entry was removed concurrently - skip it
+            continue;
+        }
+        if (rc == StatusCode::CONCURRENT_OPERATION) {
+            hold_ = true;
+            return writer.size() > 0 ? StatusCode::OK : rc;
+        }
+        if (rc != StatusCode::OK) {
+            return rc;
+        }
+        if (! writer.append(k, v)) {
+            hold_ = true;
+            return writer.size() > 0 ? StatusCode::OK : StatusCode::ERR_RESOURCE_LIMIT_REACHED;
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode Iterator::next_batch(std::size_t max_rows, std::size_t max_bytes, IteratorBatch& out) {
+    common::row_batch_writer writer{out, max_bytes};
+    return fetch_rows(max_rows, writer);
+}
+
+StatusCode Iterator::next_columns(std::size_t max_rows, IteratorColumns& out) {
+    common::column_batch_writer writer{out};
+    return fetch_rows(max_rows, writer);
+}
+
 StatusCode Iterator::next_cursor() {
+    key_cached_ = false;
+    value_cached_ = false;
     auto res = api::next(tx_->native_handle(), handle_);
+    report(res);
+    return resolve_scan_errors(res);
+}
+
+void Iterator::report(Status res) {
+    if (deferred_) {
+        // keep the last warning or error, which stopped the helper thread
+        if (res != Status::OK) {
+            deferred_status_ = res;
+        }
+        return;
+    }
     tx_->last_call_status(res);
     correct_transaction_state(*tx_, res);
-    return resolve_scan_errors(res);
+}
+
+void Iterator::apply_deferred_status() {
+    auto res = std::exchange(deferred_status_, Status::OK);
+    if (res != Status::OK) {
+        tx_->last_call_status(res);
+        correct_transaction_state(*tx_, res);
+    }
 }
 
 /**
@@ -147,6 +443,8 @@ StatusCode Iterator::open_cursor() {
     scan_endpoint begin_endpoint{scan_endpoint::INF};
     scan_endpoint end_endpoint{scan_endpoint::INF};
     key_value_readable_ = false;
+    key_cached_ = false;
+    value_cached_ = false;
     switch (begin_kind_) {
         case EndPointKind::UNBOUND:
             if(! begin_key_.empty()) {
@@ -171,7 +469,9 @@ StatusCode Iterator::open_cursor() {
                 state_ = State::END;
                 return StatusCode::NOT_FOUND;
             }
+            // keep the normalized end point so that the range can be reused by seek()
             begin_key_ = n;
+            begin_kind_ = EndPointKind::INCLUSIVE;
             break;
     }
     switch (end_kind_) {
@@ -189,8 +489,10 @@ StatusCode Iterator::open_cursor() {
                 // there is no neighbor - upper bound is unlimited
                 end_key_.clear();
                 end_endpoint = scan_endpoint::INF;
+                end_kind_ = EndPointKind::UNBOUND;
             } else {
                 end_key_ = n;
+                end_kind_ = EndPointKind::EXCLUSIVE;
             }
             break;
         }
@@ -207,8 +509,7 @@ StatusCode Iterator::open_cursor() {
         owner_->handle(),
         begin_key_, begin_endpoint,
         end_key_, end_endpoint, handle_, limit_, reverse_);
-    tx_->last_call_status(res);
-    correct_transaction_state(*tx_, res);
+    report(res);
     if(res == Status::WARN_NOT_FOUND) {
         state_ = State::SAW_EOF;
         return StatusCode::NOT_FOUND;
@@ -219,4 +520,22 @@ StatusCode Iterator::open_cursor() {
     return resolve(res);
 }
 
+void Iterator::close_cursor() {
+    if(! need_scan_close_) {
+        return;
+    }
+    need_scan_close_ = false;
+    auto rc = api::close_scan(tx_->native_handle(), handle_);
+    if (! deferred_) {
+        tx_->last_call_status(rc);
+    }
+    if(rc == Status::WARN_INVALID_HANDLE || rc == Status::WARN_NOT_BEGIN) {
+        // the handle was already invalidated due to some error (e.g. ERR_ILLEGAL_STATE) and tx aborted on shirakami
+        // we can safely ignore this error since the handle is already released on shirakami side
+    } else if (rc != Status::OK) {
+        // internal error, fix if this actually happens
+        LOG_LP(ERROR) << "closing scan failed:" << rc;
+    }
+}
+
 }  // namespace sharksfin::shirakami
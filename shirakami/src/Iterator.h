@@ -16,9 +16,12 @@
 #ifndef SHARKSFIN_SHIRAKAMI_ITERATOR_H_
 #define SHARKSFIN_SHIRAKAMI_ITERATOR_H_
 
+#include <memory>
+
 #include "glog/logging.h"
 #include "shirakami/scheme.h"
 #include "sharksfin/api.h"
+#include "ReadAhead.h"
 
 namespace sharksfin::shirakami {
 
@@ -48,6 +51,7 @@ public:
      * If end_key is not empty and end kind UNBOUND, the end_kind is reduced to PREFIXED_INCLUSIVE
      * @param limit the max number of entries to be fetched. 0 indicates no limit.
      * @param reverse whether or not the iterator scans in reverse order (from end to begin)
+     * @param key_only whether or not the iterator never reads values
      */
     Iterator( // NOLINT(performance-unnecessary-value-param)
         Storage* owner,
@@ -55,7 +59,8 @@ public:
         Slice begin_key, EndPointKind begin_kind,
         Slice end_key, EndPointKind end_kind,
         std::size_t limit = 0,
-        bool reverse = false
+        bool reverse = false,
+        bool key_only = false
     );
 
     /**
@@ -63,6 +68,14 @@ public:
      */
     ~Iterator();
 
+    /**
+     * @brief returns the transaction which this iterator belongs to.
+     * @return the owner transaction
+     */
+    [[nodiscard]] Transaction* transaction() const noexcept {
+        return tx_;
+    }
+
     /**
      * @brief advances this iterator position.
      * @return StatusCode::OK if next entry exists
@@ -74,6 +87,7 @@ public:
 
     /**
      * @brief retrieve the key
+     * @details the key is read from shirakami at most once for each position.
      * @param s [out] key on the current position
      * @return StatusCode::OK if next entry exists
      * @return StatusCode::NOT_FOUND if next entry does not exist
@@ -83,13 +97,126 @@ public:
 
     /**
      * @brief retrieve the value
+     * @details the value is read from shirakami at most once for each position.
+     * If the value window is set, this only returns the range of the value.
      * @param s [out] value on the current position
      * @return StatusCode::OK if next entry exists
      * @return StatusCode::NOT_FOUND if next entry does not exist
      * @return StatusCode::ERR_ABORTED_RETRYABLE when shirakami scans uncommitted record
+     * @return StatusCode::ERR_ILLEGAL_OPERATION if this iterator is key only
      */
     StatusCode value(Slice& s);
 
+    /**
+     * @brief restricts the values into the range.
+     * @param offset the offset (in bytes) of the range in each value
+     * @param length the maximum length (in bytes) of the range
+     */
+    void value_window(std::size_t offset, std::size_t length) noexcept {
+        window_offset_ = offset;
+        window_length_ = length;
+    }
+
+    /**
+     * @brief advances this iterator and copies the subsequent entries into the given buffer.
+     * @details the entry which does not fit into max_bytes is kept, and it becomes the next position of next() or
+     * next_batch().
+     * @param max_rows the maximum number of rows to fetch
+     * @param max_bytes the maximum number of total bytes of keys and values to fetch
+     * @param out [out] the buffer to receive the rows
+     * @return StatusCode::OK if one or more rows were fetched
+     * @return StatusCode::NOT_FOUND if next entry does not exist
+     * @return StatusCode::ERR_RESOURCE_LIMIT_REACHED if the next entry is larger than max_bytes
+     * @return otherwise if error occurred
+     * @see iterator_next_batch()
+     */
+    StatusCode next_batch(std::size_t max_rows, std::size_t max_bytes, IteratorBatch& out);
+
+    /**
+     * @brief advances this iterator and copies the subsequent entries into the given column buffers.
+     * @details the entry which does not fit into the buffers is kept, and it becomes the next position.
+     * @param max_rows the maximum number of rows to fetch
+     * @param out [out] the column buffers to receive the rows
+     * @return StatusCode::OK if one or more rows were fetched
+     * @return StatusCode::NOT_FOUND if next entry does not exist
+     * @return StatusCode::ERR_RESOURCE_LIMIT_REACHED if the next entry is larger than the buffers
+     * @return otherwise if error occurred
+     * @see iterator_next_columns()
+     */
+    StatusCode next_columns(std::size_t max_rows, IteratorColumns& out);
+
+    /**
+     * @brief enables read-ahead of this iterator.
+     * @details after this, a helper thread fetches the subsequent rows ahead of the consumer in the batches of
+     * the given rows. This is only available for read-only transactions, because the helper thread calls the
+     * transaction engine concurrently with the other operations in the same transaction.
+     * This iterator is registered to the owner transaction, which stops the helper thread before it is committed,
+     * aborted, or reset. The helper thread never changes the transaction state, and the status it encountered is
+     * applied to the transaction when the consumer reaches the row where the helper thread stopped.
+     * @param rows the number of rows in each batch
+     * @return StatusCode::OK if read-ahead is successfully enabled
+     * @return StatusCode::ERR_INVALID_ARGUMENT if rows is 0
+     * @return StatusCode::ERR_ILLEGAL_OPERATION if the transaction is not read-only, or this iterator was already
+     * advanced
+     * @see iterator_set_read_ahead()
+     */
+    StatusCode read_ahead(std::size_t rows);
+
+    /**
+     * @brief stops the helper thread of read-ahead.
+     * @details this waits for the on-going fetch of the helper thread. After this, next() returns
+     * StatusCode::ERR_INACTIVE_TRANSACTION if the transaction has finished, or StatusCode::ERR_INVALID_STATE when the
+     * rows already fetched are exhausted.
+     * This does nothing if read-ahead is not enabled.
+     */
+    void stop_read_ahead();
+
+    /**
+     * @brief moves the beginning position of this iterator.
+     * @details this keeps the ending position, and the next call of next() returns the first entry from the new
+     * beginning position. This object and its buffers are reused, but the scan on the transaction engine is reopened.
+     * @param key the content key of the new beginning position
+     * @param kind end-point kind of the new beginning position
+     * @return StatusCode::OK if the position was successfully moved
+     * @return otherwise if error occurred
+     * @see iterator_seek()
+     */
+    StatusCode seek(Slice key, EndPointKind kind);
+
+    /**
+     * @brief replaces the key range of this iterator.
+     * @details the next call of next() returns the first entry in the new range.
+     * This object and its buffers are reused, but the scan on the transaction engine is reopened.
+     * @param begin_key the content key of beginning position
+     * @param begin_kind end-point kind of the beginning position
+     * @param end_key the content key of ending position
+     * @param end_kind end-point kind of the ending position
+     * @return StatusCode::OK if the range was successfully replaced
+     * @return otherwise if error occurred
+     * @see iterator_rebind()
+     */
+    StatusCode rebind(Slice begin_key, EndPointKind begin_kind, Slice end_key, EndPointKind end_kind);
+
+    /**
+     * @brief makes this iterator walk the multiple key ranges.
+     * @details this must be called before the first call of next().
+     * @param ranges the sorted and disjoint key ranges, which must be kept while using this iterator
+     * @param count the number of ranges
+     * @see content_scan_multi()
+     */
+    void ranges(ScanRange const* ranges, std::size_t count);
+
+    /**
+     * @brief sets the filter of the rows.
+     * @details the rows for which the filter returns false are skipped in next().
+     * @param filter the filter function, or nullptr to clear the filter
+     * @param context the context pointer passed to the filter
+     * @return StatusCode::OK if the filter was successfully set
+     * @return StatusCode::ERR_ILLEGAL_OPERATION if read-ahead is enabled
+     * @see iterator_set_filter()
+     */
+    StatusCode filter(ScanFilter filter, void* context);
+
 private:
     Storage* owner_{};
     ::shirakami::ScanHandle handle_{};
@@ -105,10 +232,41 @@ private:
     bool reverse_{};
     bool key_value_readable_{false};
     bool need_scan_close_{false};
+    bool hold_{false};
+    bool key_only_{false};
+    bool key_cached_{false};
+    bool value_cached_{false};
+    std::size_t window_offset_{};
+    std::size_t window_length_{static_cast<std::size_t>(-1)};
+    std::unique_ptr<ReadAhead> read_ahead_{};
+    std::size_t read_ahead_rows_{};
+    ScanRange const* ranges_{};
+    std::size_t range_count_{};
+    std::size_t range_index_{};
+    ScanFilter filter_{};
+    void* filter_context_{};
+    bool deferred_{false};
+    ::shirakami::Status deferred_status_{::shirakami::Status::OK};
 
+    StatusCode next_direct();
+    StatusCode next_in_range();
+    StatusCode next_in_ranges();
+    StatusCode test_filter(bool& accepted);
+    void bind(ScanRange const& range);
+    void reset_cursor();
+    StatusCode key_direct(Slice& s);
+    StatusCode value_direct(Slice& s);
+    StatusCode fetch_row(std::string& key, std::string& value);
     StatusCode next_cursor();
     StatusCode open_cursor();
+    void close_cursor();
+    void restart();
     StatusCode resolve_scan_errors(::shirakami::Status res);
+    void report(::shirakami::Status res);
+    void apply_deferred_status();
+
+    template<class Writer>
+    StatusCode fetch_rows(std::size_t max_rows, Writer& writer);
 };
 
 }  // namespace sharksfin::shirakami
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_SHIRAKAMI_KEY_SAMPLER_H_
+#define SHARKSFIN_SHIRAKAMI_KEY_SAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sharksfin/Slice.h"
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief systematic sampler over the ordered key sequence.
+ * @details this keeps every stride-th key offered in the ascending order. When the number of samples reaches twice
+ * the capacity, the odd samples are dropped and the stride is doubled, so that the samples are always evenly spaced
+ * over the offered keys while the memory usage is bounded.
+ */
+class KeySampler {
+public:
+    /**
+     * @brief create new object
+     * @param capacity the minimum number of samples to keep, must be positive
+     */
+    explicit KeySampler(std::size_t capacity) noexcept :
+        capacity_(capacity)
+    {}
+
+    /**
+     * @brief offers the next key.
+     * @param key the key, must be greater than the previously offered keys
+     */
+    void offer(Slice key) {
+        if (count_ % stride_ == 0) {
+            samples_.emplace_back(key.to_string_view());
+            if (samples_.size() >= capacity_ * 2) {
+                compact();
+            }
+        }
+        ++count_;
+    }
+
+    /**
+     * @brief returns the number of offered keys.
+     * @return the number of offered keys
+     */
+    [[nodiscard]] std::size_t count() const noexcept {
+        return count_;
+    }
+
+    /**
+     * @brief computes the keys which split the offered keys into the given number of partitions.
+     * @param partitions the number of partitions, must be positive
+     * @param out [OUT] the distinct split keys in ascending order, at most (partitions - 1) elements.
+     * The first key offered is never included.
+     */
+    void split_points(std::size_t partitions, std::vector<std::string>& out) const {
+        out.clear();
+        std::size_t last = 0;
+        for (std::size_t i = 1; i < partitions; ++i) {
+            auto index = i * samples_.size() / partitions;
+            if (index == last) {
+                continue;
+            }
+            out.emplace_back(samples_[index]);
+            last = index;
+        }
+    }
+
+    /**
+     * @brief computes the keys which split the key space between the given keys into the given number of partitions.
+     * @details this interpolates the keys as if the bytes after the common prefix were a big-endian integer, so that the
+     * result is close to the actual split points only if the keys are distributed uniformly. Use this to estimate the
+     * split points of the key range without reading the keys in the range.
+     * @param lower the lower bound key
+     * @param upper the upper bound key
+     * @param partitions the number of partitions, must be positive
+     * @param out [OUT] the distinct keys in ascending order, which are between the lower and upper keys,
+     * at most (partitions - 1) elements
+     */
+    static void interpolate(
+            std::string_view lower,
+            std::string_view upper,
+            std::size_t partitions,
+            std::vector<std::string>& out) {
+        out.clear();
+        std::size_t prefix = 0;
+        while (prefix < lower.size() && prefix < upper.size() && lower[prefix] == upper[prefix]) {
+            ++prefix;
+        }
+        auto lo = to_integer(lower.substr(prefix));
+        auto hi = to_integer(upper.substr(prefix));
+        if (hi <= lo) {
+            return;
+        }
+        auto width = hi - lo;
+        for (std::size_t i = 1; i < partitions; ++i) {
+            // avoid overflow of width * i
+            auto offset = width / partitions * i + width % partitions * i / partitions;
+            std::string key{lower.substr(0, prefix)};
+            from_integer(lo + offset, key);
+            if (key <= lower || key >= upper || (! out.empty() && key <= out.back())) {
+                continue;
+            }
+            out.emplace_back(std::move(key));
+        }
+    }
+
+private:
+    static constexpr std::size_t integer_bytes = sizeof(std::uint64_t);
+
+    std::size_t capacity_;
+    std::size_t stride_{1};
+    std::size_t count_{};
+    std::vector<std::string> samples_{};
+
+    static std::uint64_t to_integer(std::string_view bytes) noexcept {
+        std::uint64_t ret = 0;
+        for (std::size_t i = 0; i < integer_bytes; ++i) {
+            ret <<= 8U;
+            if (i < bytes.size()) {
+                ret |= static_cast<unsigned char>(bytes[i]);
+            }
+        }
+        return ret;
+    }
+
+    static void from_integer(std::uint64_t value, std::string& out) {
+        std::size_t size = integer_bytes;
+        while (size > 1 && ((value >> ((integer_bytes - size) * 8U)) & 0xffU) == 0) {
+            // omit trailing zeros
+            --size;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            out.push_back(static_cast<char>((value >> ((integer_bytes - 1 - i) * 8U)) & 0xffU));
+        }
+    }
+
+    void compact() {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < samples_.size(); i += 2) {
+            samples_[n++] = std::move(samples_[i]);
+        }
+        samples_.resize(n);
+        stride_ *= 2;
+    }
+};
+
+}  // namespace sharksfin::shirakami
+
+#endif  // SHARKSFIN_SHIRAKAMI_KEY_SAMPLER_H_
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ReadAhead.h"
+
+#include <utility>
+
+namespace sharksfin::shirakami {
+
+ReadAhead::ReadAhead(fetch_type fetch, std::size_t batch_rows) :
+    fetch_(std::move(fetch)),
+    batch_rows_(batch_rows),
+    worker_([this]() { run(); })
+{}
+
+ReadAhead::~ReadAhead() {
+    stop();
+}
+
+void ReadAhead::stop() {
+    {
+        std::unique_lock lk{mutex_};
+        stopped_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+StatusCode ReadAhead::next() {
+    if (readable_ && position_ + 1 < front_->size_) {
+        ++position_;
+        return StatusCode::OK;
+    }
+    readable_ = false;
+    if (front_->status_ != StatusCode::OK) {
+        // the end of rows, or the fetch failed
+        return front_->status_;
+    }
+    {
+        std::unique_lock lk{mutex_};
+        cv_.wait(lk, [this]() { return ready_ || stopped_; });
+        if (! ready_) {
+            // prefetching was stopped before the next rows were fetched
+            return StatusCode::ERR_INVALID_STATE;
+        }
+        std::swap(front_, back_);
+        ready_ = false;
+    }
+    cv_.notify_all();
+    position_ = 0;
+    if (front_->size_ == 0) {
+        return front_->status_;
+    }
+    readable_ = true;
+    return StatusCode::OK;
+}
+
+StatusCode ReadAhead::key(Slice& s) const noexcept {
+    if (! readable_) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    s = front_->keys_[position_];
+    return StatusCode::OK;
+}
+
+StatusCode ReadAhead::value(Slice& s) const noexcept {
+    if (! readable_) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    s = front_->values_[position_];
+    return StatusCode::OK;
+}
+
+void ReadAhead::run() {
+    while (true) {
+        {
+            std::unique_lock lk{mutex_};
+            cv_.wait(lk, [this]() { return ! ready_ || stopped_; });
+            if (stopped_) {
+                return;
+            }
+        }
+        // only the worker touches the back buffer until it becomes ready
+        fill(*back_);
+        auto status = back_->status_;
+        {
+            std::unique_lock lk{mutex_};
+            ready_ = true;
+        }
+        cv_.notify_all();
+        if (status != StatusCode::OK) {
+            return;
+        }
+    }
+}
+
+void ReadAhead::fill(buffer& target) {
+    target.size_ = 0;
+    target.status_ = StatusCode::OK;
+    while (target.size_ < batch_rows_) {
+        if (target.keys_.size() <= target.size_) {
+            target.keys_.emplace_back();
+            target.values_.emplace_back();
+        }
+        auto rc = fetch_(target.keys_[target.size_], target.values_[target.size_]);
+        if (rc != StatusCode::OK) {
+            target.status_ = rc;
+            return;
+        }
+        ++target.size_;
+    }
+}
+
+}  // namespace sharksfin::shirakami
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_SHIRAKAMI_READ_AHEAD_H_
+#define SHARKSFIN_SHIRAKAMI_READ_AHEAD_H_
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sharksfin/Slice.h"
+#include "sharksfin/StatusCode.h"
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief double-buffered row prefetcher.
+ * @details a helper thread fetches the subsequent rows into the back buffer while the consumer reads rows from the
+ * front buffer, and the buffers are swapped when the consumer reaches the end of the front buffer.
+ * The fetch function is only called from the helper thread.
+ */
+class ReadAhead {
+public:
+    /**
+     * @brief the function type to fetch the next row.
+     * @details the function stores the next row into the given key and value, and returns StatusCode::OK.
+     * Otherwise, it returns StatusCode::NOT_FOUND if there are no more rows, or an error status.
+     */
+    using fetch_type = std::function<StatusCode(std::string& key, std::string& value)>;
+
+    /**
+     * @brief creates a new instance and starts prefetching.
+     * @param fetch the function to fetch the next row
+     * @param batch_rows the maximum number of rows in each buffer, must be positive
+     */
+    ReadAhead(fetch_type fetch, std::size_t batch_rows);
+
+    ReadAhead(ReadAhead const& other) = delete;
+    ReadAhead& operator=(ReadAhead const& other) = delete;
+    ReadAhead(ReadAhead&& other) noexcept = delete;
+    ReadAhead& operator=(ReadAhead&& other) noexcept = delete;
+
+    /**
+     * @brief stops prefetching and destroys this object.
+     * @details this waits for the on-going fetch function call.
+     */
+    ~ReadAhead();
+
+    /**
+     * @brief stops prefetching.
+     * @details this waits for the on-going fetch function call, and then the fetch function is never called.
+     * The current row and the rows already fetched are still available, and then next() returns
+     * StatusCode::ERR_INVALID_STATE.
+     * This does nothing if prefetching was already stopped.
+     */
+    void stop();
+
+    /**
+     * @brief advances the current row.
+     * @return StatusCode::OK if the next row exists
+     * @return StatusCode::NOT_FOUND if there are no more rows
+     * @return StatusCode::ERR_INVALID_STATE if prefetching was stopped before fetching the next row
+     * @return otherwise if error occurred while fetching the row
+     */
+    StatusCode next();
+
+    /**
+     * @brief returns the key of the current row.
+     * @param s [out] the key
+     * @return StatusCode::OK if the key was obtained
+     * @return StatusCode::ERR_INVALID_STATE if the current row is not available
+     */
+    StatusCode key(Slice& s) const noexcept;
+
+    /**
+     * @brief returns the value of the current row.
+     * @param s [out] the value
+     * @return StatusCode::OK if the value was obtained
+     * @return StatusCode::ERR_INVALID_STATE if the current row is not available
+     */
+    StatusCode value(Slice& s) const noexcept;
+
+private:
+    struct buffer {
+        std::vector<std::string> keys_{};
+        std::vector<std::string> values_{};
+        std::size_t size_{};
+        StatusCode status_{StatusCode::OK};
+    };
+
+    fetch_type fetch_;
+    std::size_t batch_rows_;
+    std::array<buffer, 2> buffers_{};
+    buffer* front_{&buffers_[0]};
+    buffer* back_{&buffers_[1]};
+    std::size_t position_{};
+    bool readable_{false};
+    bool ready_{false};
+    bool stopped_{false};
+    std::mutex mutex_{};
+    std::condition_variable cv_{};
+    std::thread worker_{};
+
+    void run();
+    void fill(buffer& target);
+};
+
+}  // namespace sharksfin::shirakami
+
+#endif  // SHARKSFIN_SHIRAKAMI_READ_AHEAD_H_
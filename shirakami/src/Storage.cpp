@@ -17,14 +17,30 @@
 
 #include <memory>
 
+#include "Database.h"
 #include "Iterator.h"
 #include "Transaction.h"
 #include "Error.h"
 #include "shirakami_api_helper.h"
 #include "correct_transaction.h"
+#include "flight_recorder.h"
 
 namespace sharksfin::shirakami {
 
+// records the finished operation, and the abort reason if the operation aborted the transaction
+static StatusCode record(
+        common::metrics& metrics,
+        Transaction& tx,
+        MetricsOperation op,
+        common::metrics::clock::time_point started,
+        StatusCode rc) {
+    metrics.record(op, started, rc);
+    if (! tx.active() && (metrics.enabled() || tx.owner()->flight_recorder().enabled() || tx.owner()->hot_keys().enabled())) {
+        metrics.record_abort(tx.record_error());
+    }
+    return rc;
+}
+
 StatusCode Storage::check(Transaction* tx, Slice key) {  //NOLINT(readability-make-member-function-const)
     if(! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
     auto res = api::exist_key(*tx, handle_, key.to_string_view());
@@ -35,16 +51,22 @@ StatusCode Storage::check(Transaction* tx, Slice key) {  //NOLINT(readability-ma
 
 StatusCode Storage::get(Transaction* tx, Slice key, std::string &buffer) {  //NOLINT(readability-make-member-function-const)
     if(! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto& metrics = owner_->metrics();
+    metrics.record_storage(name_, MetricsOperation::GET);
+    auto started = metrics.start();
     auto res = api::search_key(*tx, handle_, key.to_string_view(), buffer);
     tx->last_call_status(res);
     correct_transaction_state(*tx, res);
-    return resolve(res);
+    return record(metrics, *tx, MetricsOperation::GET, started, resolve(res));
 }
 
 StatusCode Storage::put(Transaction *tx, Slice key, Slice value, PutOperation operation, // NOLINT(readability-make-member-function-const)
                         blob_id_type const *blobs_data,
                         std::size_t blobs_size) {
     if(! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto& metrics = owner_->metrics();
+    metrics.record_storage(name_, MetricsOperation::PUT);
+    auto started = metrics.start();
     Status res{};
     switch(operation) {
         case PutOperation::CREATE: res = api::insert(*tx, handle_, key.to_string_view(), value.to_string_view(), blobs_data, blobs_size); break;
@@ -53,15 +75,18 @@ StatusCode Storage::put(Transaction *tx, Slice key, Slice value, PutOperation op
     }
     tx->last_call_status(res);
     correct_transaction_state(*tx, res);
-    return resolve(res);
+    return record(metrics, *tx, MetricsOperation::PUT, started, resolve(res));
 }
 
 StatusCode Storage::remove(Transaction* tx, Slice key) {  //NOLINT(readability-make-member-function-const)
     if(! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto& metrics = owner_->metrics();
+    metrics.record_storage(name_, MetricsOperation::DELETE);
+    auto started = metrics.start();
     auto res = api::delete_record(tx->native_handle(), handle_, key.to_string_view());
     tx->last_call_status(res);
     correct_transaction_state(*tx, res);
-    return resolve(res);
+    return record(metrics, *tx, MetricsOperation::DELETE, started, resolve(res));
 }
 
 StatusCode Storage::scan(Transaction* tx,
@@ -69,12 +94,13 @@ StatusCode Storage::scan(Transaction* tx,
         Slice end_key, EndPointKind end_kind,
         std::unique_ptr<Iterator>& out,
         std::size_t limit,
-        bool reverse
+        bool reverse,
+        bool key_only
 ) {
     if(! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
     out = std::make_unique<Iterator>(this, tx,
             begin_key, begin_kind,
-            end_key, end_kind, limit, reverse);
+            end_key, end_kind, limit, reverse, key_only);
     return StatusCode::OK;
 }
 
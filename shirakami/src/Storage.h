@@ -111,6 +111,7 @@ public:
      * @param out [OUT] the created iterator
      * @param limit the max number of entries to be fetched. 0 indicates no limit.
      * @param reverse whether or not the scan in reverse order (from end to begin)
+     * @param key_only whether or not the iterator never reads values
      * @return the operation status
      */
     StatusCode scan(Transaction* tx,
@@ -118,7 +119,8 @@ public:
             Slice end_key, EndPointKind end_kind,
             std::unique_ptr<Iterator>& out,
             std::size_t limit = 0,
-            bool reverse = false
+            bool reverse = false,
+            bool key_only = false
     );
 
     [[nodiscard]] Database* owner() const {
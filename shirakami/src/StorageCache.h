@@ -16,9 +16,12 @@
 #ifndef SHARKSFIN_SHIRAKAMI_STORAGE_CACHE_H_
 #define SHARKSFIN_SHIRAKAMI_STORAGE_CACHE_H_
 
+#include <map>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <shared_mutex>
+#include "shirakami/scheme.h"
 #include "sharksfin/Slice.h"
 
 namespace sharksfin::shirakami {
@@ -15,6 +15,8 @@
  */
 #include "Strand.h"
 
+#include <iterator>
+
 namespace sharksfin::shirakami {
 
 Strand::Strand(Transaction* parent) :
@@ -29,4 +31,48 @@ std::string& Strand::buffer() noexcept {
     return buffer_;
 }
 
+std::vector<std::string>& Strand::batch_buffers() noexcept {
+    return batch_buffers_;
+}
+
+void Strand::put(
+    Storage* storage,
+    Slice key,
+    Slice value,
+    PutOperation operation,
+    blob_id_type const* blobs_data,
+    std::size_t blobs_size) {
+    std::vector<blob_id_type> blobs{};
+    if (blobs_size > 0) {
+        blobs.assign(blobs_data, blobs_data + blobs_size);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    std::unique_lock lk{mutex_};
+    writes_.emplace_back(write_entry{storage, key.to_string(), value.to_string(), operation, std::move(blobs), false});
+    keys_[storage].emplace(key.to_string_view());
+}
+
+void Strand::remove(Storage* storage, Slice key) {
+    std::unique_lock lk{mutex_};
+    writes_.emplace_back(write_entry{storage, key.to_string(), {}, {}, {}, true});
+    keys_[storage].emplace(key.to_string_view());
+}
+
+bool Strand::buffered(Storage* storage, Slice key) const {
+    std::unique_lock lk{mutex_};
+    auto it = keys_.find(storage);
+    return it != keys_.end() && it->second.find(key.to_string_view()) != it->second.end();
+}
+
+void Strand::take_writes(std::vector<write_entry>& writes, key_set* keys) {
+    std::unique_lock lk{mutex_};
+    writes.insert(writes.end(), std::make_move_iterator(writes_.begin()), std::make_move_iterator(writes_.end()));
+    writes_.clear();
+    if (keys != nullptr) {
+        for (auto&& [storage, entries] : keys_) {
+            (*keys)[storage].merge(entries);
+        }
+    }
+    keys_.clear();
+}
+
 }  // namespace sharksfin::shirakami
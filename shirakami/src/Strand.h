@@ -16,17 +16,68 @@
 #ifndef SHARKSFIN_SHIRAKAMI_STRAND_H_
 #define SHARKSFIN_SHIRAKAMI_STRAND_H_
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
+
+#include "sharksfin/api.h"
 
 namespace sharksfin::shirakami {
 
+class Storage;
 class Transaction;
 
 /**
  * @brief a strand
+ * @details strands run on different threads, but the native transaction handle does not accept concurrent writes.
+ * So that writes from a strand are buffered in the strand, and they are applied to the parent transaction just
+ * before the commit (see Transaction::attach() and Transaction::detach()).
  */
 class Strand {
 public:
+    /**
+     * @brief an entry of buffered write
+     */
+    struct write_entry {
+        /**
+         * @brief the target storage
+         */
+        Storage* storage_{};
+
+        /**
+         * @brief the content key
+         */
+        std::string key_{};
+
+        /**
+         * @brief the content value, or empty if this is a remove
+         */
+        std::string value_{};
+
+        /**
+         * @brief the put operation
+         */
+        PutOperation operation_{};
+
+        /**
+         * @brief the blob ids used in the content
+         */
+        std::vector<blob_id_type> blobs_{};
+
+        /**
+         * @brief whether or not this entry removes the content
+         */
+        bool remove_{};
+    };
+
+    /**
+     * @brief the set of keys for each storage.
+     */
+    using key_set = std::map<Storage*, std::set<std::string, std::less<>>>;
+
     /**
      * @brief create empty object
      */
@@ -59,9 +110,62 @@ public:
      */
     std::string& buffer() noexcept;
 
+    /**
+     * @brief returns the strand local buffers for the batch operations.
+     * @return the strand local batch buffers
+     */
+    std::vector<std::string>& batch_buffers() noexcept;
+
+    /**
+     * @brief buffers a put operation.
+     * @param storage the target storage
+     * @param key the content key
+     * @param value the content value
+     * @param operation the put operation
+     * @param blobs_data the blob ids used in the content
+     * @param blobs_size the number of blob ids
+     */
+    void put(
+        Storage* storage,
+        Slice key,
+        Slice value,
+        PutOperation operation,
+        blob_id_type const* blobs_data = nullptr,
+        std::size_t blobs_size = 0);
+
+    /**
+     * @brief buffers a remove operation.
+     * @param storage the target storage
+     * @param key the content key
+     */
+    void remove(Storage* storage, Slice key);
+
+    /**
+     * @brief returns whether or not this strand has buffered a write to the key.
+     * @details this can be called from the other threads than the one running this strand.
+     * @param storage the target storage
+     * @param key the target key
+     * @return true if this strand has buffered a write to the key
+     * @return false otherwise
+     */
+    bool buffered(Storage* storage, Slice key) const;
+
+    /**
+     * @brief moves out the buffered writes.
+     * @details the writes are appended to the given list in the issued order, and this strand forgets them.
+     * @param writes [out] the list to receive the buffered writes
+     * @param keys [out] the set to receive the keys of the buffered writes, or nullptr to discard them
+     */
+    void take_writes(std::vector<write_entry>& writes, key_set* keys = nullptr);
+
 private:
     Transaction* parent_{};
     std::string buffer_{};
+    std::vector<std::string> batch_buffers_{};
+    std::vector<write_entry> writes_{};
+    key_set keys_{};
+    // only contended by the lookups from the parent transaction
+    mutable std::mutex mutex_{};
 
 };
 
@@ -15,6 +15,8 @@
  */
 #include "Transaction.h"
 
+#include <algorithm>
+#include <iterator>
 #include <thread>
 #include "glog/logging.h"
 #include <xmmintrin.h>
@@ -23,11 +25,13 @@
 #include "sharksfin/api.h"
 #include "shirakami_api_helper.h"
 #include "Database.h"
+#include "Iterator.h"
 #include "Session.h"
 #include "Storage.h"
 #include "Error.h"
 #include "logging.h"
 #include "binary_printer.h"
+#include "flight_recorder.h"
 
 namespace sharksfin::shirakami {
 
@@ -38,16 +42,25 @@ StatusCode Transaction::construct(
     Database* owner,
     TransactionOptions const& opts
 ) {
+    auto requested = common::transaction_timer::clock::now();
     auto t = std::unique_ptr<Transaction>(new Transaction(owner, opts)); // ctor is not public
+    t->timer_->mark(TransactionEvent::BEGIN_REQUESTED, requested);
     if(t->session_ == nullptr) {
         t->is_active_ = false;
+        owner->flight_recorder().record(
+            common::flight_event_kind::transaction_begin, t.get(), t->type_, StatusCode::ERR_RESOURCE_LIMIT_REACHED);
         return StatusCode::ERR_RESOURCE_LIMIT_REACHED;
     }
     auto res = t->declare_begin();
+    owner->flight_recorder().record(common::flight_event_kind::transaction_begin, t.get(), t->type_, res);
     if(res != StatusCode::OK) {
         t->is_active_ = false;
         return res;
     }
+    if(! t->is_long()) {
+        // long transactions are started after WAITING_START
+        t->timer_->mark(TransactionEvent::STARTED);
+    }
     tx = std::move(t);
     return res;
 }
@@ -100,6 +113,7 @@ static void release_tx_handle(::shirakami::TxStateHandle& state_handle) {
     }
 }
 Transaction::~Transaction() noexcept {
+    stop_read_ahead();
     if (is_active_) {
         // usually this implies usage error
         VLOG(log_warning) << "aborting a transaction implicitly";
@@ -142,13 +156,25 @@ StatusCode Transaction::commit() {
 static ErrorCode from(::shirakami::reason_code reason, ErrorLocatorKind& kind, bool& impl_provides_locator);
 
 bool Transaction::commit(commit_callback_type callback) {
+    stop_read_ahead();
     if(!is_active_) {
         callback(StatusCode::ERR_INACTIVE_TRANSACTION, {}, {});
         return true;
     }
+    ErrorCode strand_error{};
+    if(auto rc = apply_strand_writes(strand_error); rc != StatusCode::OK) {
+        // the strand has already returned OK for the write, so that the reason is only reported by the error code
+        abort();
+        callback(StatusCode::ERR_ABORTED, strand_error, {});
+        return true;
+    }
+    auto now = common::transaction_timer::clock::now();
+    timer_->mark(TransactionEvent::STARTED, now);
+    timer_->mark(TransactionEvent::COMMIT_REQUESTED, now);
+    auto& metrics = owner_->metrics();
     return api::commit(
         session_->id(),
-        [cb = std::move(callback), this](
+        [cb = std::move(callback), this, &metrics, started = metrics.start()](
             ::shirakami::Status st,
             ::shirakami::reason_code rc,
             ::shirakami::durability_marker_type marker
@@ -163,13 +189,27 @@ bool Transaction::commit(commit_callback_type callback) {
             } else {
                 // TODO handle pre-condition failure
             }
-            last_call_status(st);
+            remember_status(st);
+            timer_->mark(TransactionEvent::COMMIT_DONE);
+            metrics.record_phases(timer_->timings());
+            owner_->flight_recorder().record(
+                common::flight_event_kind::transaction_commit, this, res, error, last_call_status_.load());
+            metrics.record(MetricsOperation::COMMIT, started, res);
+            if (res == StatusCode::OK) {
+                metrics.enqueue_durable(marker, timer_);
+            } else if (res == StatusCode::ERR_ABORTED_RETRYABLE) {
+                if (owner_->flight_recorder().enabled() || owner_->hot_keys().enabled()) {
+                    record_error();
+                }
+                metrics.record_abort(error);
+            }
             cb(res, error, static_cast<durability_marker_type>(marker));
         }
     );
 }
 
 StatusCode Transaction::abort() {
+    stop_read_ahead();
     if(!is_active_) {
         // transaction doesn't begin, or commit request has been submitted already
         return StatusCode::OK;
@@ -182,7 +222,9 @@ StatusCode Transaction::abort() {
         return StatusCode::ERR_UNKNOWN;
     }
     is_active_ = false;
-    last_call_status(res);
+    remember_status(res);
+    owner_->flight_recorder().record(
+        common::flight_event_kind::transaction_abort, this, rc, last_call_status_.load());
     return rc;
 }
 
@@ -194,15 +236,109 @@ std::string& Transaction::buffer() {
     return buffer_;
 }
 
+std::vector<std::string>& Transaction::batch_buffers() {
+    return batch_buffers_;
+}
+
+common::pinned_buffers& Transaction::pinned_buffers() noexcept {
+    return pinned_buffers_;
+}
+
+TransactionArena& Transaction::arena() noexcept {
+    return arena_;
+}
+
+void Transaction::attach(Strand* strand) {
+    std::unique_lock lk{strands_mutex_};
+    strands_.emplace_back(strand);
+    has_strands_ = true;
+}
+
+void Transaction::detach(Strand* strand) {
+    std::unique_lock lk{strands_mutex_};
+    // keep the keys so that the direct writes to them are still rejected
+    strand->take_writes(strand_writes_, &strand_keys_);
+    strands_.erase(std::remove(strands_.begin(), strands_.end(), strand), strands_.end());
+}
+
+void Transaction::attach(Iterator* iterator) {
+    std::unique_lock lk{iterators_mutex_};
+    read_ahead_iterators_.emplace_back(iterator);
+}
+
+void Transaction::detach(Iterator* iterator) {
+    std::unique_lock lk{iterators_mutex_};
+    read_ahead_iterators_.erase(
+        std::remove(read_ahead_iterators_.begin(), read_ahead_iterators_.end(), iterator),
+        read_ahead_iterators_.end());
+}
+
+void Transaction::stop_read_ahead() {
+    // the helper threads must not touch this transaction after it finishes
+    std::unique_lock lk{iterators_mutex_};
+    for (auto* iterator : read_ahead_iterators_) {
+        iterator->stop_read_ahead();
+    }
+}
+
+bool Transaction::is_buffered_by_strand(Storage* storage, Slice key) {
+    if (! has_strands_) {
+        return false;
+    }
+    // the strands keep their own keys, so that they don't contend with each other while buffering writes
+    std::unique_lock lk{strands_mutex_};
+    if (auto it = strand_keys_.find(storage);
+        it != strand_keys_.end() && it->second.find(key.to_string_view()) != it->second.end()) {
+        return true;
+    }
+    return std::any_of(strands_.begin(), strands_.end(), [&](Strand* strand) {
+        return strand->buffered(storage, key);
+    });
+}
+
+StatusCode Transaction::apply_strand_writes(ErrorCode& error) {
+    std::unique_lock lk{strands_mutex_};
+    for (auto* strand : strands_) {
+        strand->take_writes(strand_writes_);
+    }
+    // any status other than OK (including warnings such as ALREADY_EXISTS for CREATE) makes the commit fail, except
+    // NOT_FOUND for removes, which is also not an error for the non-stranded handle
+    StatusCode ret = StatusCode::OK;
+    for (auto&& e : strand_writes_) {
+        auto rc = e.remove_ ?
+            e.storage_->remove(this, e.key_) :
+            e.storage_->put(this, e.key_, e.value_, e.operation_, e.blobs_.data(), e.blobs_.size());
+        if (e.remove_ && rc == StatusCode::NOT_FOUND) {
+            continue;
+        }
+        if (rc != StatusCode::OK) {
+            error = record_error(rc, *e.storage_, e.key_);
+            ret = rc;
+            break;
+        }
+    }
+    strand_writes_.clear();
+    strand_keys_.clear();
+    return ret;
+}
+
 ::shirakami::Token Transaction::native_handle() {
     return session_->id();
 }
 
 void Transaction::reset() {
+    stop_read_ahead();
     if(is_active_) {
         ABORT();
     }
     release_tx_handle(state_handle_);
+    pinned_buffers_.clear();
+    {
+        std::unique_lock lk{strands_mutex_};
+        strand_writes_.clear();
+        strand_keys_.clear();
+        has_strands_ = ! strands_.empty();
+    }
     is_active_ = true;
     declare_begin();
 }
@@ -233,7 +369,11 @@ TransactionState Transaction::check_state() {
     if(auto res = api::check_tx_state(state_handle_, state); res != ::shirakami::Status::OK) {
         ABORT();
     }
-    return from_state(state);
+    auto ret = from_state(state);
+    if(ret.state_kind() == TransactionState::StateKind::STARTED) {
+        timer_->mark(TransactionEvent::STARTED);
+    }
+    return ret;
 }
 
 static ::shirakami::transaction_options::transaction_type from(TransactionOptions::TransactionType type) {
@@ -263,7 +403,7 @@ StatusCode Transaction::declare_begin() {
 
     transaction_options options{session_->id(), from(type_), wps, read_area{std::move(rai), std::move(rae)}};
     auto res = api::tx_begin(std::move(options));
-    last_call_status(res);
+    remember_status(res);
     return resolve(res);
 }
 
@@ -297,6 +437,9 @@ ErrorCode from(::shirakami::reason_code reason, ErrorLocatorKind& kind, bool& im
 }
 
 static std::pair<std::shared_ptr<ErrorLocator>, ErrorCode> create_locator(std::shared_ptr<::shirakami::result_info> const& ri) {
+    if(! ri) {
+        return {nullptr, ErrorCode::OK};
+    }
     ErrorLocatorKind kind{ErrorLocatorKind::unknown};
     bool impl_provides_locator = true; // whether implementation provides locator as ErrorCode expects
     auto rc = from(ri->get_reason_code(), kind, impl_provides_locator);
@@ -323,16 +466,55 @@ std::shared_ptr<CallResult> Transaction::recent_call_result() {
         ss.str());
 }
 
+ErrorCode Transaction::record_error() {
+    auto [locator, ec] = create_locator(api::transaction_result_info(session_->id()));
+    owner_->flight_recorder().record_error(this, ec, static_cast<std::int64_t>(last_call_status_.load()), locator.get());
+    owner_->hot_keys().record(ec, locator.get());
+    return ec;
+}
+
+ErrorCode Transaction::record_error(StatusCode status, Storage const& storage, std::string_view key) {
+    ErrorCode ec{};
+    switch (status) {
+        case StatusCode::ALREADY_EXISTS: ec = ErrorCode::KVS_KEY_ALREADY_EXISTS; break;
+        case StatusCode::NOT_FOUND: ec = ErrorCode::KVS_KEY_NOT_FOUND; break;
+        default: {
+            auto [locator, code] = create_locator(api::transaction_result_info(session_->id()));
+            ec = code == ErrorCode::OK ? ErrorCode::ERROR : code;
+            break;
+        }
+    }
+    StorageKeyErrorLocator locator{key, storage.name().to_string_view()};
+    owner_->flight_recorder().record_error(this, ec, static_cast<std::int64_t>(last_call_status_.load()), &locator);
+    owner_->hot_keys().record(ec, &locator);
+    return ec;
+}
+
 std::shared_ptr<TransactionInfo> Transaction::info() {
-    std::string tx_id{};
-    if(auto res = api::get_tx_id(session_->id(), tx_id); res != ::shirakami::Status::OK) {
-        VLOG(log_error) << "Failed to retrieve shirakami transaction id.";
-        return {};
+    if(tx_id_.empty()) {
+        // remember the id so that it is available after the transaction finished
+        if(auto res = api::get_tx_id(session_->id(), tx_id_); res != ::shirakami::Status::OK && is_active_) {
+            VLOG(log_error) << "Failed to retrieve shirakami transaction id.";
+            return {};
+        }
     }
-    return std::make_shared<TransactionInfo>(tx_id);
+    return std::make_shared<TransactionInfo>(tx_id_, timer_->timings());
+}
+
+common::transaction_timer& Transaction::timer() noexcept {
+    return *timer_;
 }
 
 void Transaction::last_call_status(::shirakami::Status st) {
+    timer_->mark(TransactionEvent::FIRST_OPERATION);
+    if(st != ::shirakami::Status::WARN_PREMATURE) {
+        // operations of long transactions are premature until the transaction is started
+        timer_->mark(TransactionEvent::STARTED);
+    }
+    remember_status(st);
+}
+
+void Transaction::remember_status(::shirakami::Status st) {
     if (::shirakami::Status::OK < st) {
         // last_call_status_ is used to describe abort details.
         // Remember only shirakami status codes that imply tx abort.
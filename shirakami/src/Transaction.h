@@ -16,6 +16,7 @@
 #ifndef SHARKSFIN_SHIRAKAMI_TRANSACTION_H_
 #define SHARKSFIN_SHIRAKAMI_TRANSACTION_H_
 
+#include <mutex>
 #include <thread>
 #include "glog/logging.h"
 #include "shirakami/interface.h"
@@ -26,10 +27,15 @@
 #include "sharksfin/CallResult.h"
 #include "sharksfin/StatusCode.h"
 #include "Database.h"
+#include "pinned_buffers.h"
 #include "Session.h"
+#include "Strand.h"
+#include "TransactionArena.h"
+#include "transaction_timer.h"
 
 namespace sharksfin::shirakami {
 
+class Iterator;
 class Storage;
 
 /**
@@ -107,6 +113,66 @@ public:
      */
     std::string& buffer();
 
+    /**
+     * @brief returns the transaction local buffers for the batch operations.
+     * @details each element receives one result of the batch, and keeps its capacity across the calls.
+     * @return the transaction local batch buffers
+     */
+    std::vector<std::string>& batch_buffers();
+
+    /**
+     * @brief returns the buffers for the pinned reads.
+     * @details the buffers are released when this transaction is reset or destroyed.
+     * @return the pinned buffers
+     */
+    common::pinned_buffers& pinned_buffers() noexcept;
+
+    /**
+     * @brief registers a strand of this transaction.
+     * @details the writes buffered in the registered strands are applied before commit.
+     * @param strand the strand to register
+     */
+    void attach(Strand* strand);
+
+    /**
+     * @brief unregisters the strand.
+     * @details the writes buffered in the strand are taken over by this transaction, and applied before commit.
+     * @param strand the strand to unregister
+     */
+    void detach(Strand* strand);
+
+    /**
+     * @brief registers an iterator of this transaction which prefetches rows on the helper thread.
+     * @details the helper threads of the registered iterators are stopped before this transaction is committed,
+     * aborted, reset, or destroyed.
+     * @param iterator the iterator to register
+     */
+    void attach(Iterator* iterator);
+
+    /**
+     * @brief unregisters the iterator.
+     * @param iterator the iterator to unregister
+     */
+    void detach(Iterator* iterator);
+
+    /**
+     * @brief returns whether or not a strand of this transaction has buffered a write to the key.
+     * @details the direct writes of this transaction to such keys must be rejected, because they would be overwritten
+     * by the buffered writes on commit.
+     * @param storage the target storage
+     * @param key the target key
+     * @return true if a strand has buffered a write to the key
+     * @return false otherwise
+     */
+    bool is_buffered_by_strand(Storage* storage, Slice key);
+
+    /**
+     * @brief returns the arena for the objects bound to this transaction.
+     * @details the memory is released when this transaction is destroyed.
+     * @return the transaction arena
+     */
+    TransactionArena& arena() noexcept;
+
     /**
      * @brief returns the native transaction handle object.
      * @return the shirakami native handle
@@ -155,6 +221,21 @@ public:
      */
     std::shared_ptr<CallResult> recent_call_result();
 
+    /**
+     * @brief records the error of the most recent request into the flight recorder and the hot key tracker
+     * @return the error code of the most recent request
+     */
+    ErrorCode record_error();
+
+    /**
+     * @brief records the failure on the specified key into the flight recorder and the hot key tracker
+     * @param status the status of the failed operation
+     * @param storage the storage of the failed operation
+     * @param key the key of the failed operation
+     * @return the error code of the failure
+     */
+    ErrorCode record_error(StatusCode status, Storage const& storage, std::string_view key);
+
     /**
      * @brief return transaction info object
      * @return transaction info
@@ -163,14 +244,35 @@ public:
 
     /**
      * @brief set call status result
+     * @details this also marks TransactionEvent::FIRST_OPERATION, because this is called after each data operation.
      * @arg the status code for the last api call
      */
     void last_call_status(::shirakami::Status st);
 
+    /**
+     * @brief returns the timestamps of the transaction lifecycle.
+     * @return the transaction timer
+     */
+    common::transaction_timer& timer() noexcept;
+
 private:
+    StatusCode apply_strand_writes(ErrorCode& error);
+    void stop_read_ahead();
+    void remember_status(::shirakami::Status st);
+
     Database* owner_{};
     std::unique_ptr<Session> session_{};
     std::string buffer_{};
+    std::vector<std::string> batch_buffers_{};
+    common::pinned_buffers pinned_buffers_{};
+    TransactionArena arena_{};
+    std::vector<Strand*> strands_{};
+    std::vector<Strand::write_entry> strand_writes_{};
+    Strand::key_set strand_keys_{};
+    std::atomic_bool has_strands_{};
+    std::mutex strands_mutex_{};
+    std::vector<Iterator*> read_ahead_iterators_{};
+    std::mutex iterators_mutex_{};
     std::atomic_bool is_active_{true};
     TransactionOptions::TransactionType type_{};
     std::vector<Storage*> write_preserves_{};
@@ -178,6 +280,8 @@ private:
     std::vector<Storage*> read_areas_exclusive_{};
     ::shirakami::TxStateHandle state_handle_{::shirakami::undefined_handle};
     std::atomic<::shirakami::Status> last_call_status_{};
+    std::shared_ptr<common::transaction_timer> timer_{std::make_shared<common::transaction_timer>()};
+    std::string tx_id_{};
 
     Transaction(
         Database* owner,
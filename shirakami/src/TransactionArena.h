@@ -0,0 +1,151 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SHARKSFIN_SHIRAKAMI_TRANSACTION_ARENA_H_
+#define SHARKSFIN_SHIRAKAMI_TRANSACTION_ARENA_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace sharksfin::shirakami {
+
+/**
+ * @brief monotonic memory arena for the objects whose lifetime is bound to a transaction.
+ * @details the bridge objects created for a transaction (e.g. iterators and strands) are allocated from this arena
+ * instead of the global allocator. Destroying such objects returns their slots into the free list of the same size
+ * and alignment, so that the later objects reuse them, and the memory is released in bulk when the arena (i.e. the
+ * owner transaction) is destroyed. Thus, the footprint is bounded by the max number of objects alive at once, even
+ * if a long transaction repeatedly creates and destroys objects.
+ * The first initial_size bytes are served from the storage embedded in this object.
+ * This object is thread-safe so that strands running on different threads can create objects.
+ */
+class TransactionArena {
+public:
+    /**
+     * @brief the size of the embedded storage in bytes.
+     */
+    static constexpr std::size_t initial_size = 4096;
+
+    /**
+     * @brief create empty object
+     */
+    TransactionArena() = default;
+
+    TransactionArena(TransactionArena const& other) = delete;
+    TransactionArena& operator=(TransactionArena const& other) = delete;
+    TransactionArena(TransactionArena&& other) noexcept = delete;
+    TransactionArena& operator=(TransactionArena&& other) noexcept = delete;
+
+    /**
+     * @brief destructor - releases all memory allocated from this arena
+     * @details the objects created from this arena must have been destroyed before.
+     */
+    ~TransactionArena() = default;
+
+    /**
+     * @brief creates a new object on this arena.
+     * @tparam T the object type
+     * @tparam Args the constructor parameter types
+     * @param args the constructor arguments
+     * @return the created object, which must be destroyed by destroy()
+     */
+    template<class T, class... Args>
+    T* create(Args&&... args) {
+        void* p = allocate(slot_size<T>(), slot_alignment<T>());
+        try {
+            return new (p) T(std::forward<Args>(args)...);  //NOLINT(cppcoreguidelines-owning-memory)
+        } catch (...) {
+            deallocate(p, slot_size<T>(), slot_alignment<T>());
+            throw;
+        }
+    }
+
+    /**
+     * @brief destroys the object created by create().
+     * @details this runs the destructor, and then the slot is reused by the later objects of the same size.
+     * @tparam T the object type
+     * @param object the target object, or nullptr to do nothing
+     */
+    template<class T>
+    void destroy(T* object) noexcept {
+        if (object != nullptr) {
+            object->~T();
+            deallocate(object, slot_size<T>(), slot_alignment<T>());
+        }
+    }
+
+    /**
+     * @brief returns the number of bytes acquired from the underlying buffer.
+     * @details this never decreases, since the slots of the destroyed objects are kept in the free lists.
+     * @return the number of bytes
+     */
+    [[nodiscard]] std::size_t footprint() const noexcept {
+        std::unique_lock lk{mutex_};
+        return footprint_;
+    }
+
+private:
+    struct free_slot {
+        free_slot* next;
+    };
+    using slot_class = std::pair<std::size_t, std::size_t>;
+
+    alignas(std::max_align_t) std::array<std::byte, initial_size> initial_{};
+    std::pmr::monotonic_buffer_resource resource_{initial_.data(), initial_.size()};
+    // the free lists are also allocated from the arena, once for each slot class
+    std::pmr::map<slot_class, free_slot*> free_slots_{&resource_};
+    std::size_t footprint_{};
+    mutable std::mutex mutex_{};
+
+    template<class T>
+    static constexpr std::size_t slot_size() noexcept {
+        return std::max(sizeof(T), sizeof(free_slot));
+    }
+
+    template<class T>
+    static constexpr std::size_t slot_alignment() noexcept {
+        return std::max(alignof(T), alignof(free_slot));
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        std::unique_lock lk{mutex_};
+        // the entry is created here, so that deallocate() never allocates
+        auto& head = free_slots_[{size, alignment}];
+        if (head != nullptr) {
+            auto* slot = head;
+            head = slot->next;
+            return slot;
+        }
+        auto* p = resource_.allocate(size, alignment);
+        footprint_ += size;
+        return p;
+    }
+
+    void deallocate(void* p, std::size_t size, std::size_t alignment) noexcept {
+        std::unique_lock lk{mutex_};
+        auto& head = free_slots_.find({size, alignment})->second;
+        head = new (p) free_slot{head};  //NOLINT(cppcoreguidelines-owning-memory)
+    }
+};
+
+}  // namespace sharksfin::shirakami
+
+#endif  // SHARKSFIN_SHIRAKAMI_TRANSACTION_ARENA_H_
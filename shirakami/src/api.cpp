@@ -15,11 +15,18 @@
  */
 #include "sharksfin/api.h"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include "Database.h"
 #include "Transaction.h"
 #include "Iterator.h"
+#include "KeySampler.h"
 #include "Storage.h"
 #include "Strand.h"
 #include "Error.h"
@@ -28,6 +35,10 @@
 #include "shirakami_api_helper.h"
 #include "logging_helper.h"
 #include "correct_transaction.h"
+#include "hot_key_tracker.h"
+#include "metrics.h"
+#include "api_trace.h"
+#include "flight_recorder.h"
 
 namespace sharksfin {
 
@@ -50,6 +61,14 @@ StatusCode database_open(
     std::unique_ptr<shirakami::Database> db{};
     auto rc = shirakami::Database::open(options, datastore, &db);
     if (rc == StatusCode::OK) {
+        if (auto res = db->flight_recorder().configure(options); res != StatusCode::OK) {
+            db->close();
+            return res;
+        }
+        if (auto res = db->hot_keys().configure(options); res != StatusCode::OK) {
+            db->close();
+            return res;
+        }
         bool tracking = false;
         if (auto option = options.attribute(KEY_PERFORMANCE_TRACKING); option.has_value()) {
             auto&& v = option.value();
@@ -62,6 +81,15 @@ StatusCode database_open(
             }
         }
         db->enable_tracking(tracking);
+        if (tracking) {
+            // tracks when the committed transactions become durable
+            auto* m = &db->metrics();
+            if (auto res = db->register_durability_callback([m](durability_marker_type marker) {
+                    m->durable(marker);
+                }); res != StatusCode::OK) {
+                VLOG(log_warning) << "durability tracking is not available:" << res;
+            }
+        }
         *result = wrap(db.release());
     }
     return rc;
@@ -83,6 +111,18 @@ StatusCode database_register_durability_callback(DatabaseHandle handle, durabili
     return db->register_durability_callback(std::move(cb));
 }
 
+StatusCode database_get_metrics(DatabaseHandle handle, MetricsSnapshot& result) {
+    auto db = unwrap(handle);
+    db->metrics().snapshot(result);
+    return StatusCode::OK;
+}
+
+StatusCode database_get_hot_keys(DatabaseHandle handle, std::vector<HotKey>& result) {
+    auto db = unwrap(handle);
+    db->hot_keys().snapshot(result);
+    return StatusCode::OK;
+}
+
 StatusCode storage_create(
         DatabaseHandle handle,
         Slice key,
@@ -224,52 +264,67 @@ StatusCode storage_set_options(
     return st->set_options(options, t);
 }
 
-template<class T>
-static void add(std::atomic<T>& atomic, T duration) {
-    static_assert(std::is_trivially_copyable_v<T>);
-    while (true) {
-        T expect = atomic.load();
-        if (atomic.compare_exchange_weak(expect, expect + duration)) {
-            break;
-        }
+/**
+ * @brief the upper bound of the first backoff before retrying transaction.
+ */
+static constexpr std::chrono::microseconds retry_backoff_initial{10};
+
+/**
+ * @brief the maximum upper bound of the backoff before retrying transaction.
+ */
+static constexpr std::chrono::microseconds retry_backoff_max{10'000};
+
+// exponential backoff with full jitter - sleeps random duration up to min(max, initial * 2^retry)
+static void backoff(std::size_t retry) {
+    thread_local std::minstd_rand engine{std::random_device{}()};
+    auto bound = retry_backoff_max;
+    if (retry < 10) {
+        bound = std::min(retry_backoff_initial * (1U << retry), retry_backoff_max);
     }
+    std::uniform_int_distribution<std::chrono::microseconds::rep> dist{0, bound.count()};
+    std::this_thread::sleep_for(std::chrono::microseconds{dist(engine)});
+}
+
+// waits for other retries conflicted on the same storage/key as the aborted transaction
+static shirakami::ContentionGate::lock_type enter_contention_gate(
+        shirakami::Database& database,
+        shirakami::Transaction& tx) {
+    auto result = tx.recent_call_result();
+    if (! result || ! result->location() || result->location()->kind() != ErrorLocatorKind::storage_key) {
+        return {};
+    }
+    auto& locator = static_cast<StorageKeyErrorLocator const&>(*result->location());  //NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    auto storage = locator.storage();
+    auto key = locator.key();
+    if (! storage && ! key) {
+        return {};
+    }
+    return database.contention_gate().acquire(storage.value_or(std::string_view{}), key.value_or(std::string_view{}));
 }
 
 StatusCode transaction_exec(
         DatabaseHandle handle,
-        [[maybe_unused]] TransactionOptions const& options,
+        TransactionOptions const& options,
         TransactionCallback callback,
         void *arguments) {
     auto database = unwrap(handle);
-    shirakami::Database::clock::time_point at_begin, at_process, at_end;  //NOLINT
-    do {
-        if (database->enable_tracking()) {
-            ++database->transaction_count();
-            at_begin = shirakami::Database::clock::now();
-        }
+    std::size_t retry = 0;
+    while (true) {
+        auto& metrics = database->metrics();
+        auto started = metrics.start();
         std::unique_ptr<shirakami::Transaction> tx{};
-        if(auto res = database->create_transaction(tx); res != StatusCode::OK) {
+        auto res = database->create_transaction(tx);
+        metrics.record(MetricsOperation::BEGIN, started, res);
+        if(res != StatusCode::OK) {
             return res;
         }
-        if (database->enable_tracking()) {
-            at_process = shirakami::Database::clock::now();
-        }
         auto status = callback(wrap(tx.get()), arguments);
-        if (database->enable_tracking()) {
-            at_end = shirakami::Database::clock::now();
-            add(database->transaction_wait_time(),
-                    std::chrono::duration_cast<shirakami::Database::tracking_time_period>(at_process - at_begin));
-            add(database->transaction_process_time(),
-                    std::chrono::duration_cast<shirakami::Database::tracking_time_period>(at_end - at_process));
-        }
         switch (status) {
             case TransactionOperation::COMMIT: {
                 auto rc = tx->commit();
                 if(rc != StatusCode::OK) {
                     if (rc == StatusCode::ERR_ABORTED_RETRYABLE) {
-                        // retry
-                        VLOG_LP(log_warning) << "commit failed. retry transaction.";
-                        continue;
+                        break;
                     }
                     ABORT();
                 }
@@ -282,11 +337,22 @@ StatusCode transaction_exec(
                 tx->abort();
                 return StatusCode::ERR_USER_ERROR;
             case TransactionOperation::RETRY:
-                // simply return retryable error so that caller can retry
                 tx->abort();
-                return StatusCode::ERR_ABORTED_RETRYABLE;
+                break;
+        }
+        if (retry >= options.retry_count()) {
+            // simply return retryable error so that caller can retry
+            return StatusCode::ERR_ABORTED_RETRYABLE;
         }
-    } while (true); // currently retry infinitely
+        ++retry;
+        database->metrics().record_retry();
+        VLOG_LP(log_debug) << "transaction aborted. retry transaction (" << retry << "/" << options.retry_count() << ")";
+
+        // back off inside the gate so that the retries on the same key are spread out, but release it before the
+        // next attempt because holding it across the callback may deadlock with the other stripes
+        auto gate = enter_contention_gate(*database, *tx);
+        backoff(retry - 1);
+    }
 }
 
 StatusCode transaction_borrow_owner(
@@ -306,8 +372,12 @@ StatusCode transaction_begin(
         [[maybe_unused]] TransactionOptions const& options,
         TransactionControlHandle *result) {
     auto database = unwrap(handle);
+    auto& metrics = database->metrics();
+    auto started = metrics.start();
     std::unique_ptr<shirakami::Transaction> tx{};
-    if(auto res = database->create_transaction(tx, options); res != StatusCode::OK) {
+    auto res = database->create_transaction(tx, options);
+    metrics.record(MetricsOperation::BEGIN, started, res);
+    if(res != StatusCode::OK) {
         return res;
     }
     *result = wrap_as_control_handle(tx.release());
@@ -318,7 +388,6 @@ StatusCode transaction_get_info(
     TransactionControlHandle handle,
     std::shared_ptr<TransactionInfo>& result) {
     auto tx = unwrap(handle);
-    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
     result = tx->info();
     if(! result) {
         // should not occur
@@ -338,13 +407,17 @@ StatusCode transaction_acquire_handle(
         TransactionControlHandle handle,
         TransactionHandle* result) {
     auto* tx = unwrap(handle);
-    *result = wrap(new shirakami::Strand(tx));  //NOLINT(cppcoreguidelines-owning-memory)
+    auto* strand = tx->arena().create<shirakami::Strand>(tx);
+    tx->attach(strand);
+    *result = wrap(strand);
     return StatusCode::OK;
 }
 
 StatusCode transaction_release_handle(TransactionHandle handle) {
     if (is_strand(handle)) {
-        delete unwrap_as_strand(handle);  //NOLINT(cppcoreguidelines-owning-memory)
+        auto* strand = unwrap_as_strand(handle);
+        strand->parent()->detach(strand);
+        strand->parent()->arena().destroy(strand);
     }
     return StatusCode::OK;
 }
@@ -369,7 +442,10 @@ StatusCode transaction_abort(
         TransactionControlHandle handle,
         [[maybe_unused]] bool rollback) { // shirakami always rolls back on abort
     auto tx = unwrap(handle);
+    auto& metrics = tx->owner()->metrics();
+    auto started = metrics.start();
     auto rc = tx->abort();
+    metrics.record(MetricsOperation::ABORT, started, rc);
     if (rc != StatusCode::OK) {
         ABORT_MSG("assuming abort is always successful");
     }
@@ -444,13 +520,137 @@ StatusCode content_get(
     return rc;
 }
 
+StatusCode content_get_partial(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        std::size_t offset,
+        std::size_t length,
+        Slice* result) {
+    // shirakami always reads the whole value, so that this only saves copies on the caller side
+    auto rc = content_get(transaction, storage, key, result);
+    if (rc == StatusCode::OK) {
+        *result = result->subslice(offset, length);
+    }
+    return rc;
+}
+
+// returns the indices of keys in the key order, so that visiting keys in it likely hits the cached index nodes
+static std::vector<std::size_t>& key_order(Slice const* keys, std::size_t count) {
+    thread_local std::vector<std::size_t> order{};  //NOLINT(misc-use-internal-linkage)
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return keys[a] < keys[b];  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    });
+    return order;
+}
+
+static bool is_error(StatusCode rc) noexcept {
+    return static_cast<std::int64_t>(rc) < 0;
+}
+
+StatusCode content_get_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        Slice* results,
+        StatusCode* statuses) {
+    shirakami::Transaction* tx = nullptr;
+    shirakami::Strand* strand = nullptr;
+    if (is_strand(transaction)) {
+        strand = unwrap_as_strand(transaction);
+        tx = strand->parent();
+    } else {
+        tx = unwrap(transaction);
+    }
+    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto stg = unwrap(storage);
+    auto db = tx->owner();
+    if (!db) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    auto& buffers = strand != nullptr ? strand->batch_buffers() : tx->batch_buffers();
+    if (buffers.size() < count) {
+        buffers.resize(count);
+    }
+    auto& order = key_order(keys, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto index = order[i];
+        auto& buffer = buffers[i];
+        auto rc = stg->get(tx, keys[index], buffer);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        statuses[index] = rc;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (rc == StatusCode::OK) {
+            results[index] = buffer;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        } else if (is_error(rc)) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                statuses[order[j]] = rc;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            return rc;
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode content_get_pinned(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice key,
+        Slice* result) {
+    shirakami::Transaction* tx = nullptr;
+    if (is_strand(transaction)) {
+        tx = unwrap_as_strand(transaction)->parent();
+    } else {
+        tx = unwrap(transaction);
+    }
+    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto stg = unwrap(storage);
+    auto db = tx->owner();
+    if (!db) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    // read directly into the pinned buffer to avoid copying from the transaction local buffer
+    auto& buffers = tx->pinned_buffers();
+    auto& buffer = buffers.acquire();
+    auto rc = stg->get(tx, key, buffer);
+    if (rc != StatusCode::OK) {
+        buffers.release(buffer.data());
+        return rc;
+    }
+    *result = buffer;
+    return StatusCode::OK;
+}
+
+StatusCode content_release(
+        TransactionHandle transaction,
+        Slice content) {
+    shirakami::Transaction* tx = nullptr;
+    if (is_strand(transaction)) {
+        tx = unwrap_as_strand(transaction)->parent();
+    } else {
+        tx = unwrap(transaction);
+    }
+    if (! tx->pinned_buffers().release(content.data())) {
+        return StatusCode::NOT_FOUND;
+    }
+    return StatusCode::OK;
+}
+
 StatusCode content_put(
         TransactionHandle transaction,
         StorageHandle storage,
         Slice key,
         Slice value,
         PutOperation operation) {
-    if (is_strand(transaction)) return StatusCode::ERR_INVALID_ARGUMENT;
+    if (is_strand(transaction)) {
+        auto* strand = unwrap_as_strand(transaction);
+        auto* tx = strand->parent();
+        if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+        if (tx->readonly()) return StatusCode::ERR_ILLEGAL_OPERATION;
+        strand->put(unwrap(storage), key, value, operation);
+        return StatusCode::OK;
+    }
     auto tx = unwrap(transaction);
     if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
     auto stg = unwrap(storage);
@@ -458,9 +658,54 @@ StatusCode content_put(
     if (!db) {
         return StatusCode::ERR_INVALID_STATE;
     }
+    if (tx->is_buffered_by_strand(stg, key)) return StatusCode::ERR_ILLEGAL_OPERATION;
     return stg->put(tx, key, value, operation);
 }
 
+StatusCode content_put_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        Slice const* values,
+        PutOperation const* operations,
+        std::size_t count,
+        StatusCode* statuses) {
+    if (is_strand(transaction)) {
+        auto* strand = unwrap_as_strand(transaction);
+        auto* tx = strand->parent();
+        if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+        if (tx->readonly()) return StatusCode::ERR_ILLEGAL_OPERATION;
+        auto stg = unwrap(storage);
+        for (std::size_t i = 0; i < count; ++i) {
+            strand->put(stg, keys[i], values[i], operations[i]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            statuses[i] = StatusCode::OK;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        return StatusCode::OK;
+    }
+    auto tx = unwrap(transaction);
+    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto stg = unwrap(storage);
+    auto db = tx->owner();
+    if (!db) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    auto& order = key_order(keys, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto index = order[i];
+        auto rc = tx->is_buffered_by_strand(stg, keys[index]) ?  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            StatusCode::ERR_ILLEGAL_OPERATION :
+            stg->put(tx, keys[index], values[index], operations[index]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        statuses[index] = rc;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (is_error(rc)) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                statuses[order[j]] = rc;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            return rc;
+        }
+    }
+    return StatusCode::OK;
+}
+
 StatusCode content_put_with_blobs(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -469,7 +714,14 @@ StatusCode content_put_with_blobs(
         blob_id_type const* blobs_data,
         std::size_t blobs_size,
         PutOperation operation) {
-    if (is_strand(transaction)) return StatusCode::ERR_INVALID_ARGUMENT;
+    if (is_strand(transaction)) {
+        auto* strand = unwrap_as_strand(transaction);
+        auto* tx = strand->parent();
+        if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+        if (tx->readonly()) return StatusCode::ERR_ILLEGAL_OPERATION;
+        strand->put(unwrap(storage), key, value, operation, blobs_data, blobs_size);
+        return StatusCode::OK;
+    }
     auto tx = unwrap(transaction);
     if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
     auto stg = unwrap(storage);
@@ -477,6 +729,7 @@ StatusCode content_put_with_blobs(
     if (!db) {
         return StatusCode::ERR_INVALID_STATE;
     }
+    if (tx->is_buffered_by_strand(stg, key)) return StatusCode::ERR_ILLEGAL_OPERATION;
     return stg->put(tx, key, value, operation, blobs_data, blobs_size);
 }
 
@@ -484,7 +737,14 @@ StatusCode content_delete(
         TransactionHandle transaction,
         StorageHandle storage,
         Slice key) {
-    if (is_strand(transaction)) return StatusCode::ERR_INVALID_ARGUMENT;
+    if (is_strand(transaction)) {
+        auto* strand = unwrap_as_strand(transaction);
+        auto* tx = strand->parent();
+        if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+        if (tx->readonly()) return StatusCode::ERR_ILLEGAL_OPERATION;
+        strand->remove(unwrap(storage), key);
+        return StatusCode::OK;
+    }
     auto tx = unwrap(transaction);
     if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
     auto stg = unwrap(storage);
@@ -492,9 +752,52 @@ StatusCode content_delete(
     if (!db) {
         return StatusCode::ERR_INVALID_STATE;
     }
+    if (tx->is_buffered_by_strand(stg, key)) return StatusCode::ERR_ILLEGAL_OPERATION;
     return stg->remove(tx, key);
 }
 
+StatusCode content_delete_batch(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice const* keys,
+        std::size_t count,
+        StatusCode* statuses) {
+    if (is_strand(transaction)) {
+        auto* strand = unwrap_as_strand(transaction);
+        auto* tx = strand->parent();
+        if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+        if (tx->readonly()) return StatusCode::ERR_ILLEGAL_OPERATION;
+        auto stg = unwrap(storage);
+        for (std::size_t i = 0; i < count; ++i) {
+            strand->remove(stg, keys[i]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            statuses[i] = StatusCode::OK;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        return StatusCode::OK;
+    }
+    auto tx = unwrap(transaction);
+    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto stg = unwrap(storage);
+    auto db = tx->owner();
+    if (!db) {
+        return StatusCode::ERR_INVALID_STATE;
+    }
+    auto& order = key_order(keys, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto index = order[i];
+        auto rc = tx->is_buffered_by_strand(stg, keys[index]) ?  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            StatusCode::ERR_ILLEGAL_OPERATION :
+            stg->remove(tx, keys[index]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        statuses[index] = rc;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (is_error(rc)) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                statuses[order[j]] = rc;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            return rc;
+        }
+    }
+    return StatusCode::OK;
+}
+
 StatusCode content_scan_prefix(
         TransactionHandle transaction,
         StorageHandle storage,
@@ -522,14 +825,15 @@ StatusCode content_scan_range(
             result);
 }
 
-StatusCode content_scan(
+static StatusCode scan(
         TransactionHandle transaction,
         StorageHandle storage,
         Slice begin_key, EndPointKind begin_kind,
         Slice end_key, EndPointKind end_kind,
         IteratorHandle* result,
         std::size_t limit,
-        bool reverse) {
+        bool reverse,
+        bool key_only) {
     shirakami::Transaction* tx = nullptr;
     if (is_strand(transaction)) {
         // Strand object is not needed for scan because we have Iterators
@@ -544,19 +848,274 @@ StatusCode content_scan(
     if (!db) {
         return StatusCode::ERR_INVALID_STATE;
     }
-    std::unique_ptr<shirakami::Iterator> iter{};
-    auto rc = stg->scan(tx, begin_key, begin_kind, end_key, end_kind, iter, limit, reverse);
-    if(rc != StatusCode::OK) {
-        return rc;
+    auto& metrics = db->metrics();
+    auto started = metrics.start();
+    metrics.record_storage(stg->name().to_string_view(), MetricsOperation::SCAN_OPEN);
+    // iterator is bound to the transaction, so that allocate it from the transaction arena
+    auto* iter = tx->arena().create<shirakami::Iterator>(
+        stg, tx, begin_key, begin_kind, end_key, end_kind, limit, reverse, key_only);
+    tx->owner()->flight_recorder().record(common::flight_event_kind::scan_open, tx, iter);
+    *result = wrap(iter);
+    metrics.record(MetricsOperation::SCAN_OPEN, started, StatusCode::OK);
+    return StatusCode::OK;
+}
+
+StatusCode content_scan(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        IteratorHandle* result,
+        std::size_t limit,
+        bool reverse) {
+    return scan(transaction, storage, begin_key, begin_kind, end_key, end_kind, result, limit, reverse, false);
+}
+
+StatusCode content_scan_keys(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        IteratorHandle* result,
+        std::size_t limit,
+        bool reverse) {
+    return scan(transaction, storage, begin_key, begin_kind, end_key, end_kind, result, limit, reverse, true);
+}
+
+StatusCode content_scan_multi(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        ScanRange const* ranges,
+        std::size_t count,
+        IteratorHandle* result) {
+    shirakami::Transaction* tx = nullptr;
+    if (is_strand(transaction)) {
+        tx = unwrap_as_strand(transaction)->parent();
+    } else {
+        tx = unwrap(transaction);
+    }
+    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    auto stg = unwrap(storage);
+    auto& metrics = tx->owner()->metrics();
+    auto started = metrics.start();
+    metrics.record_storage(stg->name().to_string_view(), MetricsOperation::SCAN_OPEN);
+    auto* iter = tx->arena().create<shirakami::Iterator>(
+        stg, tx, Slice{}, EndPointKind::UNBOUND, Slice{}, EndPointKind::UNBOUND);
+    iter->ranges(ranges, count);
+    tx->owner()->flight_recorder().record(common::flight_event_kind::scan_open, tx, iter);
+    *result = wrap(iter);
+    metrics.record(MetricsOperation::SCAN_OPEN, started, StatusCode::OK);
+    return StatusCode::OK;
+}
+
+// returns the least key which is greater than all keys with the prefix, or empty if there is no such key
+static std::string prefix_upper_bound(std::string_view prefix) {
+    std::string ret{prefix};
+    while (! ret.empty()) {
+        if (++ret.back() != '\0') {
+            break;
+        }
+        // carry up
+        ret.pop_back();
+    }
+    return ret;
+}
+
+StatusCode storage_estimate_split_points(
+        TransactionHandle transaction,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::size_t partitions,
+        std::vector<std::string>& out) {
+    // the number of samples kept for each partition
+    static constexpr std::size_t samples_per_partition = 64;
+    // the max number of keys read for each partition before giving up the sampling
+    static constexpr std::size_t max_rows_per_partition = samples_per_partition * 16;
+    // the max number of probes to narrow down the last key of the prefixed range
+    static constexpr std::size_t max_last_key_probes = 64;
+    if (partitions == 0) {
+        return StatusCode::ERR_INVALID_ARGUMENT;
+    }
+    shirakami::Transaction* tx = nullptr;
+    if (is_strand(transaction)) {
+        tx = unwrap_as_strand(transaction)->parent();
+    } else {
+        tx = unwrap(transaction);
+    }
+    if (! tx->active()) return StatusCode::ERR_INACTIVE_TRANSACTION;
+    out.clear();
+    if (partitions == 1) {
+        return StatusCode::OK;
+    }
+    auto stg = unwrap(storage);
+    // the engine does not expose the index statistics, so that sample the keys in the range
+    auto max_rows = partitions * max_rows_per_partition;
+    shirakami::KeySampler sampler{partitions * samples_per_partition};
+    std::string first{};
+    {
+        shirakami::Iterator iter{stg, tx, begin_key, begin_kind, end_key, end_kind, 0, false, true};
+        while (sampler.count() < max_rows) {
+            auto rc = iter.next();
+            if (rc == StatusCode::NOT_FOUND) {
+                sampler.split_points(partitions, out);
+                return StatusCode::OK;
+            }
+            if (rc != StatusCode::OK) {
+                return rc;
+            }
+            Slice key{};
+            rc = iter.key(key);
+            if (rc == StatusCode::NOT_FOUND || rc == StatusCode::CONCURRENT_OPERATION) {
+                // the entry is concurrently modified - it is safe to skip for estimation
+                continue;
+            }
+            if (rc != StatusCode::OK) {
+                return rc;
+            }
+            if (sampler.count() == 0) {
+                first.assign(key.to_string_view());
+            }
+            sampler.offer(key);
+        }
+    }
+    // too many keys in the range - probe the keys interpolated between the first and the last key instead
+    std::string last{};
+    std::string upper{};
+    if (end_kind == EndPointKind::PREFIXED_INCLUSIVE) {
+        upper = prefix_upper_bound(end_key.to_string_view());
+    }
+    std::vector<std::string> probes{};
+    if (end_kind == EndPointKind::UNBOUND || (end_kind == EndPointKind::PREFIXED_INCLUSIVE && upper.empty())) {
+        shirakami::Iterator iter{stg, tx, first, EndPointKind::INCLUSIVE, {}, EndPointKind::UNBOUND, 1, true, true};
+        Slice key{};
+        if (iter.next() == StatusCode::OK && iter.key(key) == StatusCode::OK) {
+            last.assign(key.to_string_view());
+        }
+    } else if (end_kind == EndPointKind::PREFIXED_INCLUSIVE) {
+        // the prefix itself is less than the keys in the range, and the reverse scan cannot be bounded by it -
+        // bisect between the first key and the upper bound of the prefix with forward probes instead
+        last = first;
+        for (std::size_t i = 0; i < max_last_key_probes; ++i) {
+            shirakami::KeySampler::interpolate(last, upper, 2, probes);
+            if (probes.empty()) {
+                break;
+            }
+            shirakami::Iterator iter{stg, tx, probes[0], EndPointKind::INCLUSIVE, end_key, end_kind, 1, false, true};
+            auto rc = iter.next();
+            if (rc == StatusCode::NOT_FOUND) {
+                upper = std::move(probes[0]);
+                continue;
+            }
+            if (rc != StatusCode::OK) {
+                return rc;
+            }
+            Slice key{};
+            rc = iter.key(key);
+            if (rc == StatusCode::NOT_FOUND || rc == StatusCode::CONCURRENT_OPERATION) {
+                // some keys exist at or after the probe
+                last = std::move(probes[0]);
+                continue;
+            }
+            if (rc != StatusCode::OK) {
+                return rc;
+            }
+            last.assign(key.to_string_view());
+        }
+    } else {
+        last.assign(end_key.to_string_view());
+    }
+    shirakami::KeySampler::interpolate(first, last, partitions, probes);
+    if (probes.empty()) {
+        sampler.split_points(partitions, out);
+        return StatusCode::OK;
+    }
+    for (auto&& probe : probes) {
+        shirakami::Iterator iter{stg, tx, probe, EndPointKind::INCLUSIVE, end_key, end_kind, 1, false, true};
+        auto rc = iter.next();
+        if (rc == StatusCode::NOT_FOUND) {
+            break;
+        }
+        if (rc != StatusCode::OK) {
+            return rc;
+        }
+        Slice key{};
+        rc = iter.key(key);
+        if (rc == StatusCode::NOT_FOUND || rc == StatusCode::CONCURRENT_OPERATION) {
+            continue;
+        }
+        if (rc != StatusCode::OK) {
+            return rc;
+        }
+        if (out.empty() || key.to_string_view() > out.back()) {
+            out.emplace_back(key.to_string_view());
+        }
+    }
+    return StatusCode::OK;
+}
+
+StatusCode content_scan_partitioned(
+        TransactionHandle const* transactions,
+        StorageHandle storage,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind,
+        std::vector<std::string> const& split_points,
+        IteratorHandle* results) {
+    auto partitions = split_points.size() + 1;
+    for (std::size_t i = 0; i < partitions; ++i) {
+        auto first = i == 0;
+        auto last = i == partitions - 1;
+        auto rc = content_scan(
+            transactions[i],  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            storage,
+            first ? begin_key : Slice{split_points[i - 1]},
+            first ? begin_kind : EndPointKind::INCLUSIVE,
+            last ? end_key : Slice{split_points[i]},
+            last ? end_kind : EndPointKind::EXCLUSIVE,
+            &results[i]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (rc != StatusCode::OK) {
+            for (std::size_t j = 0; j < i; ++j) {
+                iterator_dispose(results[j]);  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            return rc;
+        }
     }
-    *result = wrap(iter.release());
     return StatusCode::OK;
 }
 
 StatusCode iterator_next(
         IteratorHandle handle) {
     auto iter = unwrap(handle);
-    return iter->next();
+    auto& metrics = iter->transaction()->owner()->metrics();
+    auto started = metrics.start();
+    auto rc = iter->next();
+    metrics.record(MetricsOperation::NEXT, started, rc);
+    return rc;
+}
+
+StatusCode iterator_next_batch(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        std::size_t max_bytes,
+        IteratorBatch* out) {
+    auto iter = unwrap(handle);
+    auto& metrics = iter->transaction()->owner()->metrics();
+    auto started = metrics.start();
+    auto rc = iter->next_batch(max_rows, max_bytes, *out);
+    metrics.record(MetricsOperation::NEXT, started, rc);
+    return rc;
+}
+
+StatusCode iterator_next_columns(
+        IteratorHandle handle,
+        std::size_t max_rows,
+        IteratorColumns* out) {
+    auto iter = unwrap(handle);
+    auto& metrics = iter->transaction()->owner()->metrics();
+    auto started = metrics.start();
+    auto rc = iter->next_columns(max_rows, *out);
+    metrics.record(MetricsOperation::NEXT, started, rc);
+    return rc;
 }
 
 StatusCode iterator_get_key(
@@ -573,10 +1132,51 @@ StatusCode iterator_get_value(
     return iter->value(*result);
 }
 
+StatusCode iterator_set_value_window(
+        IteratorHandle handle,
+        std::size_t offset,
+        std::size_t length) {
+    auto iter = unwrap(handle);
+    iter->value_window(offset, length);
+    return StatusCode::OK;
+}
+
+StatusCode iterator_set_read_ahead(
+        IteratorHandle handle,
+        std::size_t rows) {
+    auto iter = unwrap(handle);
+    return iter->read_ahead(rows);
+}
+
+StatusCode iterator_set_filter(
+        IteratorHandle handle,
+        ScanFilter filter,
+        void* context) {
+    auto iter = unwrap(handle);
+    return iter->filter(filter, context);
+}
+
+StatusCode iterator_seek(
+        IteratorHandle handle,
+        Slice key,
+        EndPointKind kind) {
+    auto iter = unwrap(handle);
+    return iter->seek(key, kind);
+}
+
+StatusCode iterator_rebind(
+        IteratorHandle handle,
+        Slice begin_key, EndPointKind begin_kind,
+        Slice end_key, EndPointKind end_kind) {
+    auto iter = unwrap(handle);
+    return iter->rebind(begin_key, begin_kind, end_key, end_kind);
+}
+
 StatusCode iterator_dispose(
         IteratorHandle handle) {
     auto iter = unwrap(handle);
-    delete iter;  // NOLINT
+    iter->transaction()->owner()->flight_recorder().record(common::flight_event_kind::scan_close, iter);
+    iter->transaction()->arena().destroy(iter);
     return StatusCode::OK;
 }
 
@@ -640,6 +1240,10 @@ StatusCode implementation_get_datastore(
 
 void print_diagnostics(std::ostream& os) {
     shirakami::api::print_diagnostics(os);
+    common::metrics::print_diagnostics(os);
+    common::hot_key_tracker::print_diagnostics(os);
+    common::print_api_trace(os);
+    common::flight_recorder::print(os);
 }
 
 }  // namespace sharksfin
@@ -67,7 +67,11 @@ Status leave(Token token) {
     return rc;
 }
 
+#ifdef SHARKSFIN_API_TRACE
+#define binstring(arg) (arg).size()  //NOLINT
+#else
 #define binstring(arg) " " #arg "(len=" << (arg).size() << "):\"" << common::binary_printer(arg) << "\"" //NOLINT
+#endif
 
 Status exist_key(Transaction& tx, ::shirakami::Storage storage, std::string_view key) {
     log_entry << "token:" << tx.native_handle() << " storage:" << storage << binstring(key);
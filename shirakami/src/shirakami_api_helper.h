@@ -25,14 +25,32 @@
 
 #include "Error.h"
 
+#ifdef SHARKSFIN_API_TRACE
+
+#include "api_trace.h"
+
+// record compact binary events into the per-thread trace buffers instead of formatting messages
+#define log_entry ::sharksfin::common::api_trace_writer{::sharksfin::common::api_trace_kind::entry, __func__}  //NOLINT
+#define log_exit ::sharksfin::common::api_trace_writer{::sharksfin::common::api_trace_kind::exit, __func__}  //NOLINT
+#define log_rc(rc) do { /*NOLINT*/  \
+    if((rc) != Status::OK) { \
+        ::sharksfin::common::api_trace_writer{::sharksfin::common::api_trace_kind::status, __func__} << (rc); /*NOLINT*/ \
+    } \
+} while(0);
+
+#else
+
+// DVLOG compiles to nothing in release builds
 #define log_entry DVLOG_LP(log_trace) << std::boolalpha << "--> "  //NOLINT
 #define log_exit DVLOG_LP(log_trace) << std::boolalpha << "<-- "  //NOLINT
 #define log_rc(rc) do { /*NOLINT*/  \
     if((rc) != Status::OK) { \
-        VLOG_LP(log_trace) << "--- rc:" << (rc); \
+        DVLOG_LP(log_trace) << "--- rc:" << (rc); \
     } \
 } while(0);
 
+#endif
+
 namespace sharksfin::shirakami {
 
 using Status = ::shirakami::Status;
@@ -15,17 +15,21 @@
  */
 #include "sharksfin/api.h"
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <future>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include "TestRoot.h"
 
 #include "sharksfin/HandleHolder.h"
 #include "Session.h"
+#include "handle_utils.h"
 
 namespace sharksfin {
 
@@ -553,6 +557,127 @@ TEST_F(ShirakamiApiTest, transaction_failed) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ShirakamiApiTest, transaction_retry_count) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation f(TransactionHandle, void* args) {
+            auto s = reinterpret_cast<S*>(args);
+            ++s->count;
+            return s->count < s->success_at ? TransactionOperation::RETRY : TransactionOperation::COMMIT;
+        }
+        std::size_t count;
+        std::size_t success_at;
+    };
+    {
+        S s{0, 10};
+        EXPECT_EQ(transaction_exec(db, {}, &S::f, &s), StatusCode::ERR_ABORTED_RETRYABLE);
+        EXPECT_EQ(s.count, 1);
+    }
+    {
+        S s{0, 10};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(3), &S::f, &s), StatusCode::ERR_ABORTED_RETRYABLE);
+        EXPECT_EQ(s.count, 4);
+    }
+    {
+        S s{0, 3};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(3), &S::f, &s), StatusCode::OK);
+        EXPECT_EQ(s.count, 3);
+    }
+    {
+        S s{0, 10};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(TransactionOptions::INF), &S::f, &s), StatusCode::OK);
+        EXPECT_EQ(s.count, 10);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, transaction_retry_commit_conflict) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation f(TransactionHandle tx, void* args) {
+            auto s = reinterpret_cast<S*>(args);
+            ++s->count;
+            if (s->count > 1) {
+                // the retry has passed the gate of the conflicting key, and released it before the attempt
+                auto gate = std::async(std::launch::async, [s] {
+                    auto lock = unwrap(s->db)->contention_gate().acquire("s", "a");
+                    return lock.owns_lock();
+                });
+                if (gate.wait_for(std::chrono::seconds{10}) == std::future_status::ready && gate.get()) {
+                    ++s->passed;
+                }
+            }
+            Slice v{};
+            if (content_get(tx, s->st, "a", &v) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (s->count <= s->conflicts) {
+                // conflicting write makes the read of "a" stale, so that the commit fails
+                TransactionControlHandle other{};
+                if (transaction_begin(s->db, {}, &other) != StatusCode::OK) {
+                    return TransactionOperation::ERROR;
+                }
+                HandleHolder oth { other };
+                TransactionHandle otx{};
+                if (transaction_borrow_handle(other, &otx) != StatusCode::OK
+                        || content_put(otx, s->st, "a", "X") != StatusCode::OK
+                        || transaction_commit(other) != StatusCode::OK) {
+                    return TransactionOperation::ERROR;
+                }
+            }
+            if (content_put(tx, s->st, "c", "C") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        DatabaseHandle db;
+        StorageHandle st;
+        std::size_t conflicts;
+        std::size_t count;
+        std::size_t passed;
+    };
+    StorageHandle st{};
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "a", "A"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        S s{db, st, 2, 0, 0};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(3), &S::f, &s), StatusCode::OK);
+        EXPECT_EQ(s.count, 3);
+        EXPECT_EQ(s.passed, 2);
+    }
+    {
+        S s{db, st, 10, 0, 0};
+        EXPECT_EQ(transaction_exec(db, TransactionOptions{}.retry_count(1), &S::f, &s), StatusCode::ERR_ABORTED_RETRYABLE);
+        EXPECT_EQ(s.count, 2);
+    }
+    {
+        S s{db, st, 10, 0, 0};
+        EXPECT_EQ(transaction_exec(db, {}, &S::f, &s), StatusCode::ERR_ABORTED_RETRYABLE);
+        EXPECT_EQ(s.count, 1);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 TEST_F(ShirakamiApiTest, transaction_borrow_owner) {
     DatabaseOptions options;
     options.attribute(KEY_LOCATION, path());
@@ -699,6 +824,126 @@ TEST_F(ShirakamiApiTest, contents) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ShirakamiApiTest, get_batch) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "c", "C") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            std::array<Slice, 4> keys{ "c", "x", "a", "b" };
+            std::array<Slice, 4> results{};
+            std::array<StatusCode, 4> statuses{};
+            if (content_get_batch(tx, st, keys.data(), keys.size(), results.data(), statuses.data()) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[0] != StatusCode::OK || results[0] != "C") {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[1] != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[2] != StatusCode::OK || results[2] != "A") {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[3] != StatusCode::OK || results[3] != "B") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, get_pinned) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice a;
+            if (content_get_pinned(tx, st, "a", &a) != StatusCode::OK || a != "A") {
+                return TransactionOperation::ERROR;
+            }
+            Slice b;
+            if (content_get_pinned(tx, st, "b", &b) != StatusCode::OK || b != "B") {
+                return TransactionOperation::ERROR;
+            }
+            Slice s;
+            if (content_get_pinned(tx, st, "x", &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            // pinned results are not disposed by other operations
+            if (content_put(tx, st, "a", "AA") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get(tx, st, "b", &s) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (a != "A" || b != "B") {
+                return TransactionOperation::ERROR;
+            }
+            if (content_release(tx, a) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_release(tx, a) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (b != "B") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 TEST_F(ShirakamiApiTest, put_operations) {
     DatabaseOptions options;
     options.attribute(KEY_LOCATION, path());
@@ -798,6 +1043,85 @@ TEST_F(ShirakamiApiTest, put_operations) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ShirakamiApiTest, put_delete_batch) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "b", "B0") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation put(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            std::array<Slice, 4> keys{ "c", "b", "a", "b" };
+            std::array<Slice, 4> values{ "C", "B1", "A", "B2" };
+            std::array<PutOperation, 4> operations{
+                PutOperation::CREATE,
+                PutOperation::CREATE,
+                PutOperation::CREATE_OR_UPDATE,
+                PutOperation::UPDATE,
+            };
+            std::array<StatusCode, 4> statuses{};
+            if (content_put_batch(tx, st, keys.data(), values.data(), operations.data(), keys.size(), statuses.data()) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[0] != StatusCode::OK || statuses[1] != StatusCode::ALREADY_EXISTS ||
+                statuses[2] != StatusCode::OK || statuses[3] != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation remove(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice s;
+            if (content_get(tx, st, "b", &s) != StatusCode::OK || s != "B2") {
+                return TransactionOperation::ERROR;
+            }
+            std::array<Slice, 2> keys{ "c", "a" };
+            std::array<StatusCode, 2> statuses{};
+            if (content_delete_batch(tx, st, keys.data(), keys.size(), statuses.data()) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (statuses[0] != StatusCode::OK || statuses[1] != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation validate(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice s;
+            if (content_get(tx, st, "a", &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get(tx, st, "c", &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get(tx, st, "b", &s) != StatusCode::OK || s != "B2") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::put, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::remove, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::validate, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 TEST_F(ShirakamiApiTest, scan_prefix) {
     DatabaseOptions options;
     options.attribute(KEY_LOCATION, path());
@@ -1027,9 +1351,10 @@ TEST_F(ShirakamiApiTest, scan) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
-TEST_F(ShirakamiApiTest, scan_with_limit) {
+TEST_F(ShirakamiApiTest, scan_batch) {
     DatabaseOptions options;
     options.attribute(KEY_LOCATION, path());
+
     DatabaseHandle db;
     ASSERT_EQ(database_open(options, &db), StatusCode::OK);
     HandleHolder dbh { db };
@@ -1037,20 +1362,12 @@ TEST_F(ShirakamiApiTest, scan_with_limit) {
     struct S {
         static TransactionOperation prepare(TransactionHandle tx, void* args) {
             auto st = extract<S>(args);
-            if (content_put(tx, st, "a", "NG") != StatusCode::OK) {
-                return TransactionOperation::ERROR;
-            }
-            if (content_put(tx, st, "a1", "NG") != StatusCode::OK) {
-                return TransactionOperation::ERROR;
-            }
-            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
-                return TransactionOperation::ERROR;
-            }
-            if (content_put(tx, st, "c", "C") != StatusCode::OK) {
-                return TransactionOperation::ERROR;
-            }
-            if (content_put(tx, st, "d", "NG") != StatusCode::OK) {
-                return TransactionOperation::ERROR;
+            for (std::string_view k : { "a", "b", "c", "d", "e" }) {
+                std::string v{k};
+                v[0] = static_cast<char>(v[0] - 'a' + 'A');
+                if (content_put(tx, st, k, v) != StatusCode::OK) {
+                    return TransactionOperation::ERROR;
+                }
             }
             return TransactionOperation::COMMIT;
         }
@@ -1059,36 +1376,46 @@ TEST_F(ShirakamiApiTest, scan_with_limit) {
             IteratorHandle iter;
             if (content_scan(
                     tx, st,
-                    "b", EndPointKind::PREFIXED_INCLUSIVE,
                     "", EndPointKind::UNBOUND,
-                    &iter,
-                    2) != StatusCode::OK) {
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
                 return TransactionOperation::ERROR;
             }
             HandleHolder closer { iter };
 
-            Slice s;
-            if (iterator_next(iter) != StatusCode::OK) {
+            std::array<IteratorBatchEntry, 10> entries{};
+            std::array<char, 100> data{};
+            IteratorBatch batch{entries.data(), data.data(), 0, 0};
+            if (iterator_next_batch(iter, 2, data.size(), &batch) != StatusCode::OK || batch.row_count != 2) {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "b") {
+            if (batch.key(0) != "a" || batch.value(0) != "A" || batch.key(1) != "b" || batch.value(1) != "B") {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "B") {
+            // "d" does not fit into the rest of buffer, and is kept for the next call
+            if (iterator_next_batch(iter, entries.size(), 3, &batch) != StatusCode::OK || batch.row_count != 1) {
                 return TransactionOperation::ERROR;
             }
-
+            if (batch.key(0) != "c" || batch.value(0) != "C" || batch.data_size != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_batch(iter, entries.size(), 1, &batch) != StatusCode::ERR_RESOURCE_LIMIT_REACHED) {
+                return TransactionOperation::ERROR;
+            }
+            Slice s;
             if (iterator_next(iter) != StatusCode::OK) {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "c") {
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "d") {
                 return TransactionOperation::ERROR;
             }
-            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "C") {
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::OK || batch.row_count != 1) {
                 return TransactionOperation::ERROR;
             }
-
-            if (iterator_next(iter) != StatusCode::NOT_FOUND) {
+            if (batch.key(0) != "e" || batch.value(0) != "E") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::NOT_FOUND || batch.row_count != 0) {
                 return TransactionOperation::ERROR;
             }
             return TransactionOperation::COMMIT;
@@ -1104,10 +1431,10 @@ TEST_F(ShirakamiApiTest, scan_with_limit) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
-TEST_F(ShirakamiApiTest, reverse_scan) {
-    // currently reverse scan can fetch only one entry with unbonded end point
+TEST_F(ShirakamiApiTest, scan_columns) {
     DatabaseOptions options;
     options.attribute(KEY_LOCATION, path());
+
     DatabaseHandle db;
     ASSERT_EQ(database_open(options, &db), StatusCode::OK);
     HandleHolder dbh { db };
@@ -1115,7 +1442,243 @@ TEST_F(ShirakamiApiTest, reverse_scan) {
     struct S {
         static TransactionOperation prepare(TransactionHandle tx, void* args) {
             auto st = extract<S>(args);
-            if (content_put(tx, st, "a", "NG") != StatusCode::OK) {
+            if (content_put(tx, st, "a", "A") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "c", "CCC") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "", EndPointKind::UNBOUND,
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+
+            std::array<std::int64_t, 11> key_offsets{};
+            std::array<char, 100> key_data{};
+            std::array<std::int64_t, 11> value_offsets{};
+            std::array<char, 2> value_data{};
+            IteratorColumns columns{
+                key_offsets.data(), key_data.data(), key_data.size(),
+                value_offsets.data(), value_data.data(), value_data.size(),
+                0,
+            };
+            // "CCC" does not fit into the value buffer
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::OK || columns.row_count != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (key_offsets[0] != 0 || key_offsets[1] != 1 || key_offsets[2] != 2) {
+                return TransactionOperation::ERROR;
+            }
+            if (value_offsets[0] != 0 || value_offsets[1] != 1 || value_offsets[2] != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (columns.key(0) != "a" || columns.value(0) != "A" || columns.key(1) != "b" || columns.value(1) != "") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::ERR_RESOURCE_LIMIT_REACHED) {
+                return TransactionOperation::ERROR;
+            }
+            std::array<char, 10> large_value_data{};
+            columns.value_data = large_value_data.data();
+            columns.value_data_capacity = large_value_data.size();
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::OK || columns.row_count != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (columns.key(0) != "c" || columns.value(0) != "CCC") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next_columns(iter, 10, &columns) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, partial_value) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "0123456789") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "ab") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            Slice s;
+            if (content_get_partial(tx, st, "a", 2, 3, &s) != StatusCode::OK || s != "234") {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get_partial(tx, st, "a", 8, 10, &s) != StatusCode::OK || s != "89") {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get_partial(tx, st, "a", 20, 10, &s) != StatusCode::OK || ! s.empty()) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_get_partial(tx, st, "x", 0, 1, &s) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "", EndPointKind::UNBOUND,
+                    "", EndPointKind::UNBOUND,
+                    &iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+            if (iterator_set_value_window(iter, 1, 2) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "12") {
+                return TransactionOperation::ERROR;
+            }
+            std::array<IteratorBatchEntry, 10> entries{};
+            std::array<char, 100> data{};
+            IteratorBatch batch{entries.data(), data.data(), 0, 0};
+            if (iterator_next_batch(iter, entries.size(), data.size(), &batch) != StatusCode::OK || batch.row_count != 1) {
+                return TransactionOperation::ERROR;
+            }
+            if (batch.key(0) != "b" || batch.value(0) != "b") {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, scan_with_limit) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "NG") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "a1", "NG") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "b", "B") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "c", "C") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (content_put(tx, st, "d", "NG") != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        static TransactionOperation test(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            IteratorHandle iter;
+            if (content_scan(
+                    tx, st,
+                    "b", EndPointKind::PREFIXED_INCLUSIVE,
+                    "", EndPointKind::UNBOUND,
+                    &iter,
+                    2) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            HandleHolder closer { iter };
+
+            Slice s;
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "b") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "B") {
+                return TransactionOperation::ERROR;
+            }
+
+            if (iterator_next(iter) != StatusCode::OK) {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_key(iter, &s) != StatusCode::OK || s != "c") {
+                return TransactionOperation::ERROR;
+            }
+            if (iterator_get_value(iter, &s) != StatusCode::OK || s != "C") {
+                return TransactionOperation::ERROR;
+            }
+
+            if (iterator_next(iter) != StatusCode::NOT_FOUND) {
+                return TransactionOperation::ERROR;
+            }
+            return TransactionOperation::COMMIT;
+        }
+        StorageHandle st;
+    };
+    S s;
+    ASSERT_EQ(storage_create(db, "s", &s.st), StatusCode::OK);
+    HandleHolder sth { s.st };
+
+    EXPECT_EQ(transaction_exec(db, {}, &S::prepare, &s), StatusCode::OK);
+    EXPECT_EQ(transaction_exec(db, {}, &S::test, &s), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, reverse_scan) {
+    // currently reverse scan can fetch only one entry with unbonded end point
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    struct S {
+        static TransactionOperation prepare(TransactionHandle tx, void* args) {
+            auto st = extract<S>(args);
+            if (content_put(tx, st, "a", "NG") != StatusCode::OK) {
                 return TransactionOperation::ERROR;
             }
             if (content_put(tx, st, "a1", "NG") != StatusCode::OK) {
@@ -2321,4 +2884,934 @@ TEST_F(ShirakamiApiTest, rtx_strand) {
     EXPECT_EQ(database_close(db), StatusCode::OK);
 }
 
+TEST_F(ShirakamiApiTest, strand_write) {
+    // verify writes from strands are applied on commit
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "c", "C"), StatusCode::OK);
+
+        TransactionHandle s0{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0), StatusCode::OK);
+        HandleHolder<TransactionHandle> s1{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s1.get()), StatusCode::OK);
+
+        std::thread t0{[&]() {
+            EXPECT_EQ(content_put(s0, st, "a", "A"), StatusCode::OK);
+            EXPECT_EQ(content_delete(s0, st, "c"), StatusCode::OK);
+        }};
+        std::thread t1{[&]() {
+            EXPECT_EQ(content_put(s1.get(), st, "b", "B"), StatusCode::OK);
+        }};
+        t0.join();
+        t1.join();
+
+        // writes from released strand are still applied
+        ASSERT_EQ(transaction_release_handle(s0), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice v{};
+        ASSERT_EQ(content_get(tx, st, "a", &v), StatusCode::OK);
+        EXPECT_EQ(v, "A");
+        ASSERT_EQ(content_get(tx, st, "b", &v), StatusCode::OK);
+        EXPECT_EQ(v, "B");
+        EXPECT_EQ(content_get(tx, st, "c", &v), StatusCode::NOT_FOUND);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, strand_write_readonly) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    TransactionOptions txopts{};
+    txopts.transaction_type(TransactionOptions::TransactionType::READ_ONLY);
+    ASSERT_EQ(transaction_begin(db, txopts, &tch.get()), StatusCode::OK);
+    HandleHolder<TransactionHandle> s0{};
+    ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0.get()), StatusCode::OK);
+    EXPECT_EQ(content_put(s0.get(), st, "a", "A"), StatusCode::ERR_ILLEGAL_OPERATION);
+    EXPECT_EQ(content_delete(s0.get(), st, "a"), StatusCode::ERR_ILLEGAL_OPERATION);
+    EXPECT_EQ(transaction_abort(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, strand_write_then_parent_write) {
+    // verify the parent cannot overwrite the key buffered in the strand, which would be lost on commit
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        HandleHolder<TransactionHandle> s0{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0.get()), StatusCode::OK);
+
+        ASSERT_EQ(content_put(s0.get(), st, "a", "A"), StatusCode::OK);
+        EXPECT_EQ(content_delete(tx, st, "a"), StatusCode::ERR_ILLEGAL_OPERATION);
+        EXPECT_EQ(content_put(tx, st, "a", "X"), StatusCode::ERR_ILLEGAL_OPERATION);
+
+        std::array<Slice, 2> keys{"a", "b"};
+        std::array<StatusCode, 2> statuses{};
+        EXPECT_EQ(content_delete_batch(tx, st, keys.data(), keys.size(), statuses.data()),
+            StatusCode::ERR_ILLEGAL_OPERATION);
+        EXPECT_EQ(statuses[0], StatusCode::ERR_ILLEGAL_OPERATION);
+
+        // other keys are still available
+        ASSERT_EQ(content_put(tx, st, "b", "B"), StatusCode::OK);
+
+        // the keys are kept after the strand is released
+        TransactionHandle s1{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s1), StatusCode::OK);
+        ASSERT_EQ(content_put(s1, st, "c", "C"), StatusCode::OK);
+        ASSERT_EQ(transaction_release_handle(s1), StatusCode::OK);
+        EXPECT_EQ(content_put(tx, st, "c", "X"), StatusCode::ERR_ILLEGAL_OPERATION);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice v{};
+        ASSERT_EQ(content_get(tx, st, "a", &v), StatusCode::OK);
+        EXPECT_EQ(v, "A");
+        ASSERT_EQ(content_get(tx, st, "b", &v), StatusCode::OK);
+        EXPECT_EQ(v, "B");
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, strand_write_not_applicable) {
+    // verify the buffered write which is not applicable makes the commit fail
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "a", "A"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        HandleHolder<TransactionHandle> s0{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0.get()), StatusCode::OK);
+        ASSERT_EQ(content_put(s0.get(), st, "b", "B"), StatusCode::OK);
+        ASSERT_EQ(content_put(s0.get(), st, "a", "X", PutOperation::CREATE), StatusCode::OK);
+        StatusCode status{};
+        ErrorCode error{};
+        EXPECT_TRUE(transaction_commit_with_callback(tch.get(), [&](StatusCode st, ErrorCode ec, durability_marker_type) {
+            status = st;
+            error = ec;
+        }));
+        EXPECT_EQ(status, StatusCode::ERR_ABORTED);
+        EXPECT_EQ(error, ErrorCode::KVS_KEY_ALREADY_EXISTS);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        HandleHolder<TransactionHandle> s0{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0.get()), StatusCode::OK);
+        ASSERT_EQ(content_put(s0.get(), st, "c", "C", PutOperation::UPDATE), StatusCode::OK);
+        StatusCode status{};
+        ErrorCode error{};
+        EXPECT_TRUE(transaction_commit_with_callback(tch.get(), [&](StatusCode st, ErrorCode ec, durability_marker_type) {
+            status = st;
+            error = ec;
+        }));
+        EXPECT_EQ(status, StatusCode::ERR_ABORTED);
+        EXPECT_EQ(error, ErrorCode::KVS_KEY_NOT_FOUND);
+    }
+    {
+        // deleting missing entries is not a failure
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        HandleHolder<TransactionHandle> s0{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0.get()), StatusCode::OK);
+        ASSERT_EQ(content_delete(s0.get(), st, "d"), StatusCode::OK);
+        ASSERT_EQ(content_put(s0.get(), st, "e", "E"), StatusCode::OK);
+        EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice v{};
+        ASSERT_EQ(content_get(tx, st, "a", &v), StatusCode::OK);
+        EXPECT_EQ(v, "A");
+        EXPECT_EQ(content_get(tx, st, "b", &v), StatusCode::NOT_FOUND);
+        EXPECT_EQ(content_get(tx, st, "c", &v), StatusCode::NOT_FOUND);
+        ASSERT_EQ(content_get(tx, st, "e", &v), StatusCode::OK);
+        EXPECT_EQ(v, "E");
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, strand_write_batch) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        HandleHolder<TransactionHandle> s0{};
+        ASSERT_EQ(transaction_acquire_handle(tch.get(), &s0.get()), StatusCode::OK);
+
+        std::array<Slice, 3> keys{"b", "a", "c"};
+        std::array<Slice, 3> values{"B", "A", "C"};
+        std::array<PutOperation, 3> operations{
+            PutOperation::CREATE, PutOperation::CREATE, PutOperation::CREATE_OR_UPDATE};
+        std::array<StatusCode, 3> statuses{};
+        ASSERT_EQ(content_put_batch(s0.get(), st, keys.data(), values.data(), operations.data(), keys.size(), statuses.data()),
+            StatusCode::OK);
+        EXPECT_EQ(statuses, (std::array<StatusCode, 3>{StatusCode::OK, StatusCode::OK, StatusCode::OK}));
+
+        std::array<Slice, 1> removes{"c"};
+        std::array<StatusCode, 1> removed{};
+        ASSERT_EQ(content_delete_batch(s0.get(), st, removes.data(), removes.size(), removed.data()), StatusCode::OK);
+        EXPECT_EQ(removed[0], StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice v{};
+        ASSERT_EQ(content_get(tx, st, "a", &v), StatusCode::OK);
+        EXPECT_EQ(v, "A");
+        ASSERT_EQ(content_get(tx, st, "b", &v), StatusCode::OK);
+        EXPECT_EQ(v, "B");
+        EXPECT_EQ(content_get(tx, st, "c", &v), StatusCode::NOT_FOUND);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, split_points) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        for (std::size_t i = 0; i < 100; ++i) {
+            std::string key{"k00"};
+            key[1] = static_cast<char>('0' + i / 10);
+            key[2] = static_cast<char>('0' + i % 10);
+            ASSERT_EQ(content_put(tx, st, key, "v"), StatusCode::OK);
+        }
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+
+    std::vector<std::string> keys{};
+    EXPECT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, 0, keys),
+        StatusCode::ERR_INVALID_ARGUMENT);
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "k1", EndPointKind::INCLUSIVE, "k3", EndPointKind::EXCLUSIVE, 4, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k15", "k20", "k25"}));
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "k00", EndPointKind::INCLUSIVE, "k01", EndPointKind::INCLUSIVE, 4, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k01"}));
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, 4, keys),
+        StatusCode::OK);
+    ASSERT_EQ(keys, (std::vector<std::string>{"k25", "k50", "k75"}));
+
+    std::array<TransactionHandle, 4> txs{tx, tx, tx, tx};
+    std::array<IteratorHandle, 4> iters{};
+    ASSERT_EQ(content_scan_partitioned(
+        txs.data(), st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, keys, iters.data()), StatusCode::OK);
+    for (std::size_t i = 0; i < iters.size(); ++i) {
+        HandleHolder closer { iters[i] };
+        std::size_t count = 0;
+        Slice first{};
+        while (iterator_next(iters[i]) == StatusCode::OK) {
+            if (count == 0) {
+                ASSERT_EQ(iterator_get_key(iters[i], &first), StatusCode::OK);
+                EXPECT_EQ(first, i == 0 ? "k00" : keys[i - 1]);
+            }
+            ++count;
+        }
+        EXPECT_EQ(count, 25);
+    }
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, split_points_large) {
+    // verify split points are estimated without reading the entire range
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        for (std::size_t i = 0; i < 4000; ++i) {
+            std::string key{"k0000"};
+            for (std::size_t j = 0, n = i; j < 4; ++j, n /= 10) {
+                key[4 - j] = static_cast<char>('0' + n % 10);
+            }
+            ASSERT_EQ(content_put(tx, st, key, "v"), StatusCode::OK);
+        }
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+
+    std::vector<std::string> keys{};
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, 2, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k2000"}));
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "k4", EndPointKind::EXCLUSIVE, 2, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k2000"}));
+    ASSERT_EQ(storage_estimate_split_points(tx, st, "", EndPointKind::UNBOUND, "k", EndPointKind::PREFIXED_INCLUSIVE, 2, keys),
+        StatusCode::OK);
+    EXPECT_EQ(keys, (std::vector<std::string>{"k2000"}));
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, scan_read_ahead) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        for (char c = 'a'; c <= 'j'; ++c) {
+            std::string key(1, c);
+            ASSERT_EQ(content_put(tx, st, key, key + key), StatusCode::OK);
+        }
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        // not a read-only transaction
+        EXPECT_EQ(iterator_set_read_ahead(iter, 3), StatusCode::ERR_ILLEGAL_OPERATION);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    HandleHolder<TransactionControlHandle> tch{};
+    TransactionOptions txopts{};
+    txopts.transaction_type(TransactionOptions::TransactionType::READ_ONLY);
+    ASSERT_EQ(transaction_begin(db, txopts, &tch.get()), StatusCode::OK);
+    wait_epochs(1); // wait for RTX to become ready
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        EXPECT_EQ(iterator_set_read_ahead(iter, 0), StatusCode::ERR_INVALID_ARGUMENT);
+        ASSERT_EQ(iterator_set_read_ahead(iter, 3), StatusCode::OK);
+        for (char c = 'a'; c <= 'j'; ++c) {
+            std::string key(1, c);
+            ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+            Slice s{};
+            ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+            EXPECT_EQ(s, key);
+            ASSERT_EQ(iterator_get_value(iter, &s), StatusCode::OK);
+            EXPECT_EQ(s, key + key);
+        }
+        EXPECT_EQ(iterator_next(iter), StatusCode::NOT_FOUND);
+    }
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+        // already advanced
+        EXPECT_EQ(iterator_set_read_ahead(iter, 3), StatusCode::ERR_ILLEGAL_OPERATION);
+    }
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, scan_read_ahead_commit) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        for (char c = 'a'; c <= 'z'; ++c) {
+            std::string key(1, c);
+            ASSERT_EQ(content_put(tx, st, key, key), StatusCode::OK);
+        }
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    HandleHolder<TransactionControlHandle> tch{};
+    TransactionOptions txopts{};
+    txopts.transaction_type(TransactionOptions::TransactionType::READ_ONLY);
+    ASSERT_EQ(transaction_begin(db, txopts, &tch.get()), StatusCode::OK);
+    wait_epochs(1); // wait for RTX to become ready
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+
+    IteratorHandle iter{};
+    ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+    HandleHolder closer { iter };
+    // the filter is evaluated on the helper thread
+    std::thread::id caller = std::this_thread::get_id();
+    ASSERT_EQ(iterator_set_filter(iter, [](Slice, Slice, void* context) {
+        auto* caller = static_cast<std::thread::id*>(context);
+        return *caller != std::this_thread::get_id();
+    }, &caller), StatusCode::OK);
+    ASSERT_EQ(iterator_set_read_ahead(iter, 2), StatusCode::OK);
+    ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+    Slice s{};
+    ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "a");
+
+    // the helper thread is stopped before commit, and the rest of rows are never provided
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(iterator_next(iter), StatusCode::ERR_INACTIVE_TRANSACTION);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, iterator_seek) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    for (std::string_view k : { "a", "b", "b/1", "c", "d", "e" }) {
+        ASSERT_EQ(content_put(tx, st, k, k), StatusCode::OK);
+    }
+    auto next_key = [](IteratorHandle iter) {
+        if (iterator_next(iter) != StatusCode::OK) {
+            return std::string{"<EOF>"};
+        }
+        Slice s{};
+        if (iterator_get_key(iter, &s) != StatusCode::OK) {
+            return std::string{"<ERROR>"};
+        }
+        return s.to_string();
+    };
+
+    IteratorHandle iter{};
+    ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "b", EndPointKind::PREFIXED_INCLUSIVE, &iter), StatusCode::OK);
+    HandleHolder closer { iter };
+    EXPECT_EQ(next_key(iter), "a");
+    EXPECT_EQ(next_key(iter), "b");
+
+    // seek from the current key
+    Slice current{};
+    ASSERT_EQ(iterator_get_key(iter, &current), StatusCode::OK);
+    ASSERT_EQ(iterator_seek(iter, current, EndPointKind::EXCLUSIVE), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "b/1");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    // seek backward
+    ASSERT_EQ(iterator_seek(iter, "", EndPointKind::UNBOUND), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "a");
+
+    ASSERT_EQ(iterator_rebind(iter, "b", EndPointKind::PREFIXED_EXCLUSIVE, "d", EndPointKind::INCLUSIVE), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "c");
+    EXPECT_EQ(next_key(iter), "d");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    ASSERT_EQ(iterator_seek(iter, "d", EndPointKind::INCLUSIVE), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "d");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    ASSERT_EQ(iterator_rebind(iter, "d", EndPointKind::EXCLUSIVE, "", EndPointKind::UNBOUND), StatusCode::OK);
+    EXPECT_EQ(next_key(iter), "e");
+    EXPECT_EQ(next_key(iter), "<EOF>");
+
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, scan_multi) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    for (std::string_view k : { "a", "b", "c", "d", "e", "f", "g" }) {
+        ASSERT_EQ(content_put(tx, st, k, k), StatusCode::OK);
+    }
+    auto next_key = [](IteratorHandle iter) {
+        if (iterator_next(iter) != StatusCode::OK) {
+            return std::string{"<EOF>"};
+        }
+        Slice s{};
+        if (iterator_get_key(iter, &s) != StatusCode::OK) {
+            return std::string{"<ERROR>"};
+        }
+        return s.to_string();
+    };
+    {
+        std::array<ScanRange, 4> ranges{
+            ScanRange{"a", EndPointKind::INCLUSIVE, "a", EndPointKind::INCLUSIVE},
+            ScanRange{"aa", EndPointKind::INCLUSIVE, "ab", EndPointKind::INCLUSIVE},
+            ScanRange{"c", EndPointKind::EXCLUSIVE, "f", EndPointKind::EXCLUSIVE},
+            ScanRange{"g", EndPointKind::PREFIXED_INCLUSIVE, "g", EndPointKind::PREFIXED_INCLUSIVE},
+        };
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan_multi(tx, st, ranges.data(), ranges.size(), &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        EXPECT_EQ(next_key(iter), "a");
+        EXPECT_EQ(next_key(iter), "d");
+        EXPECT_EQ(next_key(iter), "e");
+        EXPECT_EQ(next_key(iter), "g");
+        EXPECT_EQ(next_key(iter), "<EOF>");
+
+        EXPECT_EQ(iterator_seek(iter, "b", EndPointKind::INCLUSIVE), StatusCode::ERR_ILLEGAL_OPERATION);
+        ASSERT_EQ(iterator_rebind(iter, "f", EndPointKind::INCLUSIVE, "", EndPointKind::UNBOUND), StatusCode::OK);
+        EXPECT_EQ(next_key(iter), "f");
+        EXPECT_EQ(next_key(iter), "g");
+        EXPECT_EQ(next_key(iter), "<EOF>");
+    }
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan_multi(tx, st, nullptr, 0, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        EXPECT_EQ(next_key(iter), "<EOF>");
+    }
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, scan_filter) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "b", "2"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "d", "4"), StatusCode::OK);
+
+    struct S {
+        static bool even(Slice, Slice value, void* context) {
+            ++*static_cast<std::size_t*>(context);
+            return (value.at<char>(0) - '0') % 2 == 0;
+        }
+    };
+    std::size_t calls = 0;
+    IteratorHandle iter{};
+    ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+    HandleHolder closer { iter };
+    ASSERT_EQ(iterator_set_filter(iter, &S::even, &calls), StatusCode::OK);
+
+    Slice s{};
+    ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+    ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "b");
+    ASSERT_EQ(iterator_get_value(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "2");
+
+    std::array<IteratorBatchEntry, 10> entries{};
+    std::array<char, 100> data{};
+    IteratorBatch batch{entries.data(), data.data(), 0, 0};
+    ASSERT_EQ(iterator_next_batch(iter, entries.size(), data.size(), &batch), StatusCode::OK);
+    ASSERT_EQ(batch.row_count, 1);
+    EXPECT_EQ(batch.key(0), "d");
+    EXPECT_EQ(iterator_next(iter), StatusCode::NOT_FOUND);
+    EXPECT_EQ(calls, 4);
+
+    // clear the filter
+    ASSERT_EQ(iterator_set_filter(iter, nullptr, nullptr), StatusCode::OK);
+    ASSERT_EQ(iterator_seek(iter, "c", EndPointKind::INCLUSIVE), StatusCode::OK);
+    ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+    ASSERT_EQ(iterator_get_key(iter, &s), StatusCode::OK);
+    EXPECT_EQ(s, "c");
+
+    EXPECT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, metrics) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    options.attribute("perf", "true");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "b", "2"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice s{};
+        ASSERT_EQ(content_get(tx, st, "a", &s), StatusCode::OK);
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        while (iterator_next(iter) == StatusCode::OK) {}
+
+        // conflicting write makes the read of "a" stale
+        HandleHolder<TransactionControlHandle> other{};
+        ASSERT_EQ(transaction_begin(db, {}, &other.get()), StatusCode::OK);
+        TransactionHandle otx{};
+        ASSERT_EQ(transaction_borrow_handle(other.get(), &otx), StatusCode::OK);
+        ASSERT_EQ(content_put(otx, st, "a", "X"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(other.get()), StatusCode::OK);
+
+        ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::ERR_ABORTED_RETRYABLE);
+    }
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.operation(MetricsOperation::BEGIN).calls, 3);
+    EXPECT_EQ(metrics.operation(MetricsOperation::PUT).calls, 4);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).calls, 1);
+    EXPECT_EQ(metrics.operation(MetricsOperation::SCAN_OPEN).calls, 1);
+    EXPECT_EQ(metrics.operation(MetricsOperation::NEXT).calls, 3);
+    EXPECT_EQ(metrics.operation(MetricsOperation::COMMIT).calls, 3);
+    EXPECT_EQ(metrics.operation(MetricsOperation::COMMIT).errors, 1);
+    EXPECT_EQ(metrics.operation(MetricsOperation::COMMIT).latency.count(), 3);
+    EXPECT_EQ(metrics.storages["s"].put_count, 4);
+    EXPECT_EQ(metrics.aborts[ErrorCode::CC_OCC_READ_ERROR], 1);
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    EXPECT_NE(ss.str().find("COMMIT: calls=3 errors=1"), std::string::npos);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, metrics_batch) {
+    // verify the batch and pinned operations are also recorded
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    options.attribute("perf", "true");
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "b", "2"), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+
+    std::array<Slice, 3> keys{"a", "b", "x"};
+    std::array<Slice, 3> results{};
+    std::array<StatusCode, 3> statuses{};
+    ASSERT_EQ(content_get_batch(tx, st, keys.data(), keys.size(), results.data(), statuses.data()), StatusCode::OK);
+    Slice pinned{};
+    ASSERT_EQ(content_get_pinned(tx, st, "a", &pinned), StatusCode::OK);
+    ASSERT_EQ(content_release(tx, pinned), StatusCode::OK);
+    {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(tx, st, "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        HandleHolder closer { iter };
+        std::array<IteratorBatchEntry, 10> entries{};
+        std::array<char, 100> data{};
+        IteratorBatch batch{entries.data(), data.data(), 0, 0};
+        ASSERT_EQ(iterator_next_batch(iter, 2, data.size(), &batch), StatusCode::OK);
+
+        std::array<std::int64_t, 11> key_offsets{};
+        std::array<char, 100> key_data{};
+        std::array<std::int64_t, 11> value_offsets{};
+        std::array<char, 100> value_data{};
+        IteratorColumns columns{
+            key_offsets.data(), key_data.data(), key_data.size(),
+            value_offsets.data(), value_data.data(), value_data.size(),
+            0,
+        };
+        ASSERT_EQ(iterator_next_columns(iter, 10, &columns), StatusCode::OK);
+        ASSERT_EQ(iterator_next_batch(iter, 2, data.size(), &batch), StatusCode::NOT_FOUND);
+    }
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    MetricsSnapshot metrics{};
+    ASSERT_EQ(database_get_metrics(db, metrics), StatusCode::OK);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).calls, 4);
+    EXPECT_EQ(metrics.operation(MetricsOperation::GET).latency.count(), 4);
+    EXPECT_EQ(metrics.operation(MetricsOperation::NEXT).calls, 3);
+    EXPECT_EQ(metrics.operation(MetricsOperation::NEXT).latency.count(), 3);
+    EXPECT_EQ(metrics.storages["s"].get_count, 4);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, transaction_timings) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+
+    HandleHolder<TransactionControlHandle> tch{};
+    ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+    TransactionHandle tx{};
+    ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+    ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+    ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+
+    std::shared_ptr<TransactionInfo> info{};
+    ASSERT_EQ(transaction_get_info(tch.get(), info), StatusCode::OK);
+    EXPECT_FALSE(info->id().empty());
+    auto&& t = info->timings();
+    EXPECT_TRUE(t.duration(TransactionPhase::QUEUEING));
+    EXPECT_TRUE(t.duration(TransactionPhase::EXECUTION));
+    EXPECT_TRUE(t.duration(TransactionPhase::VALIDATION));
+    EXPECT_TRUE(t.at(TransactionEvent::FIRST_OPERATION));
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, flight_recorder) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice s{};
+        ASSERT_EQ(content_get(tx, st, "a", &s), StatusCode::OK);
+
+        // conflicting write makes the read of "a" stale
+        HandleHolder<TransactionControlHandle> other{};
+        ASSERT_EQ(transaction_begin(db, {}, &other.get()), StatusCode::OK);
+        TransactionHandle otx{};
+        ASSERT_EQ(transaction_borrow_handle(other.get(), &otx), StatusCode::OK);
+        ASSERT_EQ(content_put(otx, st, "a", "X"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(other.get()), StatusCode::OK);
+
+        ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::ERR_ABORTED_RETRYABLE);
+    }
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    auto text = ss.str();
+    EXPECT_NE(text.find(" begin tx:"), std::string::npos);
+    EXPECT_NE(text.find(" commit tx:"), std::string::npos);
+    EXPECT_NE(text.find("status:ERR_ABORTED_RETRYABLE"), std::string::npos);
+    EXPECT_NE(text.find(" error tx:"), std::string::npos);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
+TEST_F(ShirakamiApiTest, flight_recorder_disabled) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    options.attribute("flight_recorder", "false");
+    {
+        DatabaseHandle db;
+        ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+        HandleHolder dbh { db };
+        EXPECT_FALSE(unwrap(db)->flight_recorder().enabled());
+        EXPECT_EQ(database_close(db), StatusCode::OK);
+    }
+    {
+        // the flag belongs to the database, so that it is not inherited by the later databases
+        DatabaseOptions defaults;
+        defaults.attribute(KEY_LOCATION, path());
+        DatabaseHandle db;
+        ASSERT_EQ(database_open(defaults, &db), StatusCode::OK);
+        HandleHolder dbh { db };
+        EXPECT_TRUE(unwrap(db)->flight_recorder().enabled());
+        EXPECT_EQ(database_close(db), StatusCode::OK);
+    }
+}
+
+TEST_F(ShirakamiApiTest, hot_keys) {
+    DatabaseOptions options;
+    options.attribute(KEY_LOCATION, path());
+    DatabaseHandle db;
+    ASSERT_EQ(database_open(options, &db), StatusCode::OK);
+    HandleHolder dbh { db };
+
+    StorageHandle st;
+    ASSERT_EQ(storage_create(db, "s", &st), StatusCode::OK);
+    HandleHolder sth { st };
+    {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        ASSERT_EQ(content_put(tx, st, "a", "1"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::OK);
+    }
+    for (std::size_t i = 0; i < 2; ++i) {
+        HandleHolder<TransactionControlHandle> tch{};
+        ASSERT_EQ(transaction_begin(db, {}, &tch.get()), StatusCode::OK);
+        TransactionHandle tx{};
+        ASSERT_EQ(transaction_borrow_handle(tch.get(), &tx), StatusCode::OK);
+        Slice s{};
+        ASSERT_EQ(content_get(tx, st, "a", &s), StatusCode::OK);
+
+        // conflicting write makes the read of "a" stale
+        HandleHolder<TransactionControlHandle> other{};
+        ASSERT_EQ(transaction_begin(db, {}, &other.get()), StatusCode::OK);
+        TransactionHandle otx{};
+        ASSERT_EQ(transaction_borrow_handle(other.get(), &otx), StatusCode::OK);
+        ASSERT_EQ(content_put(otx, st, "a", "X"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(other.get()), StatusCode::OK);
+
+        ASSERT_EQ(content_put(tx, st, "c", "3"), StatusCode::OK);
+        ASSERT_EQ(transaction_commit(tch.get()), StatusCode::ERR_ABORTED_RETRYABLE);
+    }
+
+    std::vector<HotKey> keys{};
+    ASSERT_EQ(database_get_hot_keys(db, keys), StatusCode::OK);
+    ASSERT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys[0].reason, ErrorCode::CC_OCC_READ_ERROR);
+    EXPECT_EQ(keys[0].key, "a");
+    EXPECT_EQ(keys[0].count, 2);
+
+    std::stringstream ss{};
+    print_diagnostics(ss);
+    EXPECT_NE(ss.str().find("hot keys:"), std::string::npos);
+    EXPECT_EQ(database_close(db), StatusCode::OK);
+}
+
 }  // namespace sharksfin
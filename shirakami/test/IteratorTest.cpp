@@ -375,4 +375,58 @@ TEST_F(ShirakamiIteratorTest, join_using_seek) {
     EXPECT_EQ(results[0], std::make_pair(2, 12));
 }
 
+TEST_F(ShirakamiIteratorTest, key_value_cached) {
+    put("a", "A");
+    put("b", "B");
+    commit_reset();
+
+    TestIterator it {
+            storage(),
+            transaction(),
+            "", EndPointKind::UNBOUND,
+            "", EndPointKind::UNBOUND,
+    };
+
+    ASSERT_EQ(it.next(), StatusCode::OK);
+    auto k0 = it.key();
+    auto v0 = it.value();
+    EXPECT_EQ(k0, "a");
+    EXPECT_EQ(v0, "A");
+    // same position returns the cached buffer
+    EXPECT_EQ(it.key().data(), k0.data());
+    EXPECT_EQ(it.value().data(), v0.data());
+
+    ASSERT_EQ(it.next(), StatusCode::OK);
+    EXPECT_EQ(it.key(), "b");
+    EXPECT_EQ(it.value(), "B");
+
+    ASSERT_EQ(it.next(), StatusCode::NOT_FOUND);
+}
+
+TEST_F(ShirakamiIteratorTest, key_only) {
+    put("a", "A");
+    put("b", "B");
+    commit_reset();
+
+    TestIterator it {
+            std::make_unique<Iterator>(
+                storage(),
+                transaction(),
+                "", EndPointKind::UNBOUND,
+                "", EndPointKind::UNBOUND,
+                0, false, true
+            )
+    };
+
+    ASSERT_EQ(it.next(), StatusCode::OK);
+    EXPECT_EQ(it.key(), "a");
+    Slice v{};
+    EXPECT_EQ(it.value(v), StatusCode::ERR_ILLEGAL_OPERATION);
+
+    ASSERT_EQ(it.next(), StatusCode::OK);
+    EXPECT_EQ(it.key(), "b");
+
+    ASSERT_EQ(it.next(), StatusCode::NOT_FOUND);
+}
+
 }  // namespace sharksfin::shirakami
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "KeySampler.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace sharksfin::shirakami {
+
+class ShirakamiKeySamplerTest : public ::testing::Test {
+public:
+    static std::string key(std::size_t index) {
+        std::string ret(4, '0');
+        for (std::size_t i = ret.size(); i > 0; --i) {
+            ret[i - 1] = static_cast<char>('0' + index % 10);
+            index /= 10;
+        }
+        return ret;
+    }
+};
+
+TEST_F(ShirakamiKeySamplerTest, simple) {
+    KeySampler sampler{100};
+    for (std::size_t i = 0; i < 8; ++i) {
+        sampler.offer(key(i));
+    }
+    EXPECT_EQ(sampler.count(), 8);
+    std::vector<std::string> out{};
+    sampler.split_points(4, out);
+    EXPECT_EQ(out, (std::vector<std::string>{key(2), key(4), key(6)}));
+}
+
+TEST_F(ShirakamiKeySamplerTest, few_keys) {
+    KeySampler sampler{100};
+    sampler.offer(key(0));
+    sampler.offer(key(1));
+    std::vector<std::string> out{};
+    sampler.split_points(4, out);
+    EXPECT_EQ(out, (std::vector<std::string>{key(1)}));
+
+    sampler.split_points(1, out);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST_F(ShirakamiKeySamplerTest, empty) {
+    KeySampler sampler{100};
+    std::vector<std::string> out{};
+    sampler.split_points(4, out);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST_F(ShirakamiKeySamplerTest, compact) {
+    KeySampler sampler{4};
+    for (std::size_t i = 0; i < 1000; ++i) {
+        sampler.offer(key(i));
+    }
+    EXPECT_EQ(sampler.count(), 1000);
+    std::vector<std::string> out{};
+    sampler.split_points(4, out);
+    ASSERT_EQ(out.size(), 3);
+    // samples are evenly spaced, so that the split points are close to the exact ones
+    EXPECT_GE(out[0], key(200));
+    EXPECT_LE(out[0], key(300));
+    EXPECT_GE(out[1], key(450));
+    EXPECT_LE(out[1], key(550));
+    EXPECT_GE(out[2], key(700));
+    EXPECT_LE(out[2], key(800));
+}
+
+TEST_F(ShirakamiKeySamplerTest, interpolate) {
+    std::vector<std::string> out{};
+    KeySampler::interpolate("k0000", "k2000", 4, out);
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_GT(out[0], "k0000");
+    EXPECT_LT(out[0], out[1]);
+    EXPECT_LT(out[1], out[2]);
+    EXPECT_LT(out[2], "k2000");
+    EXPECT_EQ(out[1], "k1000");
+}
+
+TEST_F(ShirakamiKeySamplerTest, interpolate_prefix) {
+    std::vector<std::string> out{};
+    KeySampler::interpolate("a", std::string{"a\xff"}, 2, out);
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_GT(out[0], "a");
+    EXPECT_LT(out[0], std::string{"a\xff"});
+}
+
+TEST_F(ShirakamiKeySamplerTest, interpolate_empty) {
+    std::vector<std::string> out{};
+    KeySampler::interpolate("a", "a", 4, out);
+    EXPECT_TRUE(out.empty());
+    KeySampler::interpolate("b", "a", 4, out);
+    EXPECT_TRUE(out.empty());
+}
+
+}  // namespace sharksfin::shirakami
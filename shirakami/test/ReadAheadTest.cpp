@@ -0,0 +1,93 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ReadAhead.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace sharksfin::shirakami {
+
+class ShirakamiReadAheadTest : public ::testing::Test {
+public:
+    static ReadAhead::fetch_type rows(std::size_t count, StatusCode last = StatusCode::NOT_FOUND) {
+        return [count, last, index = std::size_t{0}](std::string& key, std::string& value) mutable {
+            if (index >= count) {
+                return last;
+            }
+            key = std::to_string(index);
+            value = "v" + std::to_string(index);
+            ++index;
+            return StatusCode::OK;
+        };
+    }
+};
+
+TEST_F(ShirakamiReadAheadTest, simple) {
+    ReadAhead ra{rows(10), 3};
+    Slice s{};
+    EXPECT_EQ(ra.key(s), StatusCode::ERR_INVALID_STATE);
+    for (std::size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(ra.next(), StatusCode::OK);
+        ASSERT_EQ(ra.key(s), StatusCode::OK);
+        EXPECT_EQ(s, std::to_string(i));
+        ASSERT_EQ(ra.value(s), StatusCode::OK);
+        EXPECT_EQ(s, "v" + std::to_string(i));
+    }
+    EXPECT_EQ(ra.next(), StatusCode::NOT_FOUND);
+    EXPECT_EQ(ra.key(s), StatusCode::ERR_INVALID_STATE);
+    EXPECT_EQ(ra.next(), StatusCode::NOT_FOUND);
+}
+
+TEST_F(ShirakamiReadAheadTest, batch_boundary) {
+    ReadAhead ra{rows(6), 3};
+    for (std::size_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(ra.next(), StatusCode::OK);
+    }
+    EXPECT_EQ(ra.next(), StatusCode::NOT_FOUND);
+}
+
+TEST_F(ShirakamiReadAheadTest, empty) {
+    ReadAhead ra{rows(0), 3};
+    EXPECT_EQ(ra.next(), StatusCode::NOT_FOUND);
+}
+
+TEST_F(ShirakamiReadAheadTest, error) {
+    ReadAhead ra{rows(4, StatusCode::ERR_ABORTED), 3};
+    for (std::size_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(ra.next(), StatusCode::OK);
+    }
+    EXPECT_EQ(ra.next(), StatusCode::ERR_ABORTED);
+    EXPECT_EQ(ra.next(), StatusCode::ERR_ABORTED);
+}
+
+TEST_F(ShirakamiReadAheadTest, stop) {
+    ReadAhead ra{rows(1000), 3};
+    ASSERT_EQ(ra.next(), StatusCode::OK);
+    ra.stop();
+    Slice s{};
+    ASSERT_EQ(ra.key(s), StatusCode::OK);
+    EXPECT_EQ(s, "0");
+    ra.stop();
+}
+
+TEST_F(ShirakamiReadAheadTest, destroy) {
+    // destroy before consuming all rows
+    ReadAhead ra{rows(1000), 3};
+    ASSERT_EQ(ra.next(), StatusCode::OK);
+}
+
+}  // namespace sharksfin::shirakami
@@ -41,12 +41,6 @@ public:
         )
     {}
 
-    explicit TestIterator(
-        Iterator& orig
-    ) :
-        orig_(std::make_unique<Iterator>(orig))
-    {}
-
     explicit TestIterator(
         std::unique_ptr<Iterator> orig
     ) :
@@ -264,4 +264,78 @@ TEST_F(ShirakamiTransactionTest, recent_call_result_ltx) {
         }
     }
 }
+
+TEST_F(ShirakamiTransactionTest, arena) {
+    struct S {
+        S(std::size_t& destroyed, std::size_t value) : destroyed_(&destroyed), value_(value) {}
+        ~S() { ++*destroyed_; }
+        std::size_t* destroyed_;
+        std::size_t value_;
+        std::array<std::byte, 100> padding_{};
+    };
+    std::size_t destroyed = 0;
+    TransactionArena arena{};
+    std::vector<S*> objects{};
+    // exceeds the embedded storage
+    for (std::size_t i = 0; i < 100; ++i) {
+        objects.emplace_back(arena.create<S>(destroyed, i));
+    }
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        EXPECT_EQ(objects[i]->value_, i);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(objects[i]) % alignof(S), 0);
+    }
+    for (auto* e : objects) {
+        arena.destroy(e);
+    }
+    EXPECT_EQ(destroyed, objects.size());
+}
+
+TEST_F(ShirakamiTransactionTest, arena_reuse) {
+    struct S {
+        std::array<std::byte, 100> padding_{};
+    };
+    struct T {
+        std::array<std::byte, 200> padding_{};
+    };
+    TransactionArena arena{};
+    auto* s0 = arena.create<S>();
+    auto* t0 = arena.create<T>();
+    auto footprint = arena.footprint();
+    EXPECT_GE(footprint, sizeof(S) + sizeof(T));
+    for (std::size_t i = 0; i < 1000; ++i) {
+        arena.destroy(s0);
+        auto* s1 = arena.create<S>();
+        EXPECT_EQ(s1, s0);
+        s0 = s1;
+    }
+    arena.destroy(t0);
+    auto* s1 = arena.create<S>();
+    EXPECT_NE(static_cast<void*>(s1), static_cast<void*>(t0));
+    EXPECT_GT(arena.footprint(), footprint);
+    arena.destroy(s0);
+    arena.destroy(s1);
+}
+
+TEST_F(ShirakamiTransactionTest, arena_iterators) {
+    DatabaseHolder db{path()};
+    std::unique_ptr<Storage> st{};
+    ASSERT_EQ(db->create_storage("s", st), StatusCode::OK);
+    TransactionHolder tx{db};
+    ASSERT_EQ(st->put(tx, "a", "A"), StatusCode::OK);
+
+    auto scan = [&]() {
+        IteratorHandle iter{};
+        ASSERT_EQ(content_scan(wrap(tx.tx_.get()), wrap(st.get()),
+            "", EndPointKind::UNBOUND, "", EndPointKind::UNBOUND, &iter), StatusCode::OK);
+        ASSERT_EQ(iterator_next(iter), StatusCode::OK);
+        ASSERT_EQ(iterator_dispose(iter), StatusCode::OK);
+    };
+    scan();
+    auto footprint = tx->arena().footprint();
+    for (std::size_t i = 0; i < 1000; ++i) {
+        scan();
+    }
+    EXPECT_EQ(tx->arena().footprint(), footprint);
+    ASSERT_EQ(tx->commit(), StatusCode::OK);
+}
 }  // namespace
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sharksfin/HotKey.h"
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+namespace sharksfin {
+
+class HotKeyTest : public ::testing::Test {};
+
+TEST_F(HotKeyTest, print) {
+    HotKey key{"s", ErrorCode::CC_OCC_READ_ERROR, std::string{"k\0\x7f", 3}, 10};
+    std::stringstream ss{};
+    ss << key << " " << 255;
+    EXPECT_EQ(ss.str(), "storage=s reason=CC_OCC_READ_ERROR key=k\\x00\\x7f count=10 255");
+}
+
+}  // namespace sharksfin
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2018-2023 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hot_key_tracker.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace sharksfin::common {
+
+class HotKeyTrackerTest : public ::testing::Test {};
+
+TEST_F(HotKeyTrackerTest, count) {
+    hot_key_tracker tracker{};
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "b");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys[0].storage, "s");
+    EXPECT_EQ(keys[0].reason, ErrorCode::CC_OCC_READ_ERROR);
+    EXPECT_EQ(keys[0].key, "a");
+    EXPECT_EQ(keys[0].count, 3);
+    EXPECT_EQ(keys[1].key, "b");
+    EXPECT_EQ(keys[1].count, 1);
+}
+
+TEST_F(HotKeyTrackerTest, count_many_keys) {
+    hot_key_tracker tracker{};
+    // the sketch never underestimates, even if the distinct keys exceed its width
+    for (std::size_t i = 0; i < hot_key_tracker::sketch_width * 4; ++i) {
+        tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, std::to_string(i));
+    }
+    for (std::size_t i = 0; i < 10; ++i) {
+        tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "hot");
+    }
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), hot_key_tracker::default_capacity);
+    EXPECT_EQ(keys[0].key, "hot");
+    EXPECT_GE(keys[0].count, 10);
+    for (std::size_t i = 1; i < keys.size(); ++i) {
+        EXPECT_LE(keys[i].count, keys[i - 1].count) << i;
+    }
+}
+
+TEST_F(HotKeyTrackerTest, evict) {
+    hot_key_tracker tracker{};
+    ASSERT_EQ(tracker.configure(DatabaseOptions{}.attribute(KEY_HOT_KEYS, "2")), StatusCode::OK);
+    EXPECT_EQ(tracker.capacity(), 2);
+    for (std::size_t i = 0; i < 4; ++i) {
+        tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+    }
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "b");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "b");
+
+    // not more frequent than the least tracked key
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "c");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "c");
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys[0].key, "a");
+    EXPECT_EQ(keys[1].key, "b");
+
+    // evicts the least tracked key
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "c");
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys[0].key, "a");
+    EXPECT_EQ(keys[0].count, 4);
+    EXPECT_EQ(keys[1].key, "c");
+    EXPECT_EQ(keys[1].count, 3);
+}
+
+TEST_F(HotKeyTrackerTest, max_groups) {
+    hot_key_tracker tracker{};
+    for (std::size_t i = 0; i < hot_key_tracker::max_groups; ++i) {
+        tracker.record("s" + std::to_string(i), ErrorCode::CC_OCC_READ_ERROR, "k");
+    }
+    tracker.record("extra", ErrorCode::CC_OCC_READ_ERROR, "k");
+    tracker.record("s0", ErrorCode::KVS_KEY_ALREADY_EXISTS, "k");
+    tracker.record("s0", ErrorCode::CC_OCC_READ_ERROR, "k");
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), hot_key_tracker::max_groups);
+    for (auto&& k : keys) {
+        EXPECT_NE(k.storage, "extra");
+        EXPECT_EQ(k.reason, ErrorCode::CC_OCC_READ_ERROR);
+        EXPECT_EQ(k.count, k.storage == "s0" ? 2 : 1) << k.storage;
+    }
+}
+
+TEST_F(HotKeyTrackerTest, max_key_length) {
+    hot_key_tracker tracker{};
+    std::string prefix(hot_key_tracker::max_key_length, 'k');
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, prefix + "a");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, prefix + "b");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, prefix);
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys[0].key, prefix);
+    EXPECT_EQ(keys[0].count, 3);
+}
+
+TEST_F(HotKeyTrackerTest, disabled) {
+    hot_key_tracker tracker{};
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+    ASSERT_EQ(tracker.configure(DatabaseOptions{}.attribute(KEY_HOT_KEYS, "0")), StatusCode::OK);
+    EXPECT_FALSE(tracker.enabled());
+    EXPECT_EQ(tracker.capacity(), 0);
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+    StorageKeyErrorLocator locator{"a", "s"};
+    tracker.record(ErrorCode::CC_OCC_READ_ERROR, &locator);
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    EXPECT_TRUE(keys.empty());
+}
+
+TEST_F(HotKeyTrackerTest, configure_invalid) {
+    hot_key_tracker tracker{};
+    EXPECT_EQ(tracker.configure(DatabaseOptions{}.attribute(KEY_HOT_KEYS, "x")), StatusCode::ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(tracker.configure(DatabaseOptions{}.attribute(KEY_HOT_KEYS, "4x")), StatusCode::ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(tracker.capacity(), hot_key_tracker::default_capacity);
+}
+
+TEST_F(HotKeyTrackerTest, record_locator) {
+    hot_key_tracker tracker{};
+    tracker.record(ErrorCode::CC_OCC_READ_ERROR, nullptr);
+    StorageKeyErrorLocator empty{};
+    tracker.record(ErrorCode::CC_OCC_READ_ERROR, &empty);
+    StorageKeyErrorLocator key_only{"k", std::nullopt};
+    tracker.record(ErrorCode::CC_OCC_READ_ERROR, &key_only);
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys[0].storage, "");
+    EXPECT_EQ(keys[0].key, "k");
+}
+
+TEST_F(HotKeyTrackerTest, snapshot_order) {
+    hot_key_tracker tracker{};
+    tracker.record("t", ErrorCode::CC_OCC_READ_ERROR, "a");
+    tracker.record("s", ErrorCode::CC_OCC_READ_ERROR, "a");
+    tracker.record("s", ErrorCode::KVS_KEY_ALREADY_EXISTS, "a");
+    tracker.record("s", ErrorCode::KVS_KEY_ALREADY_EXISTS, "b");
+    tracker.record("s", ErrorCode::KVS_KEY_ALREADY_EXISTS, "b");
+
+    std::vector<HotKey> keys{};
+    tracker.snapshot(keys);
+    ASSERT_EQ(keys.size(), 4);
+    for (std::size_t i = 1; i < keys.size(); ++i) {
+        auto const& a = keys[i - 1];
+        auto const& b = keys[i];
+        ASSERT_LE(a.storage, b.storage) << i;
+        if (a.storage == b.storage) {
+            ASSERT_LE(a.reason, b.reason) << i;
+            if (a.reason == b.reason) {
+                ASSERT_GE(a.count, b.count) << i;
+            }
+        }
+    }
+    EXPECT_EQ(keys[3].storage, "t");
+}
+
+}  // namespace sharksfin::common
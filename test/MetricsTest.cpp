@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018-2023 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sharksfin/Metrics.h"
+#include <gtest/gtest.h>
+
+namespace sharksfin {
+
+class MetricsTest : public ::testing::Test {};
+
+TEST_F(MetricsTest, labels) {
+    EXPECT_EQ(to_string_view(MetricsOperation::BEGIN), "BEGIN");
+    EXPECT_EQ(to_string_view(MetricsOperation::SCAN_OPEN), "SCAN_OPEN");
+    EXPECT_EQ(to_string_view(MetricsOperation::DURABLE_WAIT), "DURABLE_WAIT");
+}
+
+TEST_F(MetricsTest, bucket_bounds) {
+    for (std::size_t i = 0; i < LatencyHistogram::bucket_count; ++i) {
+        auto lower = LatencyHistogram::bucket_lower_bound(i);
+        auto upper = LatencyHistogram::bucket_upper_bound(i);
+        ASSERT_LE(lower, upper) << i;
+        EXPECT_EQ(LatencyHistogram::bucket_index(lower), i);
+        EXPECT_EQ(LatencyHistogram::bucket_index(upper), i);
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_index(0), 0);
+    EXPECT_EQ(LatencyHistogram::bucket_index(~std::uint64_t{}), LatencyHistogram::bucket_count - 1);
+}
+
+TEST_F(MetricsTest, percentile) {
+    LatencyHistogram h{};
+    EXPECT_EQ(h.percentile(99), 0);
+    for (std::uint64_t i = 1; i <= 1000; ++i) {
+        h.add(i * 1000);
+    }
+    EXPECT_EQ(h.count(), 1000);
+    EXPECT_EQ(h.max(), 1000000);
+    EXPECT_EQ(h.mean(), 500500);
+
+    // relative error is at most 1/8
+    auto p50 = h.percentile(50);
+    EXPECT_GE(p50, 500000);
+    EXPECT_LE(p50, 500000 + 500000 / 8);
+    auto p99 = h.percentile(99);
+    EXPECT_GE(p99, 990000);
+    EXPECT_LE(p99, 1000000);
+    EXPECT_EQ(h.percentile(100), 1000000);
+}
+
+TEST_F(MetricsTest, merge) {
+    LatencyHistogram a{};
+    a.add(10);
+    LatencyHistogram b{};
+    b.add(100, 3);
+    a.merge(b);
+    EXPECT_EQ(a.count(), 4);
+    EXPECT_EQ(a.total(), 310);
+    EXPECT_EQ(a.max(), 100);
+    EXPECT_EQ(a.percentile(25), 10);
+}
+
+}  // namespace sharksfin
@@ -101,6 +101,18 @@ TEST_F(SliceTest, starts_with) {
     EXPECT_FALSE(slice("abc").starts_with("c"));
 }
 
+TEST_F(SliceTest, subslice) {
+    Slice s("Hello, world");
+    EXPECT_EQ(s.subslice(0), "Hello, world");
+    EXPECT_EQ(s.subslice(7), "world");
+    EXPECT_EQ(s.subslice(0, 5), "Hello");
+    EXPECT_EQ(s.subslice(7, 100), "world");
+    EXPECT_EQ(s.subslice(7, 0), "");
+    EXPECT_EQ(s.subslice(12), "");
+    EXPECT_EQ(s.subslice(100, 1), "");
+    EXPECT_EQ(slice().subslice(0, 1), "");
+}
+
 TEST_F(SliceTest, compare) {
     EXPECT_EQ(slice("f").compare(slice("f")), 0);
     EXPECT_LT(slice("f").compare(slice("g")), 0);
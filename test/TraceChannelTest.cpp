@@ -0,0 +1,190 @@
+/*
+ * Copyright 2018-2023 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "trace_channel.h"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sharksfin/ErrorLocator.h"
+#include "api_trace.h"
+#include "flight_recorder.h"
+
+namespace sharksfin::common {
+
+class TraceChannelTest : public ::testing::Test {
+public:
+    static trace_event event_of(std::uint64_t seq) {
+        trace_event ret{};
+        ret.timestamp_ = seq;
+        ret.kind_ = static_cast<std::uint32_t>(seq);
+        for (std::size_t i = 0; i < trace_event::max_args; ++i) {
+            ret.add(seq);
+        }
+        return ret;
+    }
+};
+
+TEST_F(TraceChannelTest, capacity) {
+    EXPECT_EQ(trace_channel("t", 1).capacity(), 1);
+    EXPECT_EQ(trace_channel("t", 4).capacity(), 4);
+    EXPECT_EQ(trace_channel("t", 5).capacity(), 8);
+}
+
+TEST_F(TraceChannelTest, collect) {
+    trace_channel channel{"t", 4};
+    channel.write(event_of(1));
+    channel.write(event_of(2));
+
+    std::vector<trace_event> events{};
+    channel.collect(events);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].timestamp_, 1);
+    EXPECT_EQ(events[1].timestamp_, 2);
+    EXPECT_EQ(events[0].arg_count_, trace_event::max_args);
+    EXPECT_EQ(events[0].thread_, events[1].thread_);
+}
+
+TEST_F(TraceChannelTest, wraparound) {
+    trace_channel channel{"t", 3};
+    for (std::uint64_t i = 1; i <= 10; ++i) {
+        channel.write(event_of(i));
+    }
+
+    // the oldest event of the full ring is dropped, because the writer may be overwriting it
+    std::vector<trace_event> events{};
+    channel.collect(events);
+    ASSERT_EQ(events.size(), 3);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].timestamp_, 8 + i);
+        EXPECT_EQ(events[i].args_[3], 8 + i);
+    }
+}
+
+TEST_F(TraceChannelTest, collect_while_writing) {
+    trace_channel channel{"t", 4};
+    std::atomic_bool stop{false};
+    std::thread writer{[&] {
+        for (std::uint64_t i = 1; ! stop.load(); ++i) {
+            channel.write(event_of(i));
+        }
+    }};
+    std::vector<trace_event> events{};
+    std::size_t found = 0;
+    for (std::size_t n = 0; n < 100000; ++n) {
+        channel.collect(events);
+        found += events.size();
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            auto const& e = events[i];
+            // never torn
+            ASSERT_EQ(e.kind_, static_cast<std::uint32_t>(e.timestamp_));
+            for (auto arg : e.args_) {
+                ASSERT_EQ(arg, e.timestamp_);
+            }
+            // never mixes overwritten events
+            if (i > 0) {
+                ASSERT_EQ(e.timestamp_, events[i - 1].timestamp_ + 1);
+            }
+        }
+    }
+    stop.store(true);
+    writer.join();
+    EXPECT_GT(found, 0);
+}
+
+TEST_F(TraceChannelTest, recycle_ring) {
+    trace_channel channel{"t", 4};
+    std::thread{[&] {
+        channel.write(event_of(1));
+        channel.write(event_of(2));
+    }}.join();
+
+    std::vector<trace_event> events{};
+    channel.collect(events);
+    ASSERT_EQ(events.size(), 2);
+
+    // the later thread reuses the ring of the exited thread, and overwrites its events
+    std::thread{[&] {
+        for (std::uint64_t i = 3; i <= 6; ++i) {
+            channel.write(event_of(i));
+        }
+    }}.join();
+    channel.collect(events);
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_EQ(events[0].timestamp_, 4);
+    EXPECT_EQ(events[2].timestamp_, 6);
+
+    // the current thread also takes over the ring
+    channel.write(event_of(7));
+    channel.collect(events);
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_EQ(events[0].timestamp_, 5);
+    EXPECT_EQ(events[2].timestamp_, 7);
+
+    // the ring in use is never shared
+    std::thread{[&] {
+        channel.write(event_of(8));
+    }}.join();
+    channel.collect(events);
+    ASSERT_EQ(events.size(), 4);
+    EXPECT_EQ(events[3].timestamp_, 8);
+}
+
+TEST_F(TraceChannelTest, print_api_trace) {
+    int value = 0;
+    api_trace_writer(api_trace_kind::entry, "test_function") << "value:" << 42 << " ptr:" << &value;
+    api_trace_writer(api_trace_kind::status, "test_function") << StatusCode::ERR_ABORTED;
+
+    std::stringstream ss{};
+    print_api_trace(ss);
+    auto str = ss.str();
+    EXPECT_NE(str.find("api trace ("), std::string::npos) << str;
+    EXPECT_NE(str.find("--> test_function 42 "), std::string::npos) << str;
+    EXPECT_NE(str.find("--- test_function " + std::to_string(static_cast<std::uint64_t>(StatusCode::ERR_ABORTED))),
+        std::string::npos) << str;
+}
+
+TEST_F(TraceChannelTest, flight_recorder_decode) {
+    int tx = 0;
+    flight_recorder recorder{};
+    recorder.record(flight_event_kind::transaction_commit, &tx, StatusCode::ERR_ABORTED, ErrorCode::CC_OCC_READ_ERROR, -1);
+    StorageKeyErrorLocator locator{"abc", "st"};
+    recorder.record_error(&tx, ErrorCode::KVS_KEY_ALREADY_EXISTS, -2, &locator);
+    recorder.enabled(false);
+    recorder.record(flight_event_kind::transaction_abort, &tx, StatusCode::OK, 0);
+
+    std::stringstream dump{};
+    flight_recorder::dump(dump);
+    std::stringstream ss{};
+    ASSERT_TRUE(flight_recorder::decode(dump, ss));
+    auto str = ss.str();
+    EXPECT_NE(str.find(" commit tx:"), std::string::npos) << str;
+    EXPECT_NE(str.find(" status:ERR_ABORTED error:CC_OCC_READ_ERROR last_call_status:-1"), std::string::npos) << str;
+    EXPECT_NE(str.find(" code:KVS_KEY_ALREADY_EXISTS last_call_status:-2 storage:\"st\" key(len=3):\"abc\""),
+        std::string::npos) << str;
+    EXPECT_EQ(str.find(" abort "), std::string::npos) << str;
+}
+
+TEST_F(TraceChannelTest, flight_recorder_decode_malformed) {
+    std::stringstream dump{"not a flight recorder dump"};
+    std::stringstream ss{};
+    EXPECT_FALSE(flight_recorder::decode(dump, ss));
+}
+
+}  // namespace sharksfin::common
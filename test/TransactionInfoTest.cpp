@@ -0,0 +1,54 @@
+/*
+ * Copyright 2018-2026 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sharksfin/TransactionInfo.h"
+#include <gtest/gtest.h>
+
+namespace sharksfin {
+
+class TransactionInfoTest : public ::testing::Test {};
+
+TEST_F(TransactionInfoTest, labels) {
+    EXPECT_EQ(to_string_view(TransactionEvent::BEGIN_REQUESTED), "BEGIN_REQUESTED");
+    EXPECT_EQ(to_string_view(TransactionEvent::DURABLE), "DURABLE");
+    EXPECT_EQ(to_string_view(TransactionPhase::QUEUEING), "QUEUEING");
+    EXPECT_EQ(to_string_view(TransactionPhase::DURABILITY), "DURABILITY");
+}
+
+TEST_F(TransactionInfoTest, timings) {
+    using namespace std::chrono_literals;
+    TransactionTimings::time_point base{1s};
+    TransactionTimings t{};
+    EXPECT_FALSE(t.at(TransactionEvent::BEGIN_REQUESTED));
+    EXPECT_FALSE(t.duration(TransactionPhase::QUEUEING));
+
+    t.at(TransactionEvent::BEGIN_REQUESTED, base);
+    t.at(TransactionEvent::STARTED, base + 10ns);
+    t.at(TransactionEvent::COMMIT_REQUESTED, base + 100ns);
+    t.at(TransactionEvent::COMMIT_DONE, base + 150ns);
+
+    EXPECT_EQ(t.at(TransactionEvent::STARTED), base + 10ns);
+    EXPECT_EQ(t.duration(TransactionPhase::QUEUEING), 10ns);
+    EXPECT_EQ(t.duration(TransactionPhase::EXECUTION), 90ns);
+    EXPECT_EQ(t.duration(TransactionPhase::VALIDATION), 50ns);
+    EXPECT_FALSE(t.duration(TransactionPhase::DURABILITY));
+    EXPECT_EQ(t.between(TransactionEvent::BEGIN_REQUESTED, TransactionEvent::COMMIT_DONE), 150ns);
+
+    TransactionInfo info{"id", t};
+    EXPECT_EQ(info.id(), "id");
+    EXPECT_EQ(info.timings().duration(TransactionPhase::VALIDATION), 50ns);
+}
+
+}  // namespace sharksfin